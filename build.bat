@@ -8,15 +8,21 @@ set lib_dir=..\code\libs
 :: Build opts
 set compiler=-Od -nologo -std:c11 -W4 -WX -wd4244 -wd4042 -wd4267 -wd4456 -wd4127 -wd4116 -wd4090
 set defines=-DCOMPILER_MSVC=1 -D_DEBUG=1
+:: Add -DARENA_TRACKING=1 to get per-callsite memory budget reports
 set debug=-FC -Zi
 
 :: Platform specific opts
 set platform_includes=-I%lib_dir%
-set platform_libs=shell32.lib user32.lib gdi32.lib opengl32.lib
+set platform_libs=shell32.lib user32.lib gdi32.lib opengl32.lib winmm.lib advapi32.lib
 
 :: Game specific opts
 set game_includes=-I%lib_dir%
-set game_libs=opengl32.lib
+set game_libs=
+
+:: Test specific opts
+set test_includes=-I%code_dir% -I%lib_dir%
+:: Benchmarks are timed, so optimized and without debug checks
+set bench_compiler=%compiler:-Od=-O2%
 
 :: Common linker opts
 set link=-opt:ref -incremental:no
@@ -37,4 +43,10 @@ cl %compiler% %defines% %debug% %game_includes% %code_dir%\game.c -LD %game_libs
 echo Compiling platform executable
 cl %compiler% -DOS_WINDOWS=1 %defines% %debug% %platform_includes% %code_dir%\platform_windows.c %platform_libs% -Feplatform /link %link% %platform_link%
 
+echo Compiling tests
+cl %compiler% -DOS_WINDOWS=1 %defines% %debug% %test_includes% %code_dir%\tests\tests.c %platform_libs% -Fetests /link %link%
+
+echo Compiling benchmarks
+cl %bench_compiler% -DOS_WINDOWS=1 -DCOMPILER_MSVC=1 %debug% %test_includes% %code_dir%\tests\bench.c %platform_libs% -Febench /link %link%
+
 popd
\ No newline at end of file
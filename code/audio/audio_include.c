@@ -0,0 +1,2 @@
+#include "stream.c"
+#include "mixer.c"
@@ -0,0 +1,7 @@
+#ifndef AUDIO_INCLUDE_H
+#define AUDIO_INCLUDE_H
+
+#include "stream.h"
+#include "mixer.h"
+
+#endif
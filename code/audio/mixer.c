@@ -0,0 +1,418 @@
+// Game thread
+
+function void
+MixerInit(Mixer *mixer, Arena *arena)
+{
+  MemoryZeroStruct(mixer);
+  mixer->commands = SPSCQueueAllocN(arena, MixerCommand, MIXER_QUEUE_SIZE);
+  mixer->nextVoiceId = 1;
+  mixer->voices = ArenaPushN(arena, MixerVoice, MIXER_MAX_VOICES);
+  mixer->voiceOrder = ArenaPushN(arena, u32, MIXER_MAX_VOICES);
+  mixer->loudness = ArenaPushN(arena, f32, MIXER_MAX_VOICES);
+  mixer->accumulator = ArenaPush(arena, sizeof(f32) * 2 * MIXER_MAX_FRAMES, 32);
+
+  // Do the cpuid dance here rather than on the audio thread
+  CPUHasAVX2();
+}
+
+function b32
+MixerPushCommand(Mixer *mixer, MixerCommand *command)
+{
+  b32 result = 0;
+  if (mixer->isActive) {
+    result = SPSCQueuePush(mixer->commands, command);
+    if (!result) {
+      AtomicAddU64(&mixer->droppedCommands, 1);
+    }
+  }
+
+  return result;
+}
+
+function u64
+MixerPlay(Mixer *mixer, GameSound *sound, f32 volume, b32 isLooping)
+{
+  u64 result = 0;
+  if (sound && sound->samples && sound->frameCount && (sound->channelCount == 1 || sound->channelCount == 2)) {
+    MixerCommand command = {0};
+    command.kind = MixerCommand_Play;
+    command.voiceId = mixer->nextVoiceId;
+    command.volume = volume;
+    command.isLooping = isLooping;
+    command.sound = *sound;
+    if (MixerPushCommand(mixer, &command)) {
+      result = mixer->nextVoiceId++;
+    }
+  }
+
+  return result;
+}
+
+function u64
+MixerPlayStream(Mixer *mixer, AudioStream *stream, f32 volume)
+{
+  u64 result = 0;
+  if (stream) {
+    MixerCommand command = {0};
+    command.kind = MixerCommand_Play;
+    command.voiceId = mixer->nextVoiceId;
+    command.volume = volume;
+    command.stream = stream;
+    if (MixerPushCommand(mixer, &command)) {
+      result = mixer->nextVoiceId++;
+    }
+  }
+
+  return result;
+}
+
+function void
+MixerStop(Mixer *mixer, u64 voiceId)
+{
+  MixerCommand command = {0};
+  command.kind = MixerCommand_Stop;
+  command.voiceId = voiceId;
+  MixerPushCommand(mixer, &command);
+}
+
+function void
+MixerSetVolume(Mixer *mixer, u64 voiceId, f32 volume)
+{
+  MixerCommand command = {0};
+  command.kind = MixerCommand_SetVolume;
+  command.voiceId = voiceId;
+  command.volume = volume;
+  MixerPushCommand(mixer, &command);
+}
+
+function MixerStats
+MixerGetStats(Mixer *mixer)
+{
+  MixerStats result = {0};
+  result.lastRenderNs = AtomicLoadU64(&mixer->lastRenderNs);
+  result.maxRenderNs = AtomicLoadU64(&mixer->maxRenderNs);
+  result.activeVoices = AtomicLoadU64(&mixer->activeVoices);
+  result.virtualVoices = AtomicLoadU64(&mixer->virtualVoices);
+  result.droppedCommands = AtomicLoadU64(&mixer->droppedCommands);
+
+  return result;
+}
+
+// Mixing kernels, dest is interleaved stereo f32, gain already includes the s16 -> f32 scale
+
+function void
+MixerMixScalar(f32 *dest, s16 *src, u32 channelCount, u64 frameCount, f32 gain)
+{
+  if (channelCount == 2) {
+    for (u64 i = 0; i < frameCount * 2; ++i) {
+      dest[i] += (f32)src[i] * gain;
+    }
+  } else {
+    for (u64 i = 0; i < frameCount; ++i) {
+      f32 sample = (f32)src[i] * gain;
+      dest[2*i + 0] += sample;
+      dest[2*i + 1] += sample;
+    }
+  }
+}
+
+#if ARCH_X64
+function void
+MixerMixSSE2(f32 *dest, s16 *src, u32 channelCount, u64 frameCount, f32 gain)
+{
+  __m128 gain4 = _mm_set1_ps(gain);
+  u64 sampleCount = frameCount * channelCount;
+  u64 i = 0;
+  for (; i + 8 <= sampleCount; i += 8) {
+    // Sign extend 8 s16 into two groups of 4 s32
+    __m128i samples = _mm_loadu_si128((__m128i*)(src + i));
+    __m128 lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16)), gain4);
+    __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16)), gain4);
+
+    if (channelCount == 2) {
+      f32 *out = dest + i;
+      _mm_storeu_ps(out + 0, _mm_add_ps(_mm_loadu_ps(out + 0), lo));
+      _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), hi));
+    } else {
+      // Duplicate each sample into both channels
+      f32 *out = dest + 2*i;
+      _mm_storeu_ps(out + 0,  _mm_add_ps(_mm_loadu_ps(out + 0),  _mm_unpacklo_ps(lo, lo)));
+      _mm_storeu_ps(out + 4,  _mm_add_ps(_mm_loadu_ps(out + 4),  _mm_unpackhi_ps(lo, lo)));
+      _mm_storeu_ps(out + 8,  _mm_add_ps(_mm_loadu_ps(out + 8),  _mm_unpacklo_ps(hi, hi)));
+      _mm_storeu_ps(out + 12, _mm_add_ps(_mm_loadu_ps(out + 12), _mm_unpackhi_ps(hi, hi)));
+    }
+  }
+
+  u64 framesDone = i / channelCount;
+  MixerMixScalar(dest + 2*framesDone, src + i, channelCount, frameCount - framesDone, gain);
+}
+
+SIMD_TARGET_AVX2 function void
+MixerMixAVX2(f32 *dest, s16 *src, u32 channelCount, u64 frameCount, f32 gain)
+{
+  __m256 gain8 = _mm256_set1_ps(gain);
+  u64 sampleCount = frameCount * channelCount;
+  u64 i = 0;
+  for (; i + 8 <= sampleCount; i += 8) {
+    __m256 samples = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)(src + i)))), gain8);
+
+    if (channelCount == 2) {
+      f32 *out = dest + i;
+      _mm256_storeu_ps(out, _mm256_add_ps(_mm256_loadu_ps(out), samples));
+    } else {
+      // unpack works per 128 bit lane, so stitch the lanes back in order afterwards
+      __m256 lo = _mm256_unpacklo_ps(samples, samples);
+      __m256 hi = _mm256_unpackhi_ps(samples, samples);
+      f32 *out = dest + 2*i;
+      _mm256_storeu_ps(out + 0, _mm256_add_ps(_mm256_loadu_ps(out + 0), _mm256_permute2f128_ps(lo, hi, 0x20)));
+      _mm256_storeu_ps(out + 8, _mm256_add_ps(_mm256_loadu_ps(out + 8), _mm256_permute2f128_ps(lo, hi, 0x31)));
+    }
+  }
+
+  u64 framesDone = i / channelCount;
+  MixerMixScalar(dest + 2*framesDone, src + i, channelCount, frameCount - framesDone, gain);
+}
+#endif
+
+function void
+MixerMix(f32 *dest, s16 *src, u32 channelCount, u64 frameCount, f32 gain)
+{
+#if ARCH_X64
+  if (CPUHasAVX2()) {
+    MixerMixAVX2(dest, src, channelCount, frameCount, gain);
+  } else {
+    MixerMixSSE2(dest, src, channelCount, frameCount, gain);
+  }
+#else
+  MixerMixScalar(dest, src, channelCount, frameCount, gain);
+#endif
+}
+
+function void
+MixerResolve(f32 *output, f32 *accumulator, u64 sampleCount)
+{
+  u64 i = 0;
+#if ARCH_X64
+  __m128 minSample = _mm_set1_ps(-1.f);
+  __m128 maxSample = _mm_set1_ps(1.f);
+  for (; i + 4 <= sampleCount; i += 4) {
+    __m128 samples = _mm_load_ps(accumulator + i);
+    _mm_storeu_ps(output + i, _mm_min_ps(_mm_max_ps(samples, minSample), maxSample));
+  }
+#endif
+  for (; i < sampleCount; ++i) {
+    output[i] = Clamp(accumulator[i], -1.f, 1.f);
+  }
+}
+
+// Audio thread
+
+function MixerVoice*
+MixerFindVoice(Mixer *mixer, u64 voiceId)
+{
+  MixerVoice *result = 0;
+  for (u32 voiceIdx = 0; voiceIdx < MIXER_MAX_VOICES && !result; ++voiceIdx) {
+    if (mixer->voices[voiceIdx].id == voiceId) {
+      result = &mixer->voices[voiceIdx];
+    }
+  }
+
+  return result;
+}
+
+function void
+MixerFreeVoice(MixerVoice *voice)
+{
+  if (voice->stream) {
+    AudioStreamRelease(voice->stream);
+  }
+  voice->id = 0;
+  voice->stream = 0;
+}
+
+function void
+MixerApplyCommands(Mixer *mixer)
+{
+  for (MixerCommand command; SPSCQueuePop(mixer->commands, &command);) {
+    switch (command.kind) {
+      case MixerCommand_Play: {
+        MixerVoice *voice = MixerFindVoice(mixer, 0);
+        if (voice) {
+          voice->id = command.voiceId;
+          voice->sound = command.sound;
+          voice->stream = command.stream;
+          voice->position = 0;
+          voice->volume = command.volume;
+          voice->isLooping = command.isLooping;
+        } else if (command.stream) {
+          AudioStreamRelease(command.stream);
+        }
+      } break;
+
+      case MixerCommand_Stop: {
+        MixerVoice *voice = MixerFindVoice(mixer, command.voiceId);
+        if (voice && command.voiceId) {
+          MixerFreeVoice(voice);
+        }
+      } break;
+
+      case MixerCommand_SetVolume: {
+        MixerVoice *voice = MixerFindVoice(mixer, command.voiceId);
+        if (voice && command.voiceId) {
+          voice->volume = command.volume;
+        }
+      } break;
+    }
+  }
+}
+
+// Moves the `keep` loudest voices to the front of order (quickselect, O(n) on average)
+function void
+MixerSelectLoudest(u32 *order, f32 *loudness, u32 count, u32 keep)
+{
+  #define MixerSwapVoices(a, b) Stmnt( Swap(f32, loudness[a], loudness[b]); Swap(u32, order[a], order[b]); )
+
+  u32 lo = 0, hi = count;
+  while (hi - lo > 1) {
+    // Three way partition, most voices share the same volume: [lo, lt) louder, [lt, gt) equal, [gt, hi) quieter
+    f32 pivot = loudness[lo + (hi - lo) / 2];
+    u32 lt = lo, i = lo, gt = hi;
+    while (i < gt) {
+      if (loudness[i] > pivot) {
+        MixerSwapVoices(i, lt);
+        ++lt;
+        ++i;
+      } else if (loudness[i] < pivot) {
+        --gt;
+        MixerSwapVoices(i, gt);
+      } else {
+        ++i;
+      }
+    }
+
+    if (keep <= lt) {
+      hi = lt;
+    } else if (keep <= gt) {
+      break;
+    } else {
+      lo = gt;
+    }
+  }
+
+  #undef MixerSwapVoices
+}
+
+// Drains up to frameCount frames from the stream's ring, an underrun just plays silence
+function b32
+MixerAdvanceStreamVoice(MixerVoice *voice, f32 *dest, u64 frameCount)
+{
+  b32 result = 1;
+  AudioStream *stream = voice->stream;
+  u64 state = AtomicLoadU64(&stream->state);
+  if (state == AudioStreamState_Playing) {
+    // Load the end flag first, every frame decoded before it was set is visible then
+    b32 isEndOfStream = (b32)AtomicLoadU64(&stream->isEndOfStream);
+    u64 readFrame = stream->readFrame;
+    u64 available = AtomicLoadU64(&stream->writeFrame) - readFrame;
+    u64 frames = Min(available, frameCount);
+    f32 gain = voice->volume * (1.f / 32768.f);
+    for (u64 done = 0; done < frames && dest;) {
+      u64 ringPos = (readFrame + done) & stream->ringFrameMask;
+      u64 count = Min(frames - done, stream->ringFrameMask + 1 - ringPos);
+      MixerMix(dest + 2*done, stream->ring + ringPos * stream->channelCount, stream->channelCount, count, gain);
+      done += count;
+    }
+    AtomicStoreU64(&stream->readFrame, readFrame + frames);
+
+    if (frames < frameCount) {
+      if (isEndOfStream) {
+        result = 0;
+      } else {
+        AtomicStoreU64(&stream->underruns, stream->underruns + 1);
+      }
+    }
+  } else if (state == AudioStreamState_Failed) {
+    // Ends the voice, which releases the stream
+    result = 0;
+  }
+
+  return result;
+}
+
+function b32
+MixerAdvanceSoundVoice(MixerVoice *voice, f32 *dest, u64 frameCount)
+{
+  b32 result = 1;
+  GameSound *sound = &voice->sound;
+  f32 gain = voice->volume * (1.f / 32768.f);
+  for (u64 framesLeft = frameCount; framesLeft > 0 && result;) {
+    u64 frames = Min(framesLeft, sound->frameCount - voice->position);
+    if (dest) {
+      MixerMix(dest, sound->samples + voice->position * sound->channelCount, sound->channelCount, frames, gain);
+      dest += frames * 2;
+    }
+    voice->position += frames;
+    framesLeft -= frames;
+
+    if (voice->position >= sound->frameCount) {
+      voice->position = 0;
+      result = voice->isLooping;
+    }
+  }
+
+  return result;
+}
+
+// Advances the voice by frameCount, mixing into dest when given. Returns 0 once a one-shot voice ends
+function b32
+MixerAdvanceVoice(MixerVoice *voice, f32 *dest, u64 frameCount)
+{
+  b32 result = (voice->stream ? MixerAdvanceStreamVoice(voice, dest, frameCount)
+                : MixerAdvanceSoundVoice(voice, dest, frameCount));
+  return result;
+}
+
+function void
+MixerRender(Mixer *mixer, f32 *output, u64 frameCount)
+{
+  u64 startNs = OSNowNs();
+  MixerApplyCommands(mixer);
+
+  u32 activeCount = 0;
+  u32 mixCount = 0;
+  for (u64 frameOffset = 0; frameOffset < frameCount; frameOffset += MIXER_MAX_FRAMES) {
+    u64 chunkFrames = Min(frameCount - frameOffset, MIXER_MAX_FRAMES);
+
+    // Voice limiter: only the loudest MIXER_VOICE_BUDGET voices get mixed, the rest keep their place silently
+    activeCount = 0;
+    for (u32 voiceIdx = 0; voiceIdx < MIXER_MAX_VOICES; ++voiceIdx) {
+      MixerVoice *voice = &mixer->voices[voiceIdx];
+      if (voice->id) {
+        mixer->voiceOrder[activeCount] = voiceIdx;
+        mixer->loudness[activeCount] = voice->volume;
+        activeCount++;
+      }
+    }
+    mixCount = activeCount;
+    if (activeCount > MIXER_VOICE_BUDGET) {
+      MixerSelectLoudest(mixer->voiceOrder, mixer->loudness, activeCount, MIXER_VOICE_BUDGET);
+      mixCount = MIXER_VOICE_BUDGET;
+    }
+
+    MemoryZero(mixer->accumulator, sizeof(f32) * 2 * chunkFrames);
+    for (u32 orderIdx = 0; orderIdx < activeCount; ++orderIdx) {
+      MixerVoice *voice = &mixer->voices[mixer->voiceOrder[orderIdx]];
+      f32 *dest = orderIdx < mixCount ? mixer->accumulator : 0;
+      if (!MixerAdvanceVoice(voice, dest, chunkFrames)) {
+        MixerFreeVoice(voice);
+      }
+    }
+    MixerResolve(output + 2*frameOffset, mixer->accumulator, 2 * chunkFrames);
+  }
+
+  u64 elapsedNs = OSNowNs() - startNs;
+  AtomicStoreU64(&mixer->lastRenderNs, elapsedNs);
+  AtomicStoreU64(&mixer->maxRenderNs, Max(mixer->maxRenderNs, elapsedNs));
+  AtomicStoreU64(&mixer->activeVoices, activeCount);
+  AtomicStoreU64(&mixer->virtualVoices, activeCount - mixCount);
+}
@@ -0,0 +1,90 @@
+#ifndef MIXER_H
+#define MIXER_H
+
+/*
+  Software mixer fed by the game thread through a lock-free command queue.
+  MixerRender runs on the audio device's thread and never locks, allocates or makes syscalls.
+  Output is interleaved stereo f32 at GAME_AUDIO_SAMPLE_RATE.
+  Voices either play a GameSound resident in memory or drain an AudioStream.
+*/
+
+#define MIXER_MAX_VOICES   512  // Power of 2
+#define MIXER_VOICE_BUDGET 192  // Voices actually mixed per callback, the quietest of the rest are virtualized
+#define MIXER_MAX_FRAMES   4096 // Largest device buffer we accept
+#define MIXER_QUEUE_SIZE   1024
+
+typedef u32 MixerCommandKind;
+enum
+{
+  MixerCommand_Play,
+  MixerCommand_Stop,
+  MixerCommand_SetVolume,
+};
+
+typedef struct MixerCommand MixerCommand;
+struct MixerCommand
+{
+  MixerCommandKind kind;
+  b32 isLooping;
+  u64 voiceId;
+  f32 volume;
+  GameSound sound;
+  AudioStream *stream; // Instead of sound
+};
+
+typedef struct MixerVoice MixerVoice;
+struct MixerVoice
+{
+  u64 id; // 0 when free
+  GameSound sound;
+  AudioStream *stream; // Owned by the voice, released when it ends
+  u64 position; // In frames
+  f32 volume;
+  b32 isLooping;
+};
+
+typedef struct MixerStats MixerStats;
+struct MixerStats
+{
+  u64 lastRenderNs;
+  u64 maxRenderNs;
+  u64 activeVoices;
+  u64 virtualVoices;
+  u64 droppedCommands;
+};
+
+typedef struct Mixer Mixer;
+struct Mixer
+{
+  b32 isActive; // Set once a device is pulling from us, commands are ignored before that
+
+  // Game thread
+  SPSCQueue *commands;
+  u64 nextVoiceId;
+
+  // Audio thread
+  MixerVoice *voices;
+  u32 *voiceOrder;  // Scratch for the limiter
+  f32 *loudness;    // Scratch for the limiter
+  f32 *accumulator; // MIXER_MAX_FRAMES stereo frames
+
+  // Written by the audio thread, read anywhere
+  volatile u64 lastRenderNs;
+  volatile u64 maxRenderNs;
+  volatile u64 activeVoices;
+  volatile u64 virtualVoices;
+  volatile u64 droppedCommands;
+};
+
+// Game thread
+function void       MixerInit(Mixer *mixer, Arena *arena);
+function u64        MixerPlay(Mixer *mixer, GameSound *sound, f32 volume, b32 isLooping);
+function u64        MixerPlayStream(Mixer *mixer, AudioStream *stream, f32 volume);
+function void       MixerStop(Mixer *mixer, u64 voiceId);
+function void       MixerSetVolume(Mixer *mixer, u64 voiceId, f32 volume);
+function MixerStats MixerGetStats(Mixer *mixer);
+
+// Audio thread
+function void MixerRender(Mixer *mixer, f32 *output, u64 frameCount);
+
+#endif // MIXER_H
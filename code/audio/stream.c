@@ -0,0 +1,338 @@
+// IMA ADPCM tables
+
+read_only s16 g_imaStepTable[89] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+  12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+read_only s8 g_imaIndexTable[16] = {
+  -1, -1, -1, -1, 2, 4, 6, 8,
+  -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+// Decoding helpers
+
+function u16
+AudioReadU16(u8 *ptr)
+{
+  return (u16)(ptr[0] | (ptr[1] << 8));
+}
+
+function u32
+AudioReadU32(u8 *ptr)
+{
+  return (u32)ptr[0] | ((u32)ptr[1] << 8) | ((u32)ptr[2] << 16) | ((u32)ptr[3] << 24);
+}
+
+function s16
+AudioDecodeIMANibble(u8 code, s32 *predictor, s32 *index)
+{
+  s32 step = g_imaStepTable[*index];
+  s32 diff = step >> 3;
+  if (code & 4) diff += step;
+  if (code & 2) diff += step >> 1;
+  if (code & 1) diff += step >> 2;
+
+  *predictor += (code & 8) ? -diff : diff;
+  *predictor = Clamp(*predictor, -32768, 32767);
+  *index += g_imaIndexTable[code];
+  *index = Clamp(*index, 0, 88);
+
+  return (s16)*predictor;
+}
+
+// Decodes a (possibly short, at the end of the file) block into interleaved frames. A short
+// block only yields the frames every channel has a sample for.
+function u64
+AudioDecodeIMABlock(u8 *block, u64 blockSize, u32 channelCount, s16 *out)
+{
+  u64 headerSize = 4 * channelCount;
+  u64 frameCount = 0;
+  if (blockSize >= headerSize) {
+    u8 *end = block + blockSize;
+    u64 groupSize = 4 * channelCount;
+    u64 dataSize = blockSize - headerSize;
+    u64 partialSize = dataSize % groupSize;
+    u64 lastChannelBytes = partialSize > 4 * (channelCount - 1) ? partialSize - 4 * (channelCount - 1) : 0;
+    frameCount = 1 + (dataSize / groupSize) * 8 + lastChannelBytes * 2;
+
+    s32 predictor[2], index[2];
+    for (u32 channel = 0; channel < channelCount; ++channel) {
+      predictor[channel] = (s16)AudioReadU16(block);
+      index[channel] = Clamp(block[2], 0, 88);
+      out[channel] = (s16)predictor[channel];
+      block += 4;
+    }
+
+    // After the header channels alternate every 4 bytes (8 samples)
+    for (u64 frame = 1; frame < frameCount; frame += 8) {
+      for (u32 channel = 0; channel < channelCount; ++channel) {
+        for (u64 byteIdx = 0; byteIdx < 4 && block < end; ++byteIdx) {
+          u8 byte = *block++;
+          for (u64 nibble = 0; nibble < 2; ++nibble) {
+            u8 code = nibble ? (byte >> 4) : (byte & 0xF);
+            s16 sample = AudioDecodeIMANibble(code, &predictor[channel], &index[channel]);
+            u64 sampleFrame = frame + byteIdx * 2 + nibble;
+            if (sampleFrame < frameCount) {
+              out[sampleFrame * channelCount + channel] = sample;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return frameCount;
+}
+
+// I/O thread
+
+function b32
+AudioStreamParseWav(AudioStream *stream)
+{
+  b32 result = 0;
+  u64 fileSize = OSFileSize(stream->file);
+
+  u8 header[12];
+  if (OSFileRead(stream->file, 0, header, sizeof(header)) == sizeof(header) &&
+      MemoryMatch(header, "RIFF", 4) && MemoryMatch(header + 8, "WAVE", 4)) {
+    u16 format = 0, bitsPerSample = 0;
+    u32 sampleRate = 0;
+    b32 hasFormat = 0, hasData = 0;
+    for (u64 offset = sizeof(header); offset + 8 <= fileSize && !hasData;) {
+      u8 chunkHeader[8];
+      if (OSFileRead(stream->file, offset, chunkHeader, sizeof(chunkHeader)) != sizeof(chunkHeader)) {
+        break;
+      }
+      u64 chunkSize = AudioReadU32(chunkHeader + 4);
+
+      if (MemoryMatch(chunkHeader, "fmt ", 4) && chunkSize >= 16) {
+        u8 fmt[16];
+        hasFormat = (OSFileRead(stream->file, offset + 8, fmt, sizeof(fmt)) == sizeof(fmt));
+        format = AudioReadU16(fmt + 0);
+        stream->channelCount = AudioReadU16(fmt + 2);
+        sampleRate = AudioReadU32(fmt + 4);
+        stream->blockAlign = AudioReadU16(fmt + 12);
+        bitsPerSample = AudioReadU16(fmt + 14);
+      } else if (MemoryMatch(chunkHeader, "data", 4)) {
+        stream->dataOffset = offset + 8;
+        stream->dataSize = Min(chunkSize, fileSize - stream->dataOffset);
+        hasData = 1;
+      }
+
+      offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    // No resampling (yet), the file has to match the mixer
+    b32 isValid = (hasFormat && hasData && sampleRate == GAME_AUDIO_SAMPLE_RATE &&
+                   (stream->channelCount == 1 || stream->channelCount == 2));
+    if (isValid && format == 1 && bitsPerSample == 16 && stream->blockAlign == 2 * stream->channelCount) {
+      // A trailing partial frame would never decode
+      stream->codec = AudioStreamCodec_PCM16;
+      stream->framesPerBlock = 1;
+      stream->dataSize -= stream->dataSize % stream->blockAlign;
+      result = 1;
+    } else if (isValid && format == 0x11 && bitsPerSample == 4 &&
+               stream->blockAlign > 4 * stream->channelCount && stream->blockAlign <= AUDIO_STREAM_MAX_BLOCK) {
+      stream->codec = AudioStreamCodec_IMAADPCM;
+      stream->framesPerBlock = (stream->blockAlign - 4 * stream->channelCount) * 2 / stream->channelCount + 1;
+      result = 1;
+    }
+  }
+
+  return result;
+}
+
+function void
+AudioStreamWriteRing(AudioStream *stream, s16 *frames, u64 frameCount)
+{
+  u64 writeFrame = stream->writeFrame;
+  for (u64 done = 0; done < frameCount;) {
+    u64 ringPos = (writeFrame + done) & stream->ringFrameMask;
+    u64 count = Min(frameCount - done, stream->ringFrameMask + 1 - ringPos);
+    MemoryCopy(stream->ring + ringPos * stream->channelCount, frames + done * stream->channelCount,
+               count * stream->channelCount * sizeof(s16));
+    done += count;
+  }
+  AtomicStoreU64(&stream->writeFrame, writeFrame + frameCount);
+}
+
+// Decodes until the ring is full or the file ran out
+function void
+AudioStreamFill(AudioStream *stream)
+{
+  u64 ringFrames = stream->ringFrameMask + 1;
+  u64 chunkCapacity = (AUDIO_STREAM_CHUNK_SIZE / stream->blockAlign) * stream->blockAlign;
+  while (!stream->isEndOfStream) {
+    u64 freeFrames = ringFrames - (stream->writeFrame - AtomicLoadU64(&stream->readFrame));
+
+    if (stream->chunkPos >= stream->chunkSize) {
+      if (stream->readOffset >= stream->dataSize) {
+        if (stream->isLooping && stream->dataSize) {
+          stream->readOffset = 0;
+        } else {
+          AtomicStoreU64(&stream->isEndOfStream, 1);
+          break;
+        }
+      }
+
+      u64 readSize = Min(chunkCapacity, stream->dataSize - stream->readOffset);
+      stream->chunkSize = OSFileRead(stream->file, stream->dataOffset + stream->readOffset, stream->chunk, readSize);
+      stream->chunkPos = 0;
+      stream->readOffset += stream->chunkSize;
+      if (stream->chunkSize < readSize) {
+        // Short read, the file got cut. It ends here from now on, loops included
+        stream->dataSize = stream->readOffset;
+      }
+      if (stream->chunkSize == 0) {
+        AtomicStoreU64(&stream->isEndOfStream, 1);
+        break;
+      }
+    }
+
+    u8 *src = stream->chunk + stream->chunkPos;
+    u64 srcSize = stream->chunkSize - stream->chunkPos;
+    if (stream->codec == AudioStreamCodec_PCM16) {
+      u64 frameCount = Min(freeFrames, srcSize / stream->blockAlign);
+      if (srcSize < stream->blockAlign) {
+        // Partial frame at the end of a cut file, dropped so the next read loops or ends
+        stream->chunkPos = stream->chunkSize;
+      } else if (frameCount == 0) {
+        break;
+      } else {
+        AudioStreamWriteRing(stream, (s16*)src, frameCount);
+        stream->chunkPos += frameCount * stream->blockAlign;
+      }
+    } else {
+      if (freeFrames < stream->framesPerBlock) {
+        break;
+      }
+      u64 blockSize = Min(srcSize, stream->blockAlign);
+      if (blockSize >= 4 * stream->channelCount) {
+        u64 frameCount = AudioDecodeIMABlock(src, blockSize, stream->channelCount, stream->decodeScratch);
+        AudioStreamWriteRing(stream, stream->decodeScratch, frameCount);
+      }
+      stream->chunkPos += blockSize; // A final block too short for its header has no frames
+    }
+  }
+}
+
+function void
+AudioStreamReset(AudioStream *stream)
+{
+  OSFileClose(stream->file);
+  stream->file = (OSFile){0};
+  stream->readOffset = 0;
+  stream->chunkSize = stream->chunkPos = 0;
+  stream->writeFrame = stream->readFrame = 0;
+  stream->isEndOfStream = 0;
+  stream->underruns = 0;
+}
+
+function void
+AudioStreamerThreadProc(void *param)
+{
+  AudioStreamer *streamer = (AudioStreamer*)param;
+  while (AtomicLoadU64(&streamer->running)) {
+    u64 deadlineNs = OSNowNs() + AUDIO_STREAM_POLL_NS;
+
+    for (u32 streamIdx = 0; streamIdx < AUDIO_MAX_STREAMS; ++streamIdx) {
+      AudioStream *stream = &streamer->streams[streamIdx];
+      switch (AtomicLoadU64(&stream->state)) {
+        case AudioStreamState_Opening: {
+          stream->file = OSFileOpen(Str8C((char*)stream->path));
+          b32 isValid = stream->file.handle && AudioStreamParseWav(stream);
+          // Both fail if the owner released it meanwhile, the slot is freed below then. A failed
+          // stream stays claimed until its owner sees that and releases it
+          if (isValid) {
+            // Prefetch before the mixer sees it
+            AudioStreamFill(stream);
+            AtomicCompareExchangeU64(&stream->state, AudioStreamState_Opening, AudioStreamState_Playing);
+          } else {
+            AtomicCompareExchangeU64(&stream->state, AudioStreamState_Opening, AudioStreamState_Failed);
+          }
+        } break;
+
+        case AudioStreamState_Playing: {
+          AudioStreamFill(stream);
+        } break;
+
+        case AudioStreamState_Releasing: {
+          AudioStreamReset(stream);
+          AtomicStoreU64(&stream->state, AudioStreamState_Free);
+        } break;
+      }
+    }
+
+    OSSleepUntilNs(deadlineNs);
+  }
+}
+
+// Game thread
+
+function void
+AudioStreamerStart(AudioStreamer *streamer, Arena *arena)
+{
+  MemoryZeroStruct(streamer);
+
+  u64 latencyFrames = (u64)GAME_AUDIO_SAMPLE_RATE * AUDIO_STREAM_LATENCY_MS / 1000;
+  u64 ringFrames = 1;
+  while (ringFrames < latencyFrames) {
+    ringFrames <<= 1;
+  }
+  u64 ringSize = ringFrames * 2 * sizeof(s16);
+  u64 scratchSize = (AUDIO_STREAM_MAX_BLOCK * 2 + 2) * sizeof(s16);
+  Assert(ringSize + AUDIO_STREAM_CHUNK_SIZE + scratchSize <= AUDIO_STREAM_BUDGET);
+
+  for (u32 streamIdx = 0; streamIdx < AUDIO_MAX_STREAMS; ++streamIdx) {
+    AudioStream *stream = &streamer->streams[streamIdx];
+    stream->ring = ArenaPush(arena, ringSize, CACHE_LINE_SIZE);
+    stream->ringFrameMask = ringFrames - 1;
+    stream->chunk = ArenaPush(arena, AUDIO_STREAM_CHUNK_SIZE, CACHE_LINE_SIZE);
+    stream->decodeScratch = ArenaPush(arena, scratchSize, CACHE_LINE_SIZE);
+  }
+
+  streamer->running = 1;
+  streamer->thread = OSThreadLaunch(AudioStreamerThreadProc, streamer);
+}
+
+function void
+AudioStreamerStop(AudioStreamer *streamer)
+{
+  AtomicStoreU64(&streamer->running, 0);
+  OSThreadJoin(streamer->thread);
+  for (u32 streamIdx = 0; streamIdx < AUDIO_MAX_STREAMS; ++streamIdx) {
+    AudioStreamReset(&streamer->streams[streamIdx]);
+  }
+}
+
+function AudioStream*
+AudioStreamOpen(AudioStreamer *streamer, String8 path, b32 isLooping)
+{
+  AudioStream *result = 0;
+  if (path.size < sizeof(result->path)) {
+    // Only the game thread moves streams out of Free, so no need for a CAS here
+    for (u32 streamIdx = 0; streamIdx < AUDIO_MAX_STREAMS && !result; ++streamIdx) {
+      AudioStream *stream = &streamer->streams[streamIdx];
+      if (AtomicLoadU64(&stream->state) == AudioStreamState_Free) {
+        MemoryCopy(stream->path, path.str, path.size);
+        stream->path[path.size] = 0;
+        stream->isLooping = isLooping;
+        AtomicStoreU64(&stream->state, AudioStreamState_Opening);
+        result = stream;
+      }
+    }
+  }
+
+  return result;
+}
+
+function void
+AudioStreamRelease(AudioStream *stream)
+{
+  AtomicExchangeU64(&stream->state, AudioStreamState_Releasing);
+}
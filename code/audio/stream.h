@@ -0,0 +1,82 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+/*
+  Streams long sounds (music, ambiences) from disk instead of decoding them up front.
+  An I/O thread reads the compressed file in chunks and decodes ahead into a ring of
+  AUDIO_STREAM_LATENCY_MS worth of frames, the mixer pulls from that ring.
+  Supports 16 bit PCM and IMA ADPCM (4:1) WAV files at GAME_AUDIO_SAMPLE_RATE.
+*/
+
+#define AUDIO_MAX_STREAMS        8
+#define AUDIO_STREAM_LATENCY_MS  250
+#define AUDIO_STREAM_CHUNK_SIZE  Kilobytes(16)
+#define AUDIO_STREAM_MAX_BLOCK   Kilobytes(4) // Largest ADPCM block we accept
+#define AUDIO_STREAM_BUDGET      Kilobytes(160) // Resident bytes per stream
+#define AUDIO_STREAM_POLL_NS     (5 * OS_NS_PER_MS)
+
+typedef u64 AudioStreamState;
+enum
+{
+  AudioStreamState_Free,      // Owned by nobody
+  AudioStreamState_Opening,   // Claimed by the game thread, I/O thread opens it
+  AudioStreamState_Playing,   // I/O thread fills, audio thread drains
+  AudioStreamState_Failed,    // Couldn't be opened, waits for its owner to release it
+  AudioStreamState_Releasing, // Released by its owner, I/O thread closes it
+};
+
+typedef u32 AudioStreamCodec;
+enum
+{
+  AudioStreamCodec_PCM16,
+  AudioStreamCodec_IMAADPCM,
+};
+
+typedef struct AudioStream AudioStream;
+struct AudioStream
+{
+  volatile u64 state;
+
+  // Set by the game thread before the stream goes to Opening
+  u8 path[256];
+  b32 isLooping;
+
+  // I/O thread
+  OSFile file;
+  AudioStreamCodec codec;
+  u32 blockAlign;
+  u32 framesPerBlock;
+  u64 dataOffset, dataSize;
+  u64 readOffset;           // Into the data chunk
+  u8 *chunk;                // Compressed bytes read ahead
+  u64 chunkSize, chunkPos;
+  s16 *decodeScratch;       // One decoded ADPCM block
+
+  // Ring of decoded frames, I/O thread writes, audio thread reads
+  u32 channelCount;
+  s16 *ring;
+  u64 ringFrameMask;
+  volatile u64 writeFrame;
+  volatile u64 readFrame;
+  volatile u64 isEndOfStream;
+  volatile u64 underruns;
+};
+
+typedef struct AudioStreamer AudioStreamer;
+struct AudioStreamer
+{
+  AudioStream streams[AUDIO_MAX_STREAMS];
+  volatile u64 running;
+  OSThread thread;
+};
+
+// Game thread
+function void         AudioStreamerStart(AudioStreamer *streamer, Arena *arena);
+function void         AudioStreamerStop(AudioStreamer *streamer);
+function AudioStream* AudioStreamOpen(AudioStreamer *streamer, String8 path, b32 isLooping);
+
+// Any thread that owns the stream. Only the owner releases, exactly once, whatever state the
+// stream is in; the I/O thread never frees a slot on its own
+function void AudioStreamRelease(AudioStream *stream);
+
+#endif // STREAM_H
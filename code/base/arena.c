@@ -12,28 +12,37 @@ ArenaAlloc(void *backingBuffer, u64 backingBufferSize)
 }
 
 function void*  
-ArenaPushNoZero(Arena *arena, u64 size, u64 align)
+ArenaPushNoZeroFrom(Arena *arena, u64 size, u64 align, char *file, u32 line)
 {
   Assert(IsPow2(align));
 
   void *result = 0;
-  if (arena->pos + size <= arena->cap) {
+  u64 alignedPos = AlignUpPow2(arena->pos, align);
+  if (alignedPos + size <= arena->cap) {
     u8 *base = (u8*)arena;
-    u64 alignedPos = AlignUpPow2(arena->pos, align);
     result = base + alignedPos;
+#if ARENA_TRACKING
+    ArenaTrackPush(arena, arena->pos, alignedPos + size - arena->pos, file, line);
+#endif
     arena->pos = alignedPos + size;
   } else {
-    // TODO: Logging
+#if ARENA_TRACKING
+    ArenaTrackOverflow(arena, size, file, line);
+#endif
   }
+  Unused(file);
+  Unused(line);
   
   return result;
 }
 
 function void*  
-ArenaPush(Arena *arena, u64 size, u64 align)
+ArenaPushFrom(Arena *arena, u64 size, u64 align, char *file, u32 line)
 {
-  void *result = ArenaPushNoZero(arena, size, align);
-  MemoryZero(result, size);
+  void *result = ArenaPushNoZeroFrom(arena, size, align, file, line);
+  if (result) {
+    MemoryZero(result, size);
+  }
   
   return result;
 }
@@ -43,6 +52,9 @@ ArenaPopTo(Arena *arena, u64 pos)
 {
   u64 minPos = sizeof(Arena);
   u64 newPos = Max(minPos, pos);
+#if ARENA_TRACKING
+  ArenaTrackPop(arena, newPos);
+#endif
   arena->pos = newPos;
 }
 
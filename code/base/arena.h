@@ -7,6 +7,11 @@
   - Scratch arenas
 */
 
+// Build with -DARENA_TRACKING=1 to attribute every push to its callsite (see arena_track.h)
+#if !defined(ARENA_TRACKING)
+# define ARENA_TRACKING 0
+#endif
+
 #define ARENA_COMMIT_GRANULARITY Kilobytes(4)
 #define ARENA_DECOMMIT_THRESHOLD Megabytes(64)
 
@@ -28,8 +33,15 @@ struct TempArena
 
 function Arena* ArenaAlloc(void *backingBuffer, u64 backingBufferSize);
 function void   ArenaRelease(Arena *arena);
-function void*  ArenaPushNoZero(Arena *arena, u64 size, u64 align);
-function void*  ArenaPush(Arena *arena, u64 size, u64 align);
+function void*  ArenaPushNoZeroFrom(Arena *arena, u64 size, u64 align, char *file, u32 line);
+function void*  ArenaPushFrom(Arena *arena, u64 size, u64 align, char *file, u32 line);
+#if ARENA_TRACKING
+# define ArenaCallsite __FILE__, __LINE__
+#else
+# define ArenaCallsite 0, 0
+#endif
+#define ArenaPushNoZero(arena, size, align) ArenaPushNoZeroFrom((arena), (size), (align), ArenaCallsite)
+#define ArenaPush(arena, size, align) ArenaPushFrom((arena), (size), (align), ArenaCallsite)
 #define ArenaPushN(arena, type, count) ArenaPush((arena), sizeof(type) * (count), _Alignof(type))
 function void   ArenaPopTo(Arena *arena, u64 pos);
 function void   ArenaPop(Arena *arena, u64 amount);
@@ -41,4 +53,11 @@ function u64    PosFromArena(Arena *arena);
 function TempArena ArenaTempBegin(Arena *arena);
 function void      ArenaTempEnd(TempArena temp);
 
+#if ARENA_TRACKING
+// Hooks, implemented in arena_track.c
+function void ArenaTrackPush(Arena *arena, u64 pos, u64 size, char *file, u32 line);
+function void ArenaTrackPop(Arena *arena, u64 pos);
+function void ArenaTrackOverflow(Arena *arena, u64 size, char *file, u32 line);
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,240 @@
+#if ARENA_TRACKING
+
+global ArenaTracker g_arenaTracker;
+global char g_arenaTrackReportBuffer[ARENA_TRACK_REPORT_SIZE]; // Written first so the report doesn't inflate the peaks it reports
+thread_storage char *g_arenaTag;
+
+function ArenaTrackArena*
+ArenaTrackFind(Arena *arena)
+{
+  ArenaTrackArena *result = 0;
+  for (u64 arenaIdx = 0; arenaIdx < g_arenaTracker.arenaCount && !result; ++arenaIdx) {
+    if (g_arenaTracker.arenas[arenaIdx].arena == arena) {
+      result = &g_arenaTracker.arenas[arenaIdx];
+    }
+  }
+
+  // Arenas show up on their first push, naming them is optional
+  if (!result && g_arenaTracker.arenaCount < ARENA_TRACK_MAX_ARENAS) {
+    result = &g_arenaTracker.arenas[g_arenaTracker.arenaCount++];
+    result->arena = arena;
+    result->name = "unnamed";
+  }
+
+  return result;
+}
+
+function ArenaTrackSite*
+ArenaTrackFindSite(char *file, u32 line, u32 arenaIdx, char *tag)
+{
+  u64 hash = HashU64(IntFromPtr(file) ^ ((u64)line << 40) ^ ((u64)arenaIdx << 56) ^ IntFromPtr(tag));
+  u64 mask = ARENA_TRACK_MAX_SITES - 1;
+  ArenaTrackSite *result = 0;
+  for (u64 probe = 0; probe < ARENA_TRACK_MAX_SITES && !result; ++probe) {
+    ArenaTrackSite *site = &g_arenaTracker.sites[(hash + probe) & mask];
+    if (!site->file) {
+      site->file = file;
+      site->line = line;
+      site->arenaIdx = arenaIdx;
+      site->tag = tag;
+      result = site;
+    } else if (site->file == file && site->line == line && site->arenaIdx == arenaIdx && site->tag == tag) {
+      result = site;
+    }
+  }
+
+  return result;
+}
+
+function void
+ArenaTrackName(Arena *arena, char *name)
+{
+  ArenaTrackArena *tracked = ArenaTrackFind(arena);
+  if (tracked) {
+    tracked->name = name;
+  }
+}
+
+function char*
+ArenaTagSet(char *tag)
+{
+  char *result = g_arenaTag;
+  g_arenaTag = tag;
+  return result;
+}
+
+function void
+ArenaTrackSetOverflowFunc(ArenaOverflowFunc *func)
+{
+  g_arenaTracker.overflowFunc = func;
+}
+
+function void
+ArenaTrackPush(Arena *arena, u64 pos, u64 size, char *file, u32 line)
+{
+  ArenaTrackArena *tracked = ArenaTrackFind(arena);
+  if (tracked) {
+    u32 arenaIdx = (u32)(tracked - g_arenaTracker.arenas);
+    ArenaTrackSite *site = ArenaTrackFindSite(file ? file : "?", line, arenaIdx, g_arenaTag);
+    if (site) {
+      site->liveBytes += size;
+      site->peakBytes = Max(site->peakBytes, site->liveBytes);
+      site->pushCount++;
+      if (tracked->logCount < ARENA_TRACK_LOG_SIZE) {
+        ArenaTrackPushEntry *entry = &tracked->log[tracked->logCount++];
+        entry->pos = pos;
+        entry->size = size;
+        entry->siteIdx = (u64)(site - g_arenaTracker.sites);
+      } else {
+        tracked->logDropped++;
+      }
+    }
+
+    tracked->pushCount++;
+    tracked->highWater = Max(tracked->highWater, pos + size);
+    tracked->framePeak = Max(tracked->framePeak, pos + size);
+  }
+}
+
+function void
+ArenaTrackPop(Arena *arena, u64 pos)
+{
+  ArenaTrackArena *tracked = ArenaTrackFind(arena);
+  while (tracked && tracked->logCount && tracked->log[tracked->logCount - 1].pos + tracked->log[tracked->logCount - 1].size > pos) {
+    ArenaTrackPushEntry *entry = &tracked->log[tracked->logCount - 1];
+    ArenaTrackSite *site = &g_arenaTracker.sites[entry->siteIdx];
+    if (entry->pos >= pos) {
+      site->liveBytes -= entry->size;
+      tracked->logCount--;
+    } else {
+      // ArenaPop into the middle of a push
+      site->liveBytes -= entry->pos + entry->size - pos;
+      entry->size = pos - entry->pos;
+    }
+  }
+}
+
+function void
+ArenaTrackFrameEnd(void)
+{
+  for (u64 arenaIdx = 0; arenaIdx < g_arenaTracker.arenaCount; ++arenaIdx) {
+    ArenaTrackArena *tracked = &g_arenaTracker.arenas[arenaIdx];
+    tracked->maxFramePeak = Max(tracked->maxFramePeak, tracked->framePeak);
+    tracked->framePeak = tracked->arena->pos;
+  }
+}
+
+// Report
+
+function u64
+ArenaTrackAppend(char *buffer, u64 size, u64 capacity, char *fmt, ...)
+{
+  if (size < capacity) {
+    va_list args;
+    va_start(args, fmt);
+    int written = stbsp_vsnprintf(buffer + size, (int)(capacity - size), fmt, args);
+    va_end(args);
+    size = Min(size + (u64)Max(written, 0), capacity - 1);
+  }
+
+  return size;
+}
+
+function u64
+ArenaTrackWriteReport(char *buffer, u64 capacity)
+{
+  u64 size = 0;
+  for (u64 arenaIdx = 0; arenaIdx < g_arenaTracker.arenaCount; ++arenaIdx) {
+    ArenaTrackArena *tracked = &g_arenaTracker.arenas[arenaIdx];
+    Arena *arena = tracked->arena;
+    size = ArenaTrackAppend(buffer, size, capacity,
+                            "arena %s: %.1fKB of %.1fMB used (%.2f%%), high water %.1fKB, frame peak %.1fKB, %llu pushes, %llu failed%s\n",
+                            tracked->name, (f64)arena->pos / 1024.0, (f64)arena->cap / (1024.0 * 1024.0),
+                            100.0 * (f64)arena->pos / (f64)arena->cap, (f64)tracked->highWater / 1024.0,
+                            (f64)Max(tracked->maxFramePeak, tracked->framePeak) / 1024.0, tracked->pushCount,
+                            tracked->failedCount, tracked->logDropped ? " (log overflowed, sites approximate)" : "");
+
+    // Biggest live sites of this arena, selected one at a time since we only want a few
+    u64 listed[ARENA_TRACK_REPORT_SITES];
+    for (u64 rank = 0; rank < ARENA_TRACK_REPORT_SITES; ++rank) {
+      u64 best = ARENA_TRACK_MAX_SITES;
+      for (u64 siteIdx = 0; siteIdx < ARENA_TRACK_MAX_SITES; ++siteIdx) {
+        ArenaTrackSite *site = &g_arenaTracker.sites[siteIdx];
+        b32 isListed = 0;
+        for (u64 i = 0; i < rank; ++i) {
+          isListed = isListed || (listed[i] == siteIdx);
+        }
+        if (site->file && site->arenaIdx == arenaIdx && site->liveBytes && !isListed &&
+            (best == ARENA_TRACK_MAX_SITES || site->liveBytes > g_arenaTracker.sites[best].liveBytes)) {
+          best = siteIdx;
+        }
+      }
+      if (best == ARENA_TRACK_MAX_SITES) {
+        break;
+      }
+      listed[rank] = best;
+      ArenaTrackSite *site = &g_arenaTracker.sites[best];
+      size = ArenaTrackAppend(buffer, size, capacity, "  %10.1fKB  %s:%u [%s], %llu pushes\n",
+                              (f64)site->liveBytes / 1024.0, site->file, site->line,
+                              site->tag ? site->tag : "untagged", site->pushCount);
+    }
+  }
+
+  // Totals per tag across all arenas
+  char *tags[32];
+  u64 tagBytes[32];
+  u64 tagCount = 0;
+  for (u64 siteIdx = 0; siteIdx < ARENA_TRACK_MAX_SITES; ++siteIdx) {
+    ArenaTrackSite *site = &g_arenaTracker.sites[siteIdx];
+    if (site->file) {
+      char *tag = site->tag ? site->tag : "untagged";
+      u64 tagIdx = 0;
+      while (tagIdx < tagCount && !(CStringLength(tags[tagIdx]) == CStringLength(tag) && MemoryMatch(tags[tagIdx], tag, CStringLength(tag)))) {
+        ++tagIdx;
+      }
+      if (tagIdx == tagCount && tagCount < ArrayCount(tags)) {
+        tags[tagCount] = tag;
+        tagBytes[tagCount] = 0;
+        tagCount++;
+      }
+      if (tagIdx < tagCount) {
+        tagBytes[tagIdx] += site->liveBytes;
+      }
+    }
+  }
+  size = ArenaTrackAppend(buffer, size, capacity, "tags:");
+  for (u64 tagIdx = 0; tagIdx < tagCount; ++tagIdx) {
+    size = ArenaTrackAppend(buffer, size, capacity, " %s %.1fKB", tags[tagIdx], (f64)tagBytes[tagIdx] / 1024.0);
+  }
+  size = ArenaTrackAppend(buffer, size, capacity, "\n");
+
+  return size;
+}
+
+function String8
+ArenaTrackReport(Arena *output)
+{
+  u64 size = ArenaTrackWriteReport(g_arenaTrackReportBuffer, sizeof(g_arenaTrackReportBuffer));
+  return PushStr8Copy(output, Str8((u8*)g_arenaTrackReportBuffer, size));
+}
+
+function void
+ArenaTrackOverflow(Arena *arena, u64 size, char *file, u32 line)
+{
+  ArenaTrackArena *tracked = ArenaTrackFind(arena);
+  if (tracked) {
+    tracked->failedCount++;
+  }
+
+  if (g_arenaTracker.overflowFunc) {
+    // The arena that overflowed can't hold the report
+    char *buffer = g_arenaTrackReportBuffer;
+    u64 used = ArenaTrackAppend(buffer, 0, ARENA_TRACK_REPORT_SIZE, "arena %s overflowed: %llu bytes at %s:%u [%s], %llu of %llu bytes used\n",
+                                tracked ? tracked->name : "untracked", size, file ? file : "?", line,
+                                g_arenaTag ? g_arenaTag : "untagged", arena->pos, arena->cap);
+    used += ArenaTrackWriteReport(buffer + used, ARENA_TRACK_REPORT_SIZE - used);
+    g_arenaTracker.overflowFunc(Str8((u8*)buffer, used));
+  }
+}
+
+#endif // ARENA_TRACKING
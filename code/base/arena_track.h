@@ -0,0 +1,84 @@
+#ifndef ARENA_TRACK_H
+#define ARENA_TRACK_H
+
+/*
+  Opt-in allocation tracking (-DARENA_TRACKING=1). Every push is attributed to its callsite,
+  the arena and the current tag. Arenas pop in stack order, so each tracked arena keeps a log
+  of its pushes and pops just unwind it, which keeps per-site live bytes exact.
+  Per-arena high water marks and per-frame peaks show how big the arenas actually need to be.
+  Not thread safe, pushes to tracked arenas have to come from one thread.
+*/
+
+#if ARENA_TRACKING
+
+#define ARENA_TRACK_MAX_ARENAS   16
+#define ARENA_TRACK_MAX_SITES    1024 // Power of 2
+#define ARENA_TRACK_LOG_SIZE     Kilobytes(16) // Pushes remembered per arena
+#define ARENA_TRACK_REPORT_SITES 8    // Biggest sites listed per arena
+#define ARENA_TRACK_REPORT_SIZE  Kilobytes(16)
+
+typedef void ArenaOverflowFunc(String8 report);
+
+typedef struct ArenaTrackSite ArenaTrackSite;
+struct ArenaTrackSite
+{
+  char *file; // 0 when the slot is free
+  u32 line;
+  u32 arenaIdx;
+  char *tag;
+  u64 liveBytes;
+  u64 peakBytes;
+  u64 pushCount;
+};
+
+typedef struct ArenaTrackPushEntry ArenaTrackPushEntry;
+struct ArenaTrackPushEntry
+{
+  u64 pos; // Before alignment, so padding is charged to the push
+  u64 size;
+  u64 siteIdx;
+};
+
+typedef struct ArenaTrackArena ArenaTrackArena;
+struct ArenaTrackArena
+{
+  Arena *arena;
+  char *name;
+  u64 highWater;
+  u64 framePeak;
+  u64 maxFramePeak;
+  u64 pushCount;
+  u64 failedCount;
+  u64 logCount;
+  u64 logDropped; // Site totals of this arena only grow once the log overflowed
+  ArenaTrackPushEntry log[ARENA_TRACK_LOG_SIZE];
+};
+
+typedef struct ArenaTracker ArenaTracker;
+struct ArenaTracker
+{
+  ArenaTrackArena arenas[ARENA_TRACK_MAX_ARENAS];
+  u64 arenaCount;
+  ArenaTrackSite sites[ARENA_TRACK_MAX_SITES];
+  ArenaOverflowFunc *overflowFunc;
+};
+
+function void    ArenaTrackName(Arena *arena, char *name);
+function char*   ArenaTagSet(char *tag); // Tags pushes from here on, returns the previous tag
+function void    ArenaTrackSetOverflowFunc(ArenaOverflowFunc *func); // Gets the report when a push fails
+function void    ArenaTrackFrameEnd(void); // Folds this frame's peaks into the maximum
+function String8 ArenaTrackReport(Arena *output);
+
+# define ArenaTagScope(tag) for (char *prevTag_ = ArenaTagSet(tag), *once_ = (char*)1; once_; once_ = 0, ArenaTagSet(prevTag_))
+
+#else
+
+# define ArenaTrackName(arena, name)
+# define ArenaTrackSetOverflowFunc(func)
+# define ArenaTrackFrameEnd()
+# define ArenaTrackReport(output) Str8(0, 0)
+# define ArenaTagScope(tag)
+
+#endif // ARENA_TRACKING
+
+#endif // ARENA_TRACK_H
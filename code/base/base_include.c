@@ -1,2 +1,9 @@
 #include "arena.c"
-#include "strings.c"
\ No newline at end of file
+#include "strings.c"
+#include "log.c"
+#include "arena_track.c"
+#include "queue.c"
+#include "intern.c"
+#include "hash_map.c"
+#include "chunk_array.c"
+#include "pool.c"
\ No newline at end of file
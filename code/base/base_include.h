@@ -2,7 +2,16 @@
 #define BASE_INCLUDE_H
 
 #include "common.h"
+#include "simd.h"
 #include "arena.h"
 #include "strings.h"
+#include "hash.h"
+#include "log.h"
+#include "arena_track.h"
+#include "queue.h"
+#include "intern.h"
+#include "hash_map.h"
+#include "chunk_array.h"
+#include "pool.h"
 
 #endif
\ No newline at end of file
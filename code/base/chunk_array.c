@@ -0,0 +1,86 @@
+function ChunkArray*
+ChunkArrayAlloc(Arena *arena, u64 itemSize, u64 itemAlign, u64 firstChunkCount)
+{
+  ChunkArray *array = ArenaPushN(arena, ChunkArray, 1);
+  array->arena = arena;
+  array->itemSize = AlignUpPow2(Max(itemSize, 1), itemAlign);
+  array->itemAlign = itemAlign;
+  while ((1ull << array->firstChunkShift) < firstChunkCount) {
+    array->firstChunkShift++;
+  }
+
+  return array;
+}
+
+// Chunk k starts at index first * (2^k - 1), so index / first + 1 has its top bit at k
+function inline u64
+ChunkArrayChunkFromIndex(ChunkArray *array, u64 index, u64 *offset)
+{
+  u64 chunkIdx = IndexOfHighestBit64((index >> array->firstChunkShift) + 1);
+  *offset = index - (((1ull << chunkIdx) - 1) << array->firstChunkShift);
+  return chunkIdx;
+}
+
+function void*
+ChunkArrayPush(ChunkArray *array)
+{
+  void *result = 0;
+  u64 offset;
+  u64 chunkIdx = ChunkArrayChunkFromIndex(array, array->count, &offset);
+  if (chunkIdx < CHUNK_ARRAY_MAX_CHUNKS) {
+    if (chunkIdx == array->chunkCount) {
+      u64 chunkItems = 1ull << (array->firstChunkShift + chunkIdx);
+      array->chunks[chunkIdx] = ArenaPushNoZero(array->arena, chunkItems * array->itemSize, array->itemAlign);
+      array->chunkCount += (array->chunks[chunkIdx] != 0);
+    }
+    if (chunkIdx < array->chunkCount) {
+      result = array->chunks[chunkIdx] + offset * array->itemSize;
+      MemoryZero(result, array->itemSize);
+      array->count++;
+    }
+  }
+
+  return result;
+}
+
+function void*
+ChunkArrayGet(ChunkArray *array, u64 index)
+{
+  void *result = 0;
+  if (index < array->count) {
+    u64 offset;
+    u64 chunkIdx = ChunkArrayChunkFromIndex(array, index, &offset);
+    result = array->chunks[chunkIdx] + offset * array->itemSize;
+  }
+
+  return result;
+}
+
+function void
+ChunkArrayPop(ChunkArray *array)
+{
+  array->count -= (array->count > 0);
+}
+
+function void
+ChunkArrayClear(ChunkArray *array)
+{
+  array->count = 0;
+}
+
+function u8*
+ChunkArrayChunk(ChunkArray *array, u64 chunkIdx, u64 *itemCount)
+{
+  u8 *result = 0;
+  *itemCount = 0;
+  if (chunkIdx < array->chunkCount) {
+    u64 chunkFirst = ((1ull << chunkIdx) - 1) << array->firstChunkShift;
+    u64 chunkItems = 1ull << (array->firstChunkShift + chunkIdx);
+    if (array->count > chunkFirst) {
+      result = array->chunks[chunkIdx];
+      *itemCount = Min(chunkItems, array->count - chunkFirst);
+    }
+  }
+
+  return result;
+}
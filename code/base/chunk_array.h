@@ -0,0 +1,35 @@
+#ifndef CHUNK_ARRAY_H
+#define CHUNK_ARRAY_H
+
+/*
+  Growable array that never moves its items: chunk k holds firstChunkCount << k items,
+  so growing just pushes another chunk on the arena and pointers into the array stay valid.
+  Indexing is O(1) (one bit scan), iterating chunk by chunk stays contiguous.
+*/
+
+#define CHUNK_ARRAY_MAX_CHUNKS 40
+
+typedef struct ChunkArray ChunkArray;
+struct ChunkArray
+{
+  Arena *arena;
+  u8 *chunks[CHUNK_ARRAY_MAX_CHUNKS];
+  u64 chunkCount;
+  u64 itemSize;
+  u64 itemAlign;
+  u64 firstChunkShift; // log2 of the first chunk's item count
+  u64 count;
+};
+
+function ChunkArray* ChunkArrayAlloc(Arena *arena, u64 itemSize, u64 itemAlign, u64 firstChunkCount);
+function void*       ChunkArrayPush(ChunkArray *array); // Zeroed
+function void*       ChunkArrayGet(ChunkArray *array, u64 index);
+function void        ChunkArrayPop(ChunkArray *array);
+function void        ChunkArrayClear(ChunkArray *array); // Keeps the chunks around for reuse
+function u8*         ChunkArrayChunk(ChunkArray *array, u64 chunkIdx, u64 *itemCount); // For iteration, itemCount is how many are in use
+
+#define ChunkArrayAllocT(arena, type, firstChunkCount) ChunkArrayAlloc((arena), sizeof(type), _Alignof(type), (firstChunkCount))
+#define ChunkArrayPushT(array, type) ((type*)ChunkArrayPush((array)))
+#define ChunkArrayGetT(array, type, index) ((type*)ChunkArrayGet((array), (index)))
+
+#endif // CHUNK_ARRAY_H
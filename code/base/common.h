@@ -1,6 +1,34 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+// Context cracking
+
+#if !defined(COMPILER_MSVC) && !defined(COMPILER_CLANG) && !defined(COMPILER_GCC)
+# if defined(_MSC_VER)
+#  define COMPILER_MSVC 1
+# elif defined(__clang__)
+#  define COMPILER_CLANG 1
+# elif defined(__GNUC__)
+#  define COMPILER_GCC 1
+# endif
+#endif
+
+#if !defined(OS_WINDOWS) && !defined(OS_LINUX) && !defined(OS_MAC)
+# if defined(_WIN32)
+#  define OS_WINDOWS 1
+# elif defined(__linux__)
+#  define OS_LINUX 1
+# elif defined(__APPLE__)
+#  define OS_MAC 1
+# endif
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+# define ARCH_X64 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+# define ARCH_ARM64 1
+#endif
+
 #if NO_CRT && _DEBUG
 int _fltused;
 
@@ -28,6 +56,7 @@ memcpy(void *dest, const void *src, size_t len)
 #endif
 
 // Basic types
+#include <stdarg.h>
 #include <stdint.h>
 #include <stdbool.h>
 typedef int8_t s8, b8;
@@ -64,12 +93,16 @@ typedef double f64;
 #if COMPILER_MSVC
 # pragma section(".roglob", read)
 # define read_only static __declspec(allocate(".roglob"))
+#elif COMPILER_CLANG || COMPILER_GCC
+# define read_only static const
 #else
 # error "Read only data not implemented for this compiler!"
 #endif
 
 #if COMPILER_MSVC
 # define thread_storage static __declspec(thread)
+#elif COMPILER_CLANG || COMPILER_GCC
+# define thread_storage static __thread
 #else
 # error "Thread local storage not implemented for this compiler!"
 #endif
@@ -79,7 +112,38 @@ typedef double f64;
 # define StaticAssert(c, label) u8 static_assert_##label[(c)?(1):(-1)]
 #else
 # define Assert(c)
-# define StaticAssert(c)
+# define StaticAssert(c, label)
+#endif
+
+// Atomics (acquire loads, release stores, everything else is a full barrier)
+
+#if COMPILER_MSVC
+# include <intrin.h>
+function inline u64 AtomicLoadU64(volatile u64 *ptr) { u64 result = *ptr; _ReadWriteBarrier(); return result; }
+function inline void AtomicStoreU64(volatile u64 *ptr, u64 value) { _ReadWriteBarrier(); *ptr = value; }
+# define AtomicAddU64(ptr, value) ((u64)_InterlockedExchangeAdd64((volatile __int64*)(ptr), (__int64)(value)) + (value))
+# define AtomicExchangeU64(ptr, value) (u64)_InterlockedExchange64((volatile __int64*)(ptr), (__int64)(value))
+# define AtomicCompareExchangeU64(ptr, expected, desired) ((u64)_InterlockedCompareExchange64((volatile __int64*)(ptr), (__int64)(desired), (__int64)(expected)) == (expected))
+#elif COMPILER_CLANG || COMPILER_GCC
+# define AtomicLoadU64(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+# define AtomicStoreU64(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+# define AtomicAddU64(ptr, value) __atomic_add_fetch((ptr), (value), __ATOMIC_SEQ_CST)
+# define AtomicExchangeU64(ptr, value) __atomic_exchange_n((ptr), (value), __ATOMIC_SEQ_CST)
+# define AtomicCompareExchangeU64(ptr, expected, desired) __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#else
+# error "Atomics not implemented for this compiler!"
+#endif
+
+#define CACHE_LINE_SIZE 64
+
+// Bit scanning, x must not be 0
+
+#if COMPILER_MSVC
+function inline u64 CountTrailingZeros64(u64 x) { unsigned long result; _BitScanForward64(&result, x); return result; }
+function inline u64 IndexOfHighestBit64(u64 x) { unsigned long result; _BitScanReverse64(&result, x); return result; }
+#elif COMPILER_CLANG || COMPILER_GCC
+# define CountTrailingZeros64(x) ((u64)__builtin_ctzll(x))
+# define IndexOfHighestBit64(x) ((u64)(63 - __builtin_clzll(x)))
 #endif
 
 // Memory management helpers
@@ -157,6 +221,7 @@ typedef double f64;
 #define ClampTop(x, a) Min(x,a)
 #define ClampBot(a, x) Max(a,x)
 #define Clamp(x, low, high) (((x) > (high)) ? (high) : (((x) < (low)) ? (low) : (x)))
+#define Abs(a) (((a)<0) ? -(a) : (a))
 
 #define ArrayCount(a) (sizeof((a)) / sizeof((a)[0]))
 #define IntFromPtr(p) (u64)(((u8 *)p) - 0)
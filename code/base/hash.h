@@ -0,0 +1,95 @@
+#ifndef HASH_H
+#define HASH_H
+
+/*
+  Fast non-cryptographic hashing, after wyhash (Wang Yi, public domain).
+  Not stable across versions of this file, don't write hashes to disk.
+*/
+
+#define HASH_DEFAULT_SEED 0x9e3779b97f4a7c15ull
+
+// 64x64 -> 128 bit multiply, lo in *a and hi in *b
+function inline void
+HashMum(u64 *a, u64 *b)
+{
+#if COMPILER_MSVC && ARCH_X64
+  *a = _umul128(*a, *b, b);
+#elif COMPILER_MSVC
+  u64 lo = *a * *b;
+  *b = __umulh(*a, *b);
+  *a = lo;
+#else
+  unsigned __int128 r = (unsigned __int128)*a * *b;
+  *a = (u64)r;
+  *b = (u64)(r >> 64);
+#endif
+}
+
+function inline u64
+HashMix(u64 a, u64 b)
+{
+  HashMum(&a, &b);
+  return a ^ b;
+}
+
+function inline u64 HashRead64(u8 *p) { u64 result; MemoryCopy(&result, p, 8); return result; }
+function inline u64 HashRead32(u8 *p) { u32 result; MemoryCopy(&result, p, 4); return result; }
+
+function inline u64
+HashBytes(void *data, u64 size, u64 seed)
+{
+  read_only u64 secret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+  u8 *p = (u8*)data;
+  u64 a = 0, b = 0;
+  seed ^= HashMix(seed ^ secret[0], secret[1]);
+  if (size <= 16) {
+    if (size >= 4) {
+      u64 quarter = (size >> 3) << 2;
+      a = (HashRead32(p) << 32) | HashRead32(p + quarter);
+      b = (HashRead32(p + size - 4) << 32) | HashRead32(p + size - 4 - quarter);
+    } else if (size > 0) {
+      a = ((u64)p[0] << 16) | ((u64)p[size >> 1] << 8) | p[size - 1];
+    }
+  } else {
+    u64 left = size;
+    if (left > 48) {
+      // Three independent lanes so the multiplies overlap
+      u64 seed1 = seed, seed2 = seed;
+      do {
+        seed = HashMix(HashRead64(p) ^ secret[1], HashRead64(p + 8) ^ seed);
+        seed1 = HashMix(HashRead64(p + 16) ^ secret[2], HashRead64(p + 24) ^ seed1);
+        seed2 = HashMix(HashRead64(p + 32) ^ secret[3], HashRead64(p + 40) ^ seed2);
+        p += 48;
+        left -= 48;
+      } while (left > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (left > 16) {
+      seed = HashMix(HashRead64(p) ^ secret[1], HashRead64(p + 8) ^ seed);
+      p += 16;
+      left -= 16;
+    }
+    a = HashRead64(p + left - 16);
+    b = HashRead64(p + left - 8);
+  }
+
+  a ^= secret[1];
+  b ^= seed;
+  HashMum(&a, &b);
+  return HashMix(a ^ secret[0] ^ size, b ^ secret[1]);
+}
+
+function inline u64
+HashU64(u64 value)
+{
+  return HashMix(value ^ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull);
+}
+
+function inline u64
+HashStr8(String8 string)
+{
+  return HashBytes(string.str, string.size, HASH_DEFAULT_SEED);
+}
+
+#endif // HASH_H
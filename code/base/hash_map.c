@@ -0,0 +1,235 @@
+// Group matching, one bit per slot
+
+#if ARCH_ARM64
+function inline u32
+HashMapMoveMaskNEON(uint8x16_t eq)
+{
+  // Lanes are all ones or all zeros, keep one distinct bit per lane and add them up per half
+  read_only u8 bitWeights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t bits = vandq_u8(eq, vld1q_u8(bitWeights));
+  return (u32)vaddv_u8(vget_low_u8(bits)) | ((u32)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+#endif
+
+function inline u32
+HashMapGroupMatch(u8 *group, u8 ctrl)
+{
+#if ARCH_X64
+  __m128i ctrlBytes = _mm_loadu_si128((__m128i*)group);
+  return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrlBytes, _mm_set1_epi8((char)ctrl)));
+#elif ARCH_ARM64
+  return HashMapMoveMaskNEON(vceqq_u8(vld1q_u8(group), vdupq_n_u8(ctrl)));
+#else
+  u32 result = 0;
+  for (u32 i = 0; i < HASH_MAP_GROUP_SIZE; ++i) {
+    result |= (u32)(group[i] == ctrl) << i;
+  }
+  return result;
+#endif
+}
+
+// Empty and deleted are the only control bytes with the top bit set
+function inline u32
+HashMapGroupMatchFree(u8 *group)
+{
+#if ARCH_X64
+  return (u32)_mm_movemask_epi8(_mm_loadu_si128((__m128i*)group));
+#elif ARCH_ARM64
+  return HashMapMoveMaskNEON(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(group))));
+#else
+  u32 result = 0;
+  for (u32 i = 0; i < HASH_MAP_GROUP_SIZE; ++i) {
+    result |= (u32)(group[i] >> 7) << i;
+  }
+  return result;
+#endif
+}
+
+// Map functions
+
+// Leaves the map as it was when the arena is out of memory
+function b32
+HashMapAllocSlots(HashMap *map, u64 groupCount)
+{
+  u64 slotCount = groupCount * HASH_MAP_GROUP_SIZE;
+  u8 *ctrl = ArenaPushNoZero(map->arena, slotCount, HASH_MAP_GROUP_SIZE);
+  u64 *keys = ArenaPushN(map->arena, u64, slotCount);
+  u8 *values = ArenaPush(map->arena, map->valueStride * slotCount, map->valueAlign);
+  b32 result = ctrl && keys && values;
+  if (result) {
+    MemorySet(ctrl, HASH_MAP_CTRL_EMPTY, slotCount);
+    map->ctrl = ctrl;
+    map->keys = keys;
+    map->values = values;
+    map->groupMask = groupCount - 1;
+    map->count = 0;
+    map->tombstones = 0;
+  }
+
+  return result;
+}
+
+function HashMap*
+HashMapAlloc(Arena *arena, u64 valueSize, u64 valueAlign, u64 capacity)
+{
+  HashMap *map = ArenaPushN(arena, HashMap, 1);
+  if (map) {
+    map->arena = arena;
+    map->valueAlign = valueAlign;
+    map->valueStride = AlignUpPow2(Max(valueSize, 1), valueAlign);
+
+    // Max load factor is 7/8
+    u64 groupCount = 1;
+    while (groupCount * HASH_MAP_GROUP_SIZE * 7 < capacity * 8) {
+      groupCount <<= 1;
+    }
+    if (!HashMapAllocSlots(map, groupCount)) {
+      map = 0;
+    }
+  }
+
+  return map;
+}
+
+// Returns the slot index of the key, or the slot count if it's missing
+function u64
+HashMapFind(HashMap *map, u64 key, u64 hash)
+{
+  u64 slotCount = (map->groupMask + 1) * HASH_MAP_GROUP_SIZE;
+  u64 result = slotCount;
+  u8 h2 = (u8)(hash & 0x7F);
+
+  // Triangular probing over groups visits every group once
+  u64 groupIdx = (hash >> 7) & map->groupMask;
+  b32 isDone = 0;
+  for (u64 step = 1; step <= map->groupMask + 1 && !isDone; ++step) {
+    u8 *group = map->ctrl + groupIdx * HASH_MAP_GROUP_SIZE;
+    for (u32 match = HashMapGroupMatch(group, h2); match && !isDone; match &= match - 1) {
+      u64 slotIdx = groupIdx * HASH_MAP_GROUP_SIZE + CountTrailingZeros64(match);
+      if (map->keys[slotIdx] == key) {
+        result = slotIdx;
+        isDone = 1;
+      }
+    }
+
+    // The key would have gone into the first group with room
+    isDone = isDone || HashMapGroupMatch(group, HASH_MAP_CTRL_EMPTY);
+    groupIdx = (groupIdx + step) & map->groupMask;
+  }
+
+  return result;
+}
+
+function void*
+HashMapLookup(HashMap *map, u64 key)
+{
+  void *result = 0;
+  u64 slotIdx = HashMapFind(map, key, HashU64(key));
+  if (slotIdx < (map->groupMask + 1) * HASH_MAP_GROUP_SIZE) {
+    result = map->values + slotIdx * map->valueStride;
+  }
+
+  return result;
+}
+
+function b32
+HashMapRehash(HashMap *map, u64 groupCount)
+{
+  HashMap old = *map;
+  u64 oldSlotCount = (old.groupMask + 1) * HASH_MAP_GROUP_SIZE;
+  b32 result = HashMapAllocSlots(map, groupCount);
+  for (u64 slotIdx = 0; slotIdx < oldSlotCount && result; ++slotIdx) {
+    if (!(old.ctrl[slotIdx] & 0x80)) {
+      void *value = HashMapInsert(map, old.keys[slotIdx]);
+      MemoryCopy(value, old.values + slotIdx * old.valueStride, old.valueStride);
+    }
+  }
+
+  return result;
+}
+
+function void*
+HashMapInsert(HashMap *map, u64 key)
+{
+  u64 hash = HashU64(key);
+  u64 slotCount = (map->groupMask + 1) * HASH_MAP_GROUP_SIZE;
+  u64 slotIdx = HashMapFind(map, key, hash);
+  void *result = 0;
+  if (slotIdx < slotCount) {
+    result = map->values + slotIdx * map->valueStride;
+  } else {
+    b32 hasRoom = 1;
+    if ((map->count + map->tombstones + 1) * 8 > slotCount * 7) {
+      // Mostly tombstones: clean up in place, otherwise grow. Out of memory the map stays as
+      // it is and still takes the key while it has a free slot
+      u64 groupCount = (map->count * 2 >= slotCount) ? (map->groupMask + 1) * 2 : (map->groupMask + 1);
+      hasRoom = HashMapRehash(map, groupCount) || map->count + map->tombstones < slotCount;
+    }
+
+    if (hasRoom) {
+      u64 groupIdx = (hash >> 7) & map->groupMask;
+      for (u64 step = 1;; ++step) {
+        u32 freeMask = HashMapGroupMatchFree(map->ctrl + groupIdx * HASH_MAP_GROUP_SIZE);
+        if (freeMask) {
+          slotIdx = groupIdx * HASH_MAP_GROUP_SIZE + CountTrailingZeros64(freeMask);
+          break;
+        }
+        groupIdx = (groupIdx + step) & map->groupMask;
+      }
+
+      if (map->ctrl[slotIdx] == HASH_MAP_CTRL_DELETED) {
+        map->tombstones--;
+      }
+      map->ctrl[slotIdx] = (u8)(hash & 0x7F);
+      map->keys[slotIdx] = key;
+      result = map->values + slotIdx * map->valueStride;
+      MemoryZero(result, map->valueStride);
+      map->count++;
+    }
+  }
+
+  return result;
+}
+
+function b32
+HashMapRemove(HashMap *map, u64 key)
+{
+  u64 slotIdx = HashMapFind(map, key, HashU64(key));
+  b32 result = (slotIdx < (map->groupMask + 1) * HASH_MAP_GROUP_SIZE);
+  if (result) {
+    // Probes only move on from groups without an empty slot, so only those need a tombstone
+    u8 *group = map->ctrl + (slotIdx & ~(u64)(HASH_MAP_GROUP_SIZE - 1));
+    if (HashMapGroupMatch(group, HASH_MAP_CTRL_EMPTY)) {
+      map->ctrl[slotIdx] = HASH_MAP_CTRL_EMPTY;
+    } else {
+      map->ctrl[slotIdx] = HASH_MAP_CTRL_DELETED;
+      map->tombstones++;
+    }
+    map->count--;
+  }
+
+  return result;
+}
+
+function void*
+HashMapNext(HashMap *map, u64 *iter, u64 *key)
+{
+  void *result = 0;
+  u64 slotCount = (map->groupMask + 1) * HASH_MAP_GROUP_SIZE;
+  for (; *iter < slotCount && !result; ++*iter) {
+    if (!(map->ctrl[*iter] & 0x80)) {
+      *key = map->keys[*iter];
+      result = map->values + *iter * map->valueStride;
+    }
+  }
+
+  return result;
+}
+
+function void
+HashMapClear(HashMap *map)
+{
+  MemorySet(map->ctrl, HASH_MAP_CTRL_EMPTY, (map->groupMask + 1) * HASH_MAP_GROUP_SIZE);
+  map->count = 0;
+  map->tombstones = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+/*
+  Open addressing hash map from u64 keys to fixed size values, after Swiss tables.
+  Every slot has a control byte (empty, deleted, or 7 bits of the key's hash) and
+  probing looks at 16 control bytes at once. String keys go through the intern table
+  first and use their Atom as the key.
+  Growing rehashes into a new table and leaves the old one in the arena, so give
+  HashMapAlloc a realistic capacity.
+*/
+
+#define HASH_MAP_GROUP_SIZE 16
+#define HASH_MAP_CTRL_EMPTY   0x80
+#define HASH_MAP_CTRL_DELETED 0xFE
+
+typedef struct HashMap HashMap;
+struct HashMap
+{
+  Arena *arena;
+  u8 *ctrl;   // slotCount bytes
+  u64 *keys;
+  u8 *values;
+  u64 valueStride;
+  u64 valueAlign;
+  u64 groupMask; // Group count - 1
+  u64 count;
+  u64 tombstones;
+};
+
+function HashMap* HashMapAlloc(Arena *arena, u64 valueSize, u64 valueAlign, u64 capacity); // 0 when the arena is out of memory
+function void*    HashMapLookup(HashMap *map, u64 key);    // 0 if missing
+function void*    HashMapInsert(HashMap *map, u64 key);    // The key's value, zeroed if the key is new. 0 if the map is full and can't grow
+function b32      HashMapRemove(HashMap *map, u64 key);
+function void*    HashMapNext(HashMap *map, u64 *iter, u64 *key); // Start with *iter = 0, returns 0 at the end
+function void     HashMapClear(HashMap *map);
+
+#define HashMapAllocT(arena, type, capacity) HashMapAlloc((arena), sizeof(type), _Alignof(type), (capacity))
+#define HashMapLookupT(map, type, key) ((type*)HashMapLookup((map), (key)))
+#define HashMapInsertT(map, type, key) ((type*)HashMapInsert((map), (key)))
+
+#endif // HASH_MAP_H
@@ -0,0 +1,79 @@
+function InternTable*
+InternTableAlloc(Arena *arena, u64 capacity)
+{
+  // Keep the load factor at or under 50%
+  u64 slotCount = 1;
+  while (slotCount < 2 * capacity) {
+    slotCount <<= 1;
+  }
+
+  InternTable *table = ArenaPushN(arena, InternTable, 1);
+  Atom *slots = ArenaPushN(arena, Atom, slotCount);
+  String8 *strings = ArenaPushN(arena, String8, capacity + 1);
+  if (table && slots && strings) {
+    table->arena = arena;
+    table->slots = slots;
+    table->slotMask = slotCount - 1;
+    table->capacity = capacity + 1;
+    table->strings = strings;
+    table->count = 1;
+  } else {
+    table = 0;
+  }
+
+  return table;
+}
+
+// Returns the slot holding the string, or the empty slot it would go into
+function Atom*
+InternTableFindSlot(InternTable *table, String8 string, u64 hash)
+{
+  u64 hashHi = hash >> 32;
+  u64 slotIdx = hash & table->slotMask;
+  Atom *slot = &table->slots[slotIdx];
+  while (*slot) {
+    if (AtomHash(*slot) == hashHi) {
+      String8 candidate = table->strings[AtomIndex(*slot)];
+      if (candidate.size == string.size && MemoryMatch(candidate.str, string.str, string.size)) {
+        break;
+      }
+    }
+    slotIdx = (slotIdx + 1) & table->slotMask;
+    slot = &table->slots[slotIdx];
+  }
+
+  return slot;
+}
+
+function Atom
+AtomFromStr8(InternTable *table, String8 string)
+{
+  u64 hash = HashStr8(string);
+  Atom *slot = InternTableFindSlot(table, string, hash);
+  u8 *copy = 0;
+  if (!*slot && table->count < table->capacity && (copy = ArenaPushN(table->arena, u8, string.size + 1))) {
+    MemoryCopy(copy, string.str, string.size);
+    u64 index = table->count++;
+    table->strings[index] = Str8(copy, string.size);
+    *slot = (hash & 0xffffffff00000000ull) | index;
+  }
+
+  return *slot;
+}
+
+function Atom
+AtomLookup(InternTable *table, String8 string)
+{
+  return *InternTableFindSlot(table, string, HashStr8(string));
+}
+
+function String8
+Str8FromAtom(InternTable *table, Atom atom)
+{
+  String8 result = {0};
+  if (AtomIndex(atom) < table->count) {
+    result = table->strings[AtomIndex(atom)];
+  }
+
+  return result;
+}
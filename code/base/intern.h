@@ -0,0 +1,32 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+/*
+  String interning: every distinct string is stored once and identified by an Atom,
+  so comparing asset names, tags or config keys becomes an integer compare.
+  Atoms stay valid for the lifetime of the table. Not thread safe.
+*/
+
+// High 32 bits: hash of the string, low 32 bits: index into the table. 0 is the null atom
+typedef u64 Atom;
+
+#define AtomIndex(atom) ((u32)(atom))
+#define AtomHash(atom) ((atom) >> 32)
+
+typedef struct InternTable InternTable;
+struct InternTable
+{
+  Arena *arena;   // Owns the string bytes
+  Atom *slots;    // Open addressing with linear probing, 0 when empty
+  u64 slotMask;
+  String8 *strings; // Indexed by AtomIndex
+  u64 count;      // Including the null atom at index 0
+  u64 capacity;
+};
+
+function InternTable* InternTableAlloc(Arena *arena, u64 capacity);      // 0 when the arena is out of memory
+function Atom         AtomFromStr8(InternTable *table, String8 string); // Interns the string if it is new, 0 when the table or arena is full
+function Atom         AtomLookup(InternTable *table, String8 string);   // 0 if the string was never interned
+function String8      Str8FromAtom(InternTable *table, Atom atom);
+
+#endif // INTERN_H
@@ -0,0 +1,12 @@
+function void
+LogInfoLines(String8 text)
+{
+  while (text.size) {
+    u64 lineEnd = Str8Find(text, Str8Lit("\n"), 0, 0);
+    String8 line = Prefix8(text, lineEnd);
+    if (line.size) {
+      LogInfo("%.*s", Str8Expand(line));
+    }
+    text = Str8Skip(text, lineEnd + 1);
+  }
+}
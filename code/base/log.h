@@ -0,0 +1,54 @@
+#ifndef LOG_H
+#define LOG_H
+
+/*
+  Logging front end, shared by the platform and the game. A callsite hands over its format
+  and raw arguments and returns, the platform's logger (log/logger.h) formats them later on
+  its own thread. Formats are printf style, without %n and without a trailing newline. A
+  conversion the logger doesn't know is printed as text, along with the rest of the format.
+  Each callsite registers its format once, so the format is free to live in the game DLL.
+*/
+
+typedef u32 LogLevel;
+enum
+{
+  LogLevel_Debug,
+  LogLevel_Info,
+  LogLevel_Warning,
+  LogLevel_Error,
+  LogLevel_Count,
+};
+
+typedef struct LogSite LogSite;
+struct LogSite
+{
+  LogLevel level;
+  char *file;
+  u32 line;
+  volatile u64 formatId; // Logger generation << 32 | format id, 0 until the logger registered the format
+};
+
+typedef void LogWriteFunc(LogSite *site, char *fmt, ...);
+
+// The platform points this at its logger, the game at PlatformAPI.LogWrite
+global LogWriteFunc *g_logWrite;
+
+#define LogSetWriteFunc(func) (g_logWrite = (func))
+
+#define LogMessage(level, ...) do { \
+    persist LogSite logSite_ = {(level), __FILE__, __LINE__, 0}; \
+    if (g_logWrite) { \
+      g_logWrite(&logSite_, __VA_ARGS__); \
+    } \
+  } while (0)
+
+#define LogDebug(...)   LogMessage(LogLevel_Debug, __VA_ARGS__)
+#define LogInfo(...)    LogMessage(LogLevel_Info, __VA_ARGS__)
+#define LogWarning(...) LogMessage(LogLevel_Warning, __VA_ARGS__)
+#define LogError(...)   LogMessage(LogLevel_Error, __VA_ARGS__)
+
+// Multi-line reports, a message per line so long reports aren't cut to one record. Also an
+// ArenaOverflowFunc
+function void LogInfoLines(String8 text);
+
+#endif // LOG_H
@@ -0,0 +1,274 @@
+// Pool
+
+function Pool*
+PoolAlloc(Arena *arena, u64 align)
+{
+  Assert(IsPow2(align));
+  Pool *pool = ArenaPushN(arena, Pool, 1);
+  pool->arena = arena;
+  pool->align = Max(align, POOL_MIN_SIZE);
+
+  return pool;
+}
+
+function u64
+PoolClassFromSize(u64 size)
+{
+  u64 result = 0;
+  if (size > POOL_MIN_SIZE) {
+    result = IndexOfHighestBit64(size - 1) + 1 - 4;
+  }
+
+  return result;
+}
+
+function void*
+PoolPush(Pool *pool, u64 size)
+{
+  void *result = 0;
+  if (size <= POOL_MAX_SIZE) {
+    u64 classIdx = PoolClassFromSize(size);
+    u64 slotSize = Max((u64)POOL_MIN_SIZE << classIdx, pool->align);
+    if (pool->freeLists[classIdx]) {
+      result = pool->freeLists[classIdx];
+      pool->freeLists[classIdx] = pool->freeLists[classIdx]->next;
+    } else {
+      if (pool->bumpPos[classIdx] == pool->bumpEnd[classIdx]) {
+        u64 blockSize = Max(POOL_BLOCK_SIZE, slotSize);
+        u8 *block = ArenaPushNoZero(pool->arena, blockSize, pool->align);
+        if (block) {
+          pool->bumpPos[classIdx] = block;
+          pool->bumpEnd[classIdx] = block + blockSize;
+          pool->stats.reservedBytes += blockSize;
+        }
+      }
+      if (pool->bumpPos[classIdx] != pool->bumpEnd[classIdx]) {
+        result = pool->bumpPos[classIdx];
+        pool->bumpPos[classIdx] += slotSize;
+      }
+    }
+
+    if (result) {
+      MemoryZero(result, slotSize);
+      pool->stats.liveBytes += slotSize;
+      pool->stats.peakLiveBytes = Max(pool->stats.peakLiveBytes, pool->stats.liveBytes);
+      pool->stats.pushCount++;
+      pool->stats.liveCount[classIdx]++;
+    }
+  }
+
+  return result;
+}
+
+function void
+PoolRelease(Pool *pool, void *ptr, u64 size)
+{
+  if (ptr) {
+    Assert(size <= POOL_MAX_SIZE);
+    u64 classIdx = PoolClassFromSize(size);
+    u64 slotSize = Max((u64)POOL_MIN_SIZE << classIdx, pool->align);
+#if _DEBUG
+    // Make use after free obvious
+    MemorySet(ptr, 0xDD, slotSize);
+#endif
+    PoolFreeNode *node = (PoolFreeNode*)ptr;
+    node->next = pool->freeLists[classIdx];
+    pool->freeLists[classIdx] = node;
+
+    pool->stats.liveBytes -= slotSize;
+    pool->stats.releaseCount++;
+    pool->stats.liveCount[classIdx]--;
+  }
+}
+
+// TLSF
+
+#define TLSF_HEADER_SIZE OffsetOf(TLSFBlock, nextFree)
+#define TLSF_MIN_PAYLOAD (sizeof(TLSFBlock) - TLSF_HEADER_SIZE)
+#define TLSF_BLOCK_FREE  1ull
+
+#define TLSFBlockSize(block) ((block)->size & ~TLSF_BLOCK_FREE)
+#define TLSFBlockIsFree(block) (((block)->size & TLSF_BLOCK_FREE) != 0)
+#define TLSFNextPhys(block) ((TLSFBlock*)((u8*)(block) + TLSF_HEADER_SIZE + TLSFBlockSize(block)))
+
+function void
+TLSFMapping(u64 size, u32 *fl, u32 *sl)
+{
+  if (size < TLSF_SMALL_SIZE) {
+    *fl = 0;
+    *sl = (u32)(size / (TLSF_SMALL_SIZE / TLSF_SL_COUNT));
+  } else {
+    u32 topBit = (u32)IndexOfHighestBit64(size);
+    *sl = (u32)(size >> (topBit - TLSF_SL_SHIFT)) ^ TLSF_SL_COUNT;
+    *fl = topBit - (TLSF_FL_SHIFT - 1);
+  }
+}
+
+function void
+TLSFInsertFree(TLSF *tlsf, TLSFBlock *block)
+{
+  u32 fl, sl;
+  TLSFMapping(TLSFBlockSize(block), &fl, &sl);
+  TLSFBlock *head = tlsf->freeLists[fl][sl];
+  block->nextFree = head;
+  block->prevFree = 0;
+  if (head) {
+    head->prevFree = block;
+  }
+  tlsf->freeLists[fl][sl] = block;
+  tlsf->flBitmap |= 1ull << fl;
+  tlsf->slBitmaps[fl] |= 1u << sl;
+}
+
+function void
+TLSFRemoveFree(TLSF *tlsf, TLSFBlock *block)
+{
+  u32 fl, sl;
+  TLSFMapping(TLSFBlockSize(block), &fl, &sl);
+  if (block->prevFree) {
+    block->prevFree->nextFree = block->nextFree;
+  } else {
+    tlsf->freeLists[fl][sl] = block->nextFree;
+  }
+  if (block->nextFree) {
+    block->nextFree->prevFree = block->prevFree;
+  }
+
+  if (!tlsf->freeLists[fl][sl]) {
+    tlsf->slBitmaps[fl] &= ~(1u << sl);
+    if (!tlsf->slBitmaps[fl]) {
+      tlsf->flBitmap &= ~(1ull << fl);
+    }
+  }
+}
+
+function TLSF*
+TLSFAlloc(Arena *arena, u64 size)
+{
+  TLSF *tlsf = ArenaPushN(arena, TLSF, 1);
+  u64 regionSize = size & ~(u64)(TLSF_ALIGN - 1);
+  u8 *region = ArenaPushNoZero(arena, regionSize, TLSF_ALIGN);
+  if (tlsf && region && regionSize >= 2 * TLSF_HEADER_SIZE + TLSF_MIN_PAYLOAD) {
+    // One free block spanning the region, then a used sentinel of size 0 so merging stops there
+    TLSFBlock *block = (TLSFBlock*)region;
+    block->prevPhys = 0;
+    block->size = Min(regionSize - 2 * TLSF_HEADER_SIZE, (1ull << TLSF_FL_MAX) - TLSF_ALIGN) | TLSF_BLOCK_FREE;
+    TLSFBlock *sentinel = TLSFNextPhys(block);
+    sentinel->prevPhys = block;
+    sentinel->size = 0;
+    TLSFInsertFree(tlsf, block);
+    tlsf->stats.capacity = TLSFBlockSize(block);
+  }
+
+  return tlsf;
+}
+
+function void*
+TLSFPush(TLSF *tlsf, u64 size)
+{
+  void *result = 0;
+  size = AlignUpPow2(Max(size, TLSF_MIN_PAYLOAD), TLSF_ALIGN);
+
+  // Round the request up to the next list boundary, so any block in the list found fits
+  u64 searchSize = size;
+  if (searchSize >= TLSF_SMALL_SIZE) {
+    searchSize += (1ull << (IndexOfHighestBit64(searchSize) - TLSF_SL_SHIFT)) - 1;
+  }
+
+  TLSFBlock *block = 0;
+  if (searchSize < (1ull << TLSF_FL_MAX)) {
+    u32 fl, sl;
+    TLSFMapping(searchSize, &fl, &sl);
+    u32 slMap = tlsf->slBitmaps[fl] & (~0u << sl);
+    if (!slMap) {
+      u64 flMap = (fl + 1 < TLSF_FL_COUNT) ? (tlsf->flBitmap & (~0ull << (fl + 1))) : 0;
+      if (flMap) {
+        fl = (u32)CountTrailingZeros64(flMap);
+        slMap = tlsf->slBitmaps[fl];
+      }
+    }
+    if (slMap) {
+      sl = (u32)CountTrailingZeros64(slMap);
+      block = tlsf->freeLists[fl][sl];
+    }
+  }
+
+  // Nothing in the lists above, but the request's own list may still hold a block that fits
+  if (!block && size < (1ull << TLSF_FL_MAX)) {
+    u32 fl, sl;
+    TLSFMapping(size, &fl, &sl);
+    for (TLSFBlock *candidate = tlsf->freeLists[fl][sl]; candidate && !block; candidate = candidate->nextFree) {
+      block = (TLSFBlockSize(candidate) >= size) ? candidate : 0;
+    }
+  }
+
+  if (block) {
+    TLSFRemoveFree(tlsf, block);
+
+    // Give back the tail if it's big enough to be a block of its own
+    u64 blockSize = TLSFBlockSize(block);
+    if (blockSize >= size + TLSF_HEADER_SIZE + TLSF_MIN_PAYLOAD) {
+      TLSFBlock *rest = (TLSFBlock*)((u8*)block + TLSF_HEADER_SIZE + size);
+      rest->prevPhys = block;
+      rest->size = (blockSize - size - TLSF_HEADER_SIZE) | TLSF_BLOCK_FREE;
+      TLSFNextPhys(rest)->prevPhys = rest;
+      TLSFInsertFree(tlsf, rest);
+      blockSize = size;
+    }
+    block->size = blockSize;
+
+    result = (u8*)block + TLSF_HEADER_SIZE;
+    MemoryZero(result, blockSize);
+    tlsf->stats.usedBytes += blockSize + TLSF_HEADER_SIZE;
+    tlsf->stats.peakUsedBytes = Max(tlsf->stats.peakUsedBytes, tlsf->stats.usedBytes);
+    tlsf->stats.pushCount++;
+  } else {
+    tlsf->stats.failedCount++;
+  }
+
+  return result;
+}
+
+function void
+TLSFRelease(TLSF *tlsf, void *ptr)
+{
+  if (ptr) {
+    TLSFBlock *block = (TLSFBlock*)((u8*)ptr - TLSF_HEADER_SIZE);
+    Assert(!TLSFBlockIsFree(block));
+    tlsf->stats.usedBytes -= TLSFBlockSize(block) + TLSF_HEADER_SIZE;
+    tlsf->stats.releaseCount++;
+
+    // Coalesce with free neighbours right away
+    TLSFBlock *next = TLSFNextPhys(block);
+    if (TLSFBlockIsFree(next)) {
+      TLSFRemoveFree(tlsf, next);
+      block->size += TLSF_HEADER_SIZE + TLSFBlockSize(next);
+      TLSFNextPhys(block)->prevPhys = block;
+    }
+    TLSFBlock *prev = block->prevPhys;
+    if (prev && TLSFBlockIsFree(prev)) {
+      TLSFRemoveFree(tlsf, prev);
+      prev->size += TLSF_HEADER_SIZE + TLSFBlockSize(block);
+      TLSFNextPhys(prev)->prevPhys = prev;
+      block = prev;
+    }
+
+    block->size |= TLSF_BLOCK_FREE;
+    TLSFInsertFree(tlsf, block);
+  }
+}
+
+function TLSFStats
+TLSFGetStats(TLSF *tlsf)
+{
+  TLSFStats result = tlsf->stats;
+  if (tlsf->flBitmap) {
+    u64 fl = IndexOfHighestBit64(tlsf->flBitmap);
+    u64 sl = IndexOfHighestBit64(tlsf->slBitmaps[fl]);
+    for (TLSFBlock *block = tlsf->freeLists[fl][sl]; block; block = block->nextFree) {
+      result.largestFreeBlock = Max(result.largestFreeBlock, TLSFBlockSize(block));
+    }
+  }
+
+  return result;
+}
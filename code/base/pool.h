@@ -0,0 +1,106 @@
+#ifndef POOL_H
+#define POOL_H
+
+/*
+  Allocators for things that die in any order, layered on Arena.
+
+  Pool: power of 2 size classes from 16 bytes to POOL_MAX_SIZE, each with its own free list.
+  Slots are carved from POOL_BLOCK_SIZE blocks pushed on the arena, push and release are O(1).
+  Memory is reused by the same size class, never returned to the arena.
+
+  TLSF: two level segregated fit allocator (Masmano et al.) over one region pushed on the arena,
+  O(1) push and release for any size with immediate coalescing, for mid-lifetime data that
+  doesn't fit a size class. 16 byte alignment.
+*/
+
+// Pool
+
+#define POOL_MIN_SIZE   16
+#define POOL_MAX_SIZE   Kilobytes(4)
+#define POOL_CLASS_COUNT 9 // 16 .. 4K
+#define POOL_BLOCK_SIZE Kilobytes(64)
+
+typedef struct PoolFreeNode PoolFreeNode;
+struct PoolFreeNode
+{
+  PoolFreeNode *next;
+};
+
+typedef struct PoolStats PoolStats;
+struct PoolStats
+{
+  u64 liveBytes;      // In slot sizes
+  u64 peakLiveBytes;
+  u64 reservedBytes;  // Pushed on the arena
+  u64 pushCount;
+  u64 releaseCount;
+  u64 liveCount[POOL_CLASS_COUNT];
+};
+
+typedef struct Pool Pool;
+struct Pool
+{
+  Arena *arena;
+  u64 align;
+  PoolFreeNode *freeLists[POOL_CLASS_COUNT];
+  u8 *bumpPos[POOL_CLASS_COUNT]; // Uncarved rest of each class' current block
+  u8 *bumpEnd[POOL_CLASS_COUNT];
+  PoolStats stats;
+};
+
+function Pool* PoolAlloc(Arena *arena, u64 align); // align is a power of 2, pass CACHE_LINE_SIZE to keep slots from sharing lines
+function void* PoolPush(Pool *pool, u64 size);     // Zeroed, 0 when size > POOL_MAX_SIZE or the arena is full
+function void  PoolRelease(Pool *pool, void *ptr, u64 size); // size as passed to PoolPush
+
+#define PoolPushT(pool, type) ((type*)PoolPush((pool), sizeof(type)))
+#define PoolReleaseT(pool, ptr) PoolRelease((pool), (ptr), sizeof(*(ptr)))
+
+// TLSF
+
+#define TLSF_ALIGN       16
+#define TLSF_SL_SHIFT    4 // 16 second level lists per first level
+#define TLSF_SL_COUNT    (1 << TLSF_SL_SHIFT)
+#define TLSF_FL_SHIFT    (TLSF_SL_SHIFT + 4) // Below 256 bytes the lists are linear in steps of TLSF_ALIGN
+#define TLSF_SMALL_SIZE  (1 << TLSF_FL_SHIFT)
+#define TLSF_FL_MAX      40 // Largest block is 1TB
+#define TLSF_FL_COUNT    (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+
+typedef struct TLSFBlock TLSFBlock;
+struct TLSFBlock
+{
+  TLSFBlock *prevPhys; // Block right before this one in memory, 0 for the first
+  u64 size;            // Payload size, bit 0 set when free
+  // Payload starts here, free blocks keep their list links in it
+  TLSFBlock *nextFree;
+  TLSFBlock *prevFree;
+};
+
+typedef struct TLSFStats TLSFStats;
+struct TLSFStats
+{
+  u64 capacity;
+  u64 usedBytes; // Payload plus headers
+  u64 peakUsedBytes;
+  u64 largestFreeBlock;
+  u64 pushCount;
+  u64 releaseCount;
+  u64 failedCount;
+};
+
+typedef struct TLSF TLSF;
+struct TLSF
+{
+  u64 flBitmap;
+  u32 slBitmaps[TLSF_FL_COUNT];
+  TLSFBlock *freeLists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+  TLSFStats stats;
+};
+
+function TLSF*     TLSFAlloc(Arena *arena, u64 size);
+function void*     TLSFPush(TLSF *tlsf, u64 size); // Zeroed, 0 when no free block is big enough
+function void      TLSFRelease(TLSF *tlsf, void *ptr);
+function TLSFStats TLSFGetStats(TLSF *tlsf);
+
+#define TLSFPushT(tlsf, type) ((type*)TLSFPush((tlsf), sizeof(type)))
+
+#endif // POOL_H
@@ -0,0 +1,56 @@
+function SPSCQueue*
+SPSCQueueAlloc(Arena *arena, u64 slotSize, u64 slotCount)
+{
+  Assert(IsPow2(slotCount));
+
+  SPSCQueue *queue = ArenaPush(arena, sizeof(SPSCQueue), CACHE_LINE_SIZE);
+  if (queue) {
+    queue->slots = ArenaPush(arena, slotSize * slotCount, CACHE_LINE_SIZE);
+    queue->slotSize = slotSize;
+    queue->slotMask = slotCount - 1;
+  }
+
+  return queue;
+}
+
+function b32
+SPSCQueuePush(SPSCQueue *queue, void *item)
+{
+  b32 result = 0;
+
+  u64 writePos = queue->writePos;
+  if (writePos - queue->cachedReadPos > queue->slotMask) {
+    queue->cachedReadPos = AtomicLoadU64(&queue->readPos);
+  }
+  if (writePos - queue->cachedReadPos <= queue->slotMask) {
+    MemoryCopy(queue->slots + (writePos & queue->slotMask) * queue->slotSize, item, queue->slotSize);
+    AtomicStoreU64(&queue->writePos, writePos + 1);
+    result = 1;
+  }
+
+  return result;
+}
+
+function b32
+SPSCQueuePop(SPSCQueue *queue, void *item)
+{
+  b32 result = 0;
+
+  u64 readPos = queue->readPos;
+  if (readPos == queue->cachedWritePos) {
+    queue->cachedWritePos = AtomicLoadU64(&queue->writePos);
+  }
+  if (readPos != queue->cachedWritePos) {
+    MemoryCopy(item, queue->slots + (readPos & queue->slotMask) * queue->slotSize, queue->slotSize);
+    AtomicStoreU64(&queue->readPos, readPos + 1);
+    result = 1;
+  }
+
+  return result;
+}
+
+function u64
+SPSCQueueCount(SPSCQueue *queue)
+{
+  return AtomicLoadU64(&queue->writePos) - AtomicLoadU64(&queue->readPos);
+}
@@ -0,0 +1,32 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+/*
+  Lock-free single producer / single consumer ring of fixed size slots.
+  Exactly one thread may push and exactly one (other) thread may pop.
+*/
+
+typedef struct SPSCQueue SPSCQueue;
+struct SPSCQueue
+{
+  u8 *slots;
+  u64 slotSize;
+  u64 slotMask; // Slot count - 1, slot count is a power of 2
+
+  // Producer and consumer each own a cache line, plus a cached copy of the other's position
+  u8 pad0[CACHE_LINE_SIZE];
+  volatile u64 writePos;
+  u64 cachedReadPos;
+  u8 pad1[CACHE_LINE_SIZE];
+  volatile u64 readPos;
+  u64 cachedWritePos;
+  u8 pad2[CACHE_LINE_SIZE];
+};
+
+function SPSCQueue* SPSCQueueAlloc(Arena *arena, u64 slotSize, u64 slotCount);
+#define SPSCQueueAllocN(arena, type, count) SPSCQueueAlloc((arena), sizeof(type), (count))
+function b32        SPSCQueuePush(SPSCQueue *queue, void *item); // Returns 0 when full
+function b32        SPSCQueuePop(SPSCQueue *queue, void *item);  // Returns 0 when empty
+function u64        SPSCQueueCount(SPSCQueue *queue);
+
+#endif // QUEUE_H
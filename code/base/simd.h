@@ -0,0 +1,45 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// SSE2 is baseline on x64, wider paths are picked at runtime
+
+#if ARCH_X64
+# include <immintrin.h>
+#elif ARCH_ARM64
+# include <arm_neon.h>
+#endif
+
+#if COMPILER_MSVC
+# define SIMD_TARGET_AVX2
+#elif COMPILER_CLANG || COMPILER_GCC
+# define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+function inline b32
+CPUHasAVX2(void)
+{
+  persist b32 checked = 0;
+  persist b32 result = 0;
+  if (!checked) {
+#if ARCH_X64 && COMPILER_MSVC
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+      __cpuid(info, 1);
+      b32 hasOSXSave = (info[2] & (1 << 27)) != 0;
+      b32 hasAVX = (info[2] & (1 << 28)) != 0;
+      __cpuidex(info, 7, 0);
+      b32 hasAVX2 = (info[1] & (1 << 5)) != 0;
+      // The OS also has to save the upper halves of the ymm registers
+      result = hasOSXSave && hasAVX && hasAVX2 && ((_xgetbv(0) & 6) == 6);
+    }
+#elif ARCH_X64 && (COMPILER_CLANG || COMPILER_GCC)
+    result = __builtin_cpu_supports("avx2");
+#endif
+    checked = 1;
+  }
+
+  return result;
+}
+
+#endif // SIMD_H
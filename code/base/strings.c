@@ -56,23 +56,367 @@ Suffix8(String8 string, u64 size)
   return Substr8Opl(string, string.size - size, string.size);
 }
 
+// SIMD kernels, the 64 byte ones return one bit per byte
+
+#if ARCH_X64
+function inline __m128i
+Str8LowerSSE2(__m128i bytes)
+{
+  // Shift 'A'..'Z' to the bottom of the signed range so a single compare finds them
+  __m128i shifted = _mm_add_epi8(bytes, _mm_set1_epi8((char)(0x80 - 'A')));
+  __m128i isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+  return _mm_or_si128(bytes, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+
+SIMD_TARGET_AVX2 function inline __m256i
+Str8LowerAVX2(__m256i bytes)
+{
+  __m256i shifted = _mm256_add_epi8(bytes, _mm256_set1_epi8((char)(0x80 - 'A')));
+  __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), shifted);
+  return _mm256_or_si256(bytes, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+}
+
+function b32
+Str8MatchNoCaseSSE2(u8 *a, u8 *b, u64 size)
+{
+  b32 result = 1;
+  u64 i = 0;
+  for (; i + 16 <= size && result; i += 16) {
+    __m128i aBytes = Str8LowerSSE2(_mm_loadu_si128((__m128i*)(a + i)));
+    __m128i bBytes = Str8LowerSSE2(_mm_loadu_si128((__m128i*)(b + i)));
+    result = (_mm_movemask_epi8(_mm_cmpeq_epi8(aBytes, bBytes)) == 0xFFFF);
+  }
+  for (; i < size && result; ++i) {
+    result = (CharToLower(a[i]) == CharToLower(b[i]));
+  }
+
+  return result;
+}
+
+// Positions where the first and last byte of the needle both line up
+function u64
+Str8FindMask64SSE2(u8 *ptr, u64 lastOffset, u8 first, u8 last, b32 noCase)
+{
+  __m128i firstBytes = _mm_set1_epi8((char)first);
+  __m128i lastBytes = _mm_set1_epi8((char)last);
+  u64 result = 0;
+  for (u64 i = 0; i < 64; i += 16) {
+    __m128i a = _mm_loadu_si128((__m128i*)(ptr + i));
+    __m128i b = _mm_loadu_si128((__m128i*)(ptr + i + lastOffset));
+    if (noCase) {
+      a = Str8LowerSSE2(a);
+      b = Str8LowerSSE2(b);
+    }
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(a, firstBytes), _mm_cmpeq_epi8(b, lastBytes));
+    result |= (u64)(u32)_mm_movemask_epi8(eq) << i;
+  }
+
+  return result;
+}
+
+SIMD_TARGET_AVX2 function u64
+Str8FindMask64AVX2(u8 *ptr, u64 lastOffset, u8 first, u8 last, b32 noCase)
+{
+  __m256i firstBytes = _mm256_set1_epi8((char)first);
+  __m256i lastBytes = _mm256_set1_epi8((char)last);
+  u64 result = 0;
+  for (u64 i = 0; i < 64; i += 32) {
+    __m256i a = _mm256_loadu_si256((__m256i*)(ptr + i));
+    __m256i b = _mm256_loadu_si256((__m256i*)(ptr + i + lastOffset));
+    if (noCase) {
+      a = Str8LowerAVX2(a);
+      b = Str8LowerAVX2(b);
+    }
+    __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, firstBytes), _mm256_cmpeq_epi8(b, lastBytes));
+    result |= (u64)(u32)_mm256_movemask_epi8(eq) << i;
+  }
+
+  return result;
+}
+
+function u64
+Str8ClassMask64SSE2(Str8ByteClass *byteClass, u8 *ptr)
+{
+  u64 result = 0;
+  for (u64 i = 0; i < 64; i += 16) {
+    __m128i bytes = _mm_loadu_si128((__m128i*)(ptr + i));
+    __m128i isMember = _mm_setzero_si128();
+    for (u32 charIdx = 0; charIdx < byteClass->charCount; ++charIdx) {
+      isMember = _mm_or_si128(isMember, _mm_cmpeq_epi8(bytes, _mm_set1_epi8((char)byteClass->chars[charIdx])));
+    }
+    result |= (u64)(u32)_mm_movemask_epi8(isMember) << i;
+  }
+
+  return result;
+}
+
+SIMD_TARGET_AVX2 function u64
+Str8ClassMask64AVX2(Str8ByteClass *byteClass, u8 *ptr)
+{
+  __m256i loTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)byteClass->lo));
+  __m256i hiTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)byteClass->hi));
+  __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+  u64 result = 0;
+  for (u64 i = 0; i < 64; i += 32) {
+    __m256i bytes = _mm256_loadu_si256((__m256i*)(ptr + i));
+    __m256i lo = _mm256_shuffle_epi8(loTable, _mm256_and_si256(bytes, nibbleMask));
+    __m256i hi = _mm256_shuffle_epi8(hiTable, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibbleMask));
+    __m256i isOther = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+    result |= (u64)(~(u32)_mm256_movemask_epi8(isOther)) << i;
+  }
+
+  return result;
+}
+#elif ARCH_ARM64
+function inline uint8x16_t
+Str8LowerNEON(uint8x16_t bytes)
+{
+  uint8x16_t isUpper = vcltq_u8(vsubq_u8(bytes, vdupq_n_u8('A')), vdupq_n_u8(26));
+  return vorrq_u8(bytes, vandq_u8(isUpper, vdupq_n_u8(0x20)));
+}
+
+// NEON has no movemask, weight each lane by its bit and add pairwise down to 8 bytes
+function inline u64
+Str8MoveMask64NEON(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3)
+{
+  read_only u8 bitWeights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t weights = vld1q_u8(bitWeights);
+  uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, weights), vandq_u8(m1, weights));
+  uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, weights), vandq_u8(m3, weights));
+  sum0 = vpaddq_u8(sum0, sum1);
+  sum0 = vpaddq_u8(sum0, sum0);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+function b32
+Str8MatchNoCaseNEON(u8 *a, u8 *b, u64 size)
+{
+  b32 result = 1;
+  u64 i = 0;
+  for (; i + 16 <= size && result; i += 16) {
+    uint8x16_t eq = vceqq_u8(Str8LowerNEON(vld1q_u8(a + i)), Str8LowerNEON(vld1q_u8(b + i)));
+    result = (vminvq_u8(eq) == 0xFF);
+  }
+  for (; i < size && result; ++i) {
+    result = (CharToLower(a[i]) == CharToLower(b[i]));
+  }
+
+  return result;
+}
+
+function u64
+Str8FindMask64NEON(u8 *ptr, u64 lastOffset, u8 first, u8 last, b32 noCase)
+{
+  uint8x16_t firstBytes = vdupq_n_u8(first);
+  uint8x16_t lastBytes = vdupq_n_u8(last);
+  uint8x16_t eq[4];
+  for (u64 i = 0; i < 4; ++i) {
+    uint8x16_t a = vld1q_u8(ptr + 16*i);
+    uint8x16_t b = vld1q_u8(ptr + 16*i + lastOffset);
+    if (noCase) {
+      a = Str8LowerNEON(a);
+      b = Str8LowerNEON(b);
+    }
+    eq[i] = vandq_u8(vceqq_u8(a, firstBytes), vceqq_u8(b, lastBytes));
+  }
+
+  return Str8MoveMask64NEON(eq[0], eq[1], eq[2], eq[3]);
+}
+
+function u64
+Str8ClassMask64NEON(Str8ByteClass *byteClass, u8 *ptr)
+{
+  uint8x16_t loTable = vld1q_u8(byteClass->lo);
+  uint8x16_t hiTable = vld1q_u8(byteClass->hi);
+  uint8x16_t nibbleMask = vdupq_n_u8(0x0F);
+  uint8x16_t isMember[4];
+  for (u64 i = 0; i < 4; ++i) {
+    uint8x16_t bytes = vld1q_u8(ptr + 16*i);
+    uint8x16_t lo = vqtbl1q_u8(loTable, vandq_u8(bytes, nibbleMask));
+    uint8x16_t hi = vqtbl1q_u8(hiTable, vshrq_n_u8(bytes, 4));
+    isMember[i] = vtstq_u8(lo, hi);
+  }
+
+  return Str8MoveMask64NEON(isMember[0], isMember[1], isMember[2], isMember[3]);
+}
+#endif
+
+function b32
+Str8MatchBytes(u8 *a, u8 *b, u64 size, b32 noCase)
+{
+  b32 result = 1;
+  if (!noCase) {
+    result = MemoryMatch(a, b, size);
+  } else {
+#if ARCH_X64
+    result = Str8MatchNoCaseSSE2(a, b, size);
+#elif ARCH_ARM64
+    result = Str8MatchNoCaseNEON(a, b, size);
+#else
+    for (u64 i = 0; i < size && result; ++i) {
+      result = (CharToLower(a[i]) == CharToLower(b[i]));
+    }
+#endif
+  }
+
+  return result;
+}
+
+function u64
+Str8FindMask64(u8 *ptr, u64 lastOffset, u8 first, u8 last, b32 noCase)
+{
+  u64 result = 0;
+#if ARCH_X64
+  if (CPUHasAVX2()) {
+    result = Str8FindMask64AVX2(ptr, lastOffset, first, last, noCase);
+  } else {
+    result = Str8FindMask64SSE2(ptr, lastOffset, first, last, noCase);
+  }
+#elif ARCH_ARM64
+  result = Str8FindMask64NEON(ptr, lastOffset, first, last, noCase);
+#else
+  for (u64 i = 0; i < 64; ++i) {
+    u8 a = noCase ? CharToLower(ptr[i]) : ptr[i];
+    u8 b = noCase ? CharToLower(ptr[i + lastOffset]) : ptr[i + lastOffset];
+    result |= (u64)(a == first && b == last) << i;
+  }
+#endif
+
+  return result;
+}
+
+function void
+Str8ByteClassInit(Str8ByteClass *byteClass, u8 *chars, u64 charCount)
+{
+  MemoryZeroStruct(byteClass);
+  u8 hiNibbles[8];
+  u32 hiNibbleCount = 0;
+  byteClass->hasNibbleTables = 1;
+  for (u64 charIdx = 0; charIdx < charCount; ++charIdx) {
+    u8 c = chars[charIdx];
+    byteClass->isMember[c] = 1;
+
+    // Every distinct high nibble gets its own bit
+    u32 bit = 0;
+    while (bit < hiNibbleCount && hiNibbles[bit] != (c >> 4)) {
+      ++bit;
+    }
+    if (bit == hiNibbleCount && hiNibbleCount < ArrayCount(hiNibbles)) {
+      hiNibbles[hiNibbleCount++] = c >> 4;
+    }
+    if (bit < hiNibbleCount) {
+      byteClass->hi[c >> 4] |= (u8)(1 << bit);
+      byteClass->lo[c & 15] |= (u8)(1 << bit);
+    } else {
+      byteClass->hasNibbleTables = 0;
+    }
+  }
+
+  if (charCount <= ArrayCount(byteClass->chars)) {
+    MemoryCopy(byteClass->chars, chars, charCount);
+    byteClass->charCount = (u32)charCount;
+  }
+}
+
+function u64
+Str8ClassMask64(Str8ByteClass *byteClass, u8 *ptr)
+{
+  u64 result = 0;
+#if ARCH_X64
+  if (byteClass->hasNibbleTables && CPUHasAVX2()) {
+    result = Str8ClassMask64AVX2(byteClass, ptr);
+  } else if (byteClass->charCount) {
+    result = Str8ClassMask64SSE2(byteClass, ptr);
+  } else
+#elif ARCH_ARM64
+  if (byteClass->hasNibbleTables) {
+    result = Str8ClassMask64NEON(byteClass, ptr);
+  } else
+#endif
+  {
+    for (u64 i = 0; i < 64; ++i) {
+      result |= (u64)byteClass->isMember[ptr[i]] << i;
+    }
+  }
+
+  return result;
+}
+
 function b32
 Str8Match(String8 a, String8 b, StringMatchFlags matchFlags)
 {
   b32 result = 0;
   if (a.size == b.size) {
-    result = 1;
-    b32 noCase = ((matchFlags & StringMatch_CaseInsensitive) != 0);
-    for (u64 i = 0; i < a.size; ++i) {
-      u8 ac = a.str[i];
-      u8 bc = b.str[i];
-      if (noCase) {
-        ac = CharToLower(ac);
-        bc = CharToLower(bc);
+    result = Str8MatchBytes(a.str, b.str, a.size, (matchFlags & StringMatch_CaseInsensitive) != 0);
+  }
+
+  return result;
+}
+
+function u64
+Str8Find(String8 string, String8 needle, u64 startPos, StringMatchFlags matchFlags)
+{
+  u64 result = string.size;
+  b32 noCase = ((matchFlags & StringMatch_CaseInsensitive) != 0);
+  if (needle.size == 0) {
+    result = Min(startPos, string.size);
+  } else if (needle.size <= string.size && startPos <= string.size - needle.size) {
+    u8 first = noCase ? CharToLower(needle.str[0]) : needle.str[0];
+    u8 last = noCase ? CharToLower(needle.str[needle.size - 1]) : needle.str[needle.size - 1];
+    u64 lastOffset = needle.size - 1;
+    u64 candidateCount = string.size - needle.size + 1;
+    b32 found = 0;
+
+    // Filter 64 candidates at a time on their first and last byte, then check the survivors
+    u64 pos = startPos;
+    for (; pos + 64 <= candidateCount && !found; pos += 64) {
+      for (u64 mask = Str8FindMask64(string.str + pos, lastOffset, first, last, noCase); mask && !found; mask &= mask - 1) {
+        u64 candidate = pos + CountTrailingZeros64(mask);
+        if (Str8MatchBytes(string.str + candidate, needle.str, needle.size, noCase)) {
+          result = candidate;
+          found = 1;
+        }
+      }
+    }
+    for (; pos < candidateCount && !found; ++pos) {
+      if (Str8MatchBytes(string.str + pos, needle.str, needle.size, noCase)) {
+        result = pos;
+        found = 1;
+      }
+    }
+  }
+
+  return result;
+}
+
+function u64
+Str8FindLast(String8 string, String8 needle, StringMatchFlags matchFlags)
+{
+  u64 result = string.size;
+  b32 noCase = ((matchFlags & StringMatch_CaseInsensitive) != 0);
+  if (needle.size && needle.size <= string.size) {
+    u8 first = noCase ? CharToLower(needle.str[0]) : needle.str[0];
+    u8 last = noCase ? CharToLower(needle.str[needle.size - 1]) : needle.str[needle.size - 1];
+    u64 lastOffset = needle.size - 1;
+    b32 found = 0;
+
+    // Same as Str8Find, walking blocks backwards from one past the last candidate
+    u64 opl = string.size - needle.size + 1;
+    for (; opl >= 64 && !found; opl -= 64) {
+      for (u64 mask = Str8FindMask64(string.str + opl - 64, lastOffset, first, last, noCase); mask && !found;) {
+        u64 bit = IndexOfHighestBit64(mask);
+        u64 candidate = opl - 64 + bit;
+        if (Str8MatchBytes(string.str + candidate, needle.str, needle.size, noCase)) {
+          result = candidate;
+          found = 1;
+        }
+        mask &= ~(1ull << bit);
       }
-      if (ac != bc) {
-        result = 0;
-        break;
+    }
+    for (; opl > 0 && !found; --opl) {
+      if (Str8MatchBytes(string.str + opl - 1, needle.str, needle.size, noCase)) {
+        result = opl - 1;
+        found = 1;
       }
     }
   }
@@ -90,20 +434,67 @@ PushStr8Copy(Arena *arena, String8 string)
   return result;
 }
 
-function String8
-PushStr8FV(Arena *arena, char *fmt, va_list args)
+// Single pass formatting: stb writes straight into the arena's free space, chunk after chunk.
+// Only the last STB_SPRINTF_MIN bytes before the end of the arena go through a scratch chunk
+
+typedef struct Str8Formatter Str8Formatter;
+struct Str8Formatter
 {
-  String8 result = {0};
+  u8 *at;
+  u8 *end;
+  char scratch[STB_SPRINTF_MIN];
+};
+
+function char*
+Str8FormatCallback(const char *buf, void *user, int len)
+{
+  Str8Formatter *formatter = (Str8Formatter*)user;
+  u64 size = (u64)len;
+  if (buf == formatter->scratch) {
+    size = Min(size, (u64)(formatter->end - formatter->at)); // Out of arena, the rest is cut
+    MemoryCopy(formatter->at, buf, size);
+  }
+  formatter->at += size;
+
+  char *result = 0;
+  u64 left = (u64)(formatter->end - formatter->at);
+  if (left >= STB_SPRINTF_MIN) {
+    result = (char*)formatter->at;
+  } else if (left) {
+    result = formatter->scratch;
+  }
 
-  va_list argsCpy;
-  va_copy(argsCpy, args);
+  return result;
+}
+
+// Formats at the top of the arena and pushes the text, without a null terminator
+function String8
+Str8FormatIntoArena(Arena *arena, char *fmt, va_list args)
+{
+  Str8Formatter formatter;
+  formatter.at = (u8*)arena + arena->pos;
+  formatter.end = (u8*)arena + arena->cap - 1; // Keep a byte for the terminator
+
+  u8 *start = formatter.at;
+  char *buffer = (formatter.end - formatter.at >= STB_SPRINTF_MIN) ? (char*)formatter.at : formatter.scratch;
+  if (formatter.at < formatter.end) {
+    stbsp_vsprintfcb(Str8FormatCallback, &formatter, buffer, fmt, args);
+  }
 
-  int neededBytes = stbsp_vsnprintf(0, 0, fmt, args) + 1;
-  result.str = ArenaPushN(arena, u8, neededBytes);
-  result.size = neededBytes - 1;
-  stbsp_vsnprintf((char*)result.str, neededBytes, fmt, argsCpy);
+  String8 result;
+  result.size = (u64)(formatter.at - start);
+  result.str = ArenaPushNoZero(arena, result.size, 1);
+  return result;
+}
 
-  va_end(argsCpy);
+function String8
+PushStr8FV(Arena *arena, char *fmt, va_list args)
+{
+  String8 result = Str8FormatIntoArena(arena, fmt, args);
+  u8 *terminator = ArenaPushNoZero(arena, 1, 1);
+  if (terminator) {
+    *terminator = 0;
+  }
 
   return result;
 }
@@ -182,29 +573,31 @@ function String8List
 Str8Split(Arena *arena, String8 string, u64 numSplits, u8 *splits)
 {
   String8List result = {0};
-
-  u8 *ptr = string.str;
-  u8 *first = ptr;
-  u8 *opl = ptr + string.size;
-  for (;ptr < opl; ++ptr) {
-    u8 byte = *ptr;
-    b32 split = 0;
-    for (u64 i = 0; i < numSplits; ++i) {
-      if (byte == splits[i]) {
-        split = 1;
-        break;
-      }
+  Str8ByteClass byteClass;
+  Str8ByteClassInit(&byteClass, splits, numSplits);
+
+  u8 *first = string.str;
+  u64 i = 0;
+  for (; i + 64 <= string.size; i += 64) {
+    for (u64 mask = Str8ClassMask64(&byteClass, string.str + i); mask; mask &= mask - 1) {
+      u8 *ptr = string.str + i + CountTrailingZeros64(mask);
+      if (first < ptr)
+        Str8ListPush(arena, &result, Str8Range(first, ptr));
+      first = ptr + 1;
     }
-
-    if (split) {
+  }
+  for (; i < string.size; ++i) {
+    if (byteClass.isMember[string.str[i]]) {
+      u8 *ptr = string.str + i;
       if (first < ptr)
         Str8ListPush(arena, &result, Str8Range(first, ptr));
       first = ptr + 1;
     }
   }
 
-  if (first < ptr) {
-    Str8ListPush(arena, &result, Str8Range(first, ptr));
+  u8 *opl = string.str + string.size;
+  if (first < opl) {
+    Str8ListPush(arena, &result, Str8Range(first, opl));
   }
 
   return result;
@@ -219,27 +612,108 @@ Str8ListJoin(Arena *arena, String8List *list, String8Join *optParams)
 
   u64 size = join.pre.size + join.post.size + (join.sep.size * (list->count - 1)) + list->totalSize;
   u8 *str = ArenaPushN(arena, u8, size + 1);
-  u8 *ptr = str;
-
-  // Pre
-  MemoryCopy(ptr, join.pre.str, join.pre.size);
-  ptr += join.pre.size;
-
-  // Sep
-  for (String8Node *node = list->first; node; node = node->next) {
-    MemoryCopy(ptr, node->string.str, node->string.size);
-    ptr += node->string.size;
-    if (node != list->last) {
-      MemoryCopy(ptr, join.sep.str, join.sep.size);
-      ptr += join.sep.size;
+  String8 result = {0};
+  if (str) {
+    u8 *ptr = str;
+
+    // Pre
+    MemoryCopy(ptr, join.pre.str, join.pre.size);
+    ptr += join.pre.size;
+
+    // Sep
+    for (String8Node *node = list->first; node; node = node->next) {
+      MemoryCopy(ptr, node->string.str, node->string.size);
+      ptr += node->string.size;
+      if (node != list->last) {
+        MemoryCopy(ptr, join.sep.str, join.sep.size);
+        ptr += join.sep.size;
+      }
+    }
+
+    // Post
+    MemoryCopy(ptr, join.post.str, join.post.size);
+    ptr += join.post.size;
+    result = Str8(str, size);
+  }
+
+  return result;
+}
+
+function Str8Builder
+Str8BuilderBegin(Arena *arena)
+{
+  Str8Builder result = {0};
+  result.arena = arena;
+  return result;
+}
+
+// Continues the last piece when nothing was pushed after it, starts a new one otherwise
+function String8Node*
+Str8BuilderTopPiece(Str8Builder *builder)
+{
+  String8Node *result = builder->pieces.last;
+  u8 *top = (u8*)builder->arena + builder->arena->pos;
+  if (!result || result->string.str + result->string.size != top) {
+    result = ArenaPushN(builder->arena, String8Node, 1);
+    if (result) {
+      result->string.str = (u8*)builder->arena + builder->arena->pos;
+      Str8ListPushNode(&builder->pieces, result);
     }
   }
 
-  // Post
-  MemoryCopy(ptr, join.post.str, join.post.size);
-  ptr += join.post.size;
+  return result;
+}
+
+function void
+Str8BuilderAppend(Str8Builder *builder, String8 string)
+{
+  String8Node *piece = Str8BuilderTopPiece(builder);
+  u8 *dest = piece ? ArenaPushNoZero(builder->arena, string.size, 1) : 0;
+  if (dest) {
+    MemoryCopy(dest, string.str, string.size);
+    piece->string.size += string.size;
+    builder->pieces.totalSize += string.size;
+  }
+}
+
+function void
+Str8BuilderAppendFV(Str8Builder *builder, char *fmt, va_list args)
+{
+  String8Node *piece = Str8BuilderTopPiece(builder);
+  if (piece) {
+    String8 string = Str8FormatIntoArena(builder->arena, fmt, args);
+    piece->string.size += string.size;
+    builder->pieces.totalSize += string.size;
+  }
+}
+
+function void
+Str8BuilderAppendF(Str8Builder *builder, char *fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  Str8BuilderAppendFV(builder, fmt, args);
+  va_end(args);
+}
+
+function String8
+Str8BuilderEnd(Str8Builder *builder)
+{
+  String8 result = {0};
+  String8Node *last = builder->pieces.last;
+  if (!last) {
+    // Nothing appended, or no room for even the first piece
+  } else if (builder->pieces.count == 1 && last->string.str + last->string.size == (u8*)builder->arena + builder->arena->pos) {
+    u8 *terminator = ArenaPushNoZero(builder->arena, 1, 1);
+    if (terminator) {
+      *terminator = 0;
+    }
+    result = last->string;
+  } else {
+    result = Str8ListJoin(builder->arena, &builder->pieces, 0);
+  }
 
-  return Str8(str, size);
+  return result;
 }
 
 function String8
@@ -44,12 +44,35 @@ enum
   StringMatch_CaseInsensitive = (1 << 0),
 };
 
+// Set of delimiter bytes, in the shapes the split kernels want
+typedef struct Str8ByteClass Str8ByteClass;
+struct Str8ByteClass
+{
+  u8 isMember[256];
+  // A byte is a member iff lo[byte & 15] & hi[byte >> 4], only when the members have at most 8 distinct high nibbles
+  u8 lo[16];
+  u8 hi[16];
+  b32 hasNibbleTables;
+  // SSE2 has no byte shuffle, it compares against up to 8 bytes directly
+  u8 chars[8];
+  u32 charCount; // 0 when there are more than 8
+};
+
 typedef struct String8Join String8Join;
 struct String8Join
 {
   String8 pre, sep, post;
 };
 
+// Appends to the top of an arena. Pieces that land back to back are merged, so a builder
+// nobody pushes in between of ends up as one string without a copy
+typedef struct Str8Builder Str8Builder;
+struct Str8Builder
+{
+  Arena *arena;
+  String8List pieces;
+};
+
 // ASCII helpers
 
 function inline b32
@@ -132,6 +155,8 @@ function String8 Suffix8(String8 string, u64 size);
 
 // Matching
 function b32 Str8Match(String8 a, String8 b, StringMatchFlags matchFlags);
+function u64 Str8Find(String8 string, String8 needle, u64 startPos, StringMatchFlags matchFlags); // string.size if not found
+function u64 Str8FindLast(String8 string, String8 needle, StringMatchFlags matchFlags);           // string.size if not found
 
 // Allocation
 function String8 PushStr8Copy(Arena *arena, String8 string);
@@ -148,6 +173,13 @@ function void Str8ListConcat(String8List *list, String8List *target);
 function String8List Str8Split(Arena *arena, String8 string, u64 numSplits, u8 *splits);
 function String8 Str8ListJoin(Arena *arena, String8List *list, String8Join *optParams);
 
+// Builders
+function Str8Builder Str8BuilderBegin(Arena *arena);
+function void        Str8BuilderAppend(Str8Builder *builder, String8 string);
+function void        Str8BuilderAppendFV(Str8Builder *builder, char *fmt, va_list args);
+function void        Str8BuilderAppendF(Str8Builder *builder, char *fmt, ...);
+function String8     Str8BuilderEnd(Str8Builder *builder); // Null terminated, only copies when the pieces were split up
+
 // Styling
 function String8 Str8Upper(Arena *arena, String8 string);
 function String8 Str8Lower(Arena *arena, String8 string);
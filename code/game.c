@@ -9,16 +9,10 @@
 // Headers
 
 #include "base/base_include.h"
+#include "render/render.h"
 #include "game.h"
 
 // Source
-#define SOKOL_IMPL
-#define SOKOL_DEBUG
-#define SOKOL_GLCORE33
-#include <sokol/sokol_log.h>
-#include <sokol/sokol_gfx.h>
-#include <sokol/sokol_gp.h>
-
 #define STB_SPRINTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_sprintf.h>
@@ -35,10 +29,12 @@
 #include <HandmadeMath.h>
 
 #include "base/base_include.c"
+#include "render/render.c"
 
 #define PLAYER_SPEED 6
 
 #define GAME_DATA_SIZE Kilobytes(4)
+#define GAME_MEMORY_REPORT_INTERVAL 600 // Frames
 typedef struct Game Game;
 struct Game
 {
@@ -47,14 +43,13 @@ struct Game
   Arena *frameArena;
 
   // Misc
+  u64 frameIndex;
   f32 playerX, playerY;
+  GameSound blip;
+  RenderTexture playerTexture;
 
   // Platform API handles
   PlatformAPI platform;
-
-  // Sokol handles
-  _sg_state_t *sgState;
-  _sgp_context *sgpState;
 };
 
 StaticAssert(sizeof(Game) <= GAME_DATA_SIZE, check_game_struct_size);
@@ -64,38 +59,46 @@ Load(b32 first, PlatformAPI platform, GameMemory memory)
   Assert(memory.mem && GAME_DATA_SIZE < memory.size);
   Game *game = (Game*)memory.mem;
   game->platform = platform;
+  LogSetWriteFunc(platform.LogWrite);
 
   if (first) {
-    platform.DebugPrint(Str8Lit("Game loaded (first time)!\n"));
+    LogInfo("Game loaded (first time)!");
 
     // Memory management
-    u64 arenaSize = memory.size / 2; // TODO: Should we divide this differently?
+    u64 arenaSize = memory.size / 2; // TODO: Should we divide this differently? Build with ARENA_TRACKING and check the report
     void *permArenaMemory = (u8*)memory.mem + GAME_DATA_SIZE;
     void *frameArenaMemory = (u8*)permArenaMemory + arenaSize;
     game->permArena = ArenaAlloc(permArenaMemory, arenaSize);
     game->frameArena = ArenaAlloc(frameArenaMemory, arenaSize);
-
-    game->sgState = ArenaPushN(game->permArena, _sg_state_t, 1);
-    game->sgpState = ArenaPushN(game->permArena, _sgp_context, 1);
-    // Super hacky
-    _sg = game->sgState;
-    _sgp = game->sgpState;
-
-    // Init sokol_gfx
-    sg_desc sgDesc = {0};
-    sgp_desc sgpDesc = {0};
-    sgDesc.logger.func = slog_func;
-    sg_setup(&sgDesc);
-    sgp_setup(&sgpDesc);
-
+    ArenaTrackName(game->permArena, "game perm");
+    ArenaTrackName(game->frameArena, "game frame");
+    ArenaTrackSetOverflowFunc(LogInfoLines);
+
+    // Placeholder sound until we can load real ones: 440Hz square wave fading out over 100ms
+    u64 blipFrames = GAME_AUDIO_SAMPLE_RATE / 10;
+    ArenaTagScope("audio") {
+      game->blip.samples = ArenaPushN(game->permArena, s16, blipFrames);
+    }
+    game->blip.frameCount = blipFrames;
+    game->blip.channelCount = 1;
+    for (u64 i = 0; i < blipFrames; ++i) {
+      s16 amplitude = (s16)(8000 * (blipFrames - i) / blipFrames);
+      game->blip.samples[i] = ((i * 880 / GAME_AUDIO_SAMPLE_RATE) & 1) ? amplitude : -amplitude;
+    }
+
+    // Placeholder sprite until we can load images: 8x8 checkerboard, the GPU copy outlives reloads
+    u32 checker[8 * 8];
+    for (u32 i = 0; i < ArrayCount(checker); ++i) {
+      checker[i] = (((i % 8) + (i / 8)) & 1) ? 0xFFFFFFFF : 0xFFC0C0C0;
+    }
+    game->playerTexture = platform.RenderTextureCreate(8, 8, checker);
   } else {
-    platform.DebugPrint(Str8Lit("Game loaded!\n"));
+    LogInfo("Game loaded!");
 
-    _sg = game->sgState;
-    _sgp = game->sgpState;
-    // Refresh OpenGL context (it wouldn't be game development without crazy hacks)
-    _sg_discard_backend();
-    _sg_setup_backend(&_sg->desc);
+    // The tracker lives in the DLL, so a reload starts it over
+    ArenaTrackName(game->permArena, "game perm");
+    ArenaTrackName(game->frameArena, "game frame");
+    ArenaTrackSetOverflowFunc(LogInfoLines);
   }
 }
 
@@ -104,35 +107,35 @@ Update(GameMemory memory, GameInput input)
 {
   Game *gameState = (Game*)memory.mem;
   GameInputSource *keyboard = &input.sources[0];
+  ArenaClear(gameState->frameArena);
 
   gameState->playerX += PLAYER_SPEED * keyboard->xAxis;
   gameState->playerY += PLAYER_SPEED * keyboard->yAxis;
+
+  for (u32 sourceIdx = 0; sourceIdx < NUM_INPUT_SOURCES; ++sourceIdx) {
+    GameButtonState *primary = &input.sources[sourceIdx].primary;
+    if (primary->isDown && primary->halfTransitionCount) {
+      gameState->platform.AudioPlay(&gameState->blip, 0.5f, false);
+    }
+  }
+
+  // Memory budget report, empty unless built with ARENA_TRACKING
+  gameState->frameIndex++;
+  ArenaTrackFrameEnd();
+  if (gameState->frameIndex % GAME_MEMORY_REPORT_INTERVAL == 0) {
+    String8 report = ArenaTrackReport(gameState->frameArena);
+    if (report.size) {
+      LogInfoLines(report);
+    }
+  }
 }
 
 extern void
-Render(GameMemory memory, u64 frameWidth, u64 frameHeight)
+Render(GameMemory memory, RenderCommands *commands)
 {
   Game *gameState = (Game*)memory.mem;
 
-  // Initialize
-  // TODO: Figure out scaling and stuff
-  sgp_begin(frameWidth, frameHeight);
-  sgp_viewport(0, 0, frameWidth, frameHeight);
-  sgp_project(0, frameWidth, frameHeight, 0);
-
-  // Clear frame buffer
-  sgp_set_color(0.1f, 0.1f, 0.1f, 1.f);
-  sgp_clear();
-
-  // Draw
-  sgp_set_color(1.f, 0.f, 0.f, 1.f);
-  sgp_draw_filled_rect(gameState->playerX, gameState->playerY, 100.f, 100.f);
-
-  // Present
-  sg_pass_action pass = {0};
-  sg_begin_default_pass(&pass, frameWidth, frameHeight);
-  sgp_flush();
-  sgp_end();
-  sg_end_pass();
-  sg_commit();
+  RenderClear(commands, RenderColorRGBA(0.1f, 0.1f, 0.1f, 1.f));
+  RenderSprite(commands, gameState->playerTexture, gameState->playerX + 50.f, gameState->playerY + 50.f, 100.f, 100.f, 0.f,
+               RenderColorRGBA(1.f, 0.f, 0.f, 1.f));
 }
\ No newline at end of file
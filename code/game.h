@@ -12,7 +12,7 @@ struct GameButtonState
 typedef struct GameInputSource GameInputSource;
 struct GameInputSource
 {
-  // b32 isConnected;
+  b32 isConnected;
 
   f32 xAxis, yAxis;
 
@@ -30,11 +30,59 @@ struct GameInputSource
   };
 };
 
-#define NUM_INPUT_SOURCES 1 // 4?
+typedef u32 GameInputEventKind;
+enum
+{
+  GameInputEvent_Button,
+  GameInputEvent_Axis,
+  GameInputEvent_Connection,
+};
+
+typedef u32 GameInputAxis;
+enum
+{
+  GameInputAxis_X,
+  GameInputAxis_Y,
+};
+
+typedef struct GameInputEvent GameInputEvent;
+struct GameInputEvent
+{
+  u64 timestampNs; // Same clock as GameInput.tickStartNs
+  GameInputEventKind kind;
+  u32 source;
+  u32 index; // Button index or GameInputAxis
+
+  union
+  {
+    b32 isDown;
+    b32 isConnected;
+    f32 value;
+  };
+};
+
+#define NUM_INPUT_SOURCES 4
 typedef struct GameInput GameInput;
 struct GameInput
 {
-  GameInputSource sources[NUM_INPUT_SOURCES]; // Treat source 0 as keyboard
+  // Every event that happened during [tickStartNs, tickEndNs), in order. Lives in the platform's frame arena
+  u64 tickStartNs, tickEndNs;
+  GameInputEvent *events;
+  u64 eventCount;
+
+  // State at the end of the tick, derived from the events
+  GameInputSource sources[NUM_INPUT_SOURCES]; // Source 0 is the keyboard, the rest are gamepads
+};
+
+#define GAME_AUDIO_SAMPLE_RATE 48000
+
+typedef struct GameSound GameSound;
+struct GameSound
+{
+  // Interleaved samples at GAME_AUDIO_SAMPLE_RATE, must stay alive while a voice plays it (i.e. live in GameMemory)
+  s16 *samples;
+  u64 frameCount;
+  u32 channelCount; // 1 or 2
 };
 
 typedef struct GameMemory GameMemory;
@@ -50,6 +98,12 @@ struct GameMemory
 // Platform
 #define PLATFORM_VTABLE \
   X(void, DebugPrint, String8) \
+  X(void, LogWrite, LogSite *, char *, ...) \
+  X(u64, AudioPlay, GameSound *, f32, b32) \
+  X(u64, AudioPlayStream, String8, f32, b32) \
+  X(void, AudioStop, u64) \
+  X(void, AudioSetVolume, u64, f32) \
+  X(RenderTexture, RenderTextureCreate, u32, u32, void *) \
 
 #define X(ret, name, ...) typedef ret Platform##name##Func(__VA_ARGS__);
 PLATFORM_VTABLE
@@ -67,7 +121,7 @@ struct PlatformAPI
 #define GAME_VTABLE \
   X(void, Load, b32, PlatformAPI, GameMemory) \
   X(void, Update, GameMemory, GameInput) \
-  X(void, Render, GameMemory, u64, u64) \
+  X(void, Render, GameMemory, RenderCommands *) \
 
 #define X(ret, name, ...) typedef ret Game##name##Func(__VA_ARGS__);
 GAME_VTABLE
@@ -0,0 +1,526 @@
+global Logger *g_currentLogger;
+global volatile u64 g_logGeneration;
+thread_storage LogRing *t_logRing;
+thread_storage u64 t_logRingGeneration;
+
+read_only char *g_logLevelNames[LogLevel_Count] = {"debug", "info", "warning", "error"};
+
+// Format registration
+
+function b32
+LogIsFlagChar(u8 c)
+{
+  return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0' || c == '\'' || c == '_';
+}
+
+function b32
+LogIsDigit(u8 c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// Splits fmt into segments that each end in one conversion, so the logger thread can
+// format them one argument at a time without rebuilding a va_list
+function void
+LogParseFormat(Arena *arena, String8 fmt, LogFormat *format)
+{
+  u64 segmentStart = 0;
+  u64 escapeStart = fmt.size; // Where the format stopped making sense
+  u64 pos = 0;
+  while (pos < escapeStart && format->segmentCount < LOG_MAX_SEGMENTS) {
+    if (fmt.str[pos] != '%') {
+      pos += 1;
+    } else if (pos + 1 < fmt.size && fmt.str[pos + 1] == '%') {
+      pos += 2;
+    } else {
+      u64 conversionStart = pos;
+      LogSegment segment = {0};
+      segment.precision = -1;
+      pos += 1;
+
+      while (pos < fmt.size && LogIsFlagChar(fmt.str[pos])) {
+        pos += 1;
+      }
+      if (pos < fmt.size && fmt.str[pos] == '*') {
+        segment.starCount++;
+        pos += 1;
+      }
+      while (pos < fmt.size && LogIsDigit(fmt.str[pos])) {
+        pos += 1;
+      }
+      if (pos < fmt.size && fmt.str[pos] == '.') {
+        pos += 1;
+        if (pos < fmt.size && fmt.str[pos] == '*') {
+          segment.starCount++;
+          segment.hasStarPrecision = true;
+          pos += 1;
+        } else {
+          segment.precision = 0;
+          while (pos < fmt.size && LogIsDigit(fmt.str[pos])) {
+            segment.precision = segment.precision * 10 + (fmt.str[pos] - '0');
+            pos += 1;
+          }
+        }
+      }
+
+      // Length modifiers, only the argument size matters to us
+      u32 longCount = 0;
+      b32 isWide = false;
+      while (pos < fmt.size) {
+        u8 c = fmt.str[pos];
+        if (c == 'l') {
+          longCount++;
+        } else if (c == 'j' || c == 'z' || c == 't') {
+          isWide = true;
+        } else if (c == 'I') {
+          // MSVC style I64/I32/I
+          isWide = !(pos + 2 < fmt.size && fmt.str[pos + 1] == '3' && fmt.str[pos + 2] == '2');
+          if (pos + 2 < fmt.size && LogIsDigit(fmt.str[pos + 1])) {
+            pos += 2;
+          }
+        } else if (c != 'h' && c != 'L') {
+          break;
+        }
+        pos += 1;
+      }
+      isWide = isWide || longCount >= 2 || (longCount == 1 && sizeof(long) == 8);
+
+      b32 isKnown = (pos < fmt.size);
+      if (isKnown) {
+        switch (fmt.str[pos]) {
+          case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'b': case 'B': case 'c': {
+            segment.kind = isWide ? LogArg_S64 : LogArg_Int;
+          } break;
+          case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            segment.kind = LogArg_F64;
+          } break;
+          case 'p': {
+            segment.kind = LogArg_Ptr;
+          } break;
+          case 's': {
+            segment.kind = LogArg_Str;
+          } break;
+          default: {
+            isKnown = false;
+          } break;
+        }
+        pos += 1;
+      }
+
+      if (isKnown) {
+        segment.fmt = (char*)PushStr8Copy(arena, Substr8Opl(fmt, segmentStart, pos)).str;
+        format->segments[format->segmentCount++] = segment;
+        segmentStart = pos;
+      } else {
+        // Without knowing the argument's size none of the arguments after it can be read
+        escapeStart = conversionStart;
+      }
+    }
+  }
+
+  // Trailing literal, dropped if the format was cut before its last conversion. From a bad
+  // conversion on the format is printed as it is, so the mistake shows in the log
+  String8 rest = Substr8Opl(fmt, segmentStart, escapeStart);
+  if (Str8Find(rest, Str8Lit("%"), 0, 0) < rest.size && format->segmentCount == LOG_MAX_SEGMENTS) {
+    rest.size = 0;
+  }
+  Str8Builder builder = Str8BuilderBegin(arena);
+  Str8BuilderAppend(&builder, rest);
+  for (String8 escaped = Str8Skip(fmt, escapeStart); escaped.size;) {
+    u64 percentPos = Str8Find(escaped, Str8Lit("%"), 0, 0);
+    Str8BuilderAppend(&builder, Prefix8(escaped, percentPos));
+    if (percentPos < escaped.size) {
+      Str8BuilderAppend(&builder, Str8Lit("%%"));
+    }
+    escaped = Str8Skip(escaped, percentPos + 1);
+  }
+  LogSegment *last = &format->segments[format->segmentCount++];
+  last->fmt = (char*)Str8BuilderEnd(&builder).str;
+  last->kind = LogArg_None;
+  last->precision = -1;
+}
+
+function u64
+LogRegisterFormat(Logger *logger, LogSite *site, char *fmt)
+{
+  u64 result = 0;
+  String8 fmtString = Str8C(fmt);
+  String8 fileString = Str8C(site->file);
+  u64 key = HashMix(HashBytes(fmtString.str, fmtString.size, HashStr8(fileString)), site->line);
+
+  while (!AtomicCompareExchangeU64(&logger->formatLock, 0, 1)) {
+    OSCPUPause();
+  }
+
+  // Seen before when the site's own id was reset, e.g. by reloading the game DLL
+  u64 *id = HashMapLookupT(logger->formatIds, u64, key);
+  if (id) {
+    result = *id;
+  } else if (logger->formatCount < LOG_MAX_FORMATS) {
+    result = logger->formatCount++;
+    LogFormat *format = &logger->formats[result];
+    format->level = Min(site->level, LogLevel_Count - 1);
+    LogParseFormat(logger->arena, fmtString, format);
+    u64 *slot = HashMapInsertT(logger->formatIds, u64, key);
+    if (slot) {
+      *slot = result;
+    }
+  } else {
+    // The site keeps this, so a full table isn't searched again on every message
+    result = LOG_FORMAT_NONE;
+  }
+
+  AtomicStoreU64(&logger->formatLock, 0);
+  return result;
+}
+
+// Calling thread
+
+function u64
+LogEncodeArgs(LogFormat *format, u8 *record, u64 size, va_list args)
+{
+  for (u32 segmentIdx = 0; segmentIdx < format->segmentCount; ++segmentIdx) {
+    LogSegment *segment = &format->segments[segmentIdx];
+
+    s32 precision = segment->precision;
+    for (u32 starIdx = 0; starIdx < segment->starCount; ++starIdx) {
+      s32 value = va_arg(args, int);
+      MemoryCopy(record + size, &value, sizeof(value));
+      size += sizeof(value);
+      precision = segment->hasStarPrecision ? value : precision;
+    }
+
+    switch (segment->kind) {
+      case LogArg_Int: {
+        s32 value = va_arg(args, int);
+        MemoryCopy(record + size, &value, sizeof(value));
+        size += sizeof(value);
+      } break;
+
+      case LogArg_S64: {
+        s64 value = va_arg(args, s64);
+        MemoryCopy(record + size, &value, sizeof(value));
+        size += sizeof(value);
+      } break;
+
+      case LogArg_F64: {
+        f64 value = va_arg(args, f64);
+        MemoryCopy(record + size, &value, sizeof(value));
+        size += sizeof(value);
+      } break;
+
+      case LogArg_Ptr: {
+        u64 value = IntFromPtr(va_arg(args, void*));
+        MemoryCopy(record + size, &value, sizeof(value));
+        size += sizeof(value);
+      } break;
+
+      case LogArg_Str: {
+        char *str = va_arg(args, char*);
+        str = str ? str : "(null)";
+
+        // Leave room for the worst case of every segment after this one
+        u64 reserved = (format->segmentCount - segmentIdx) * 16;
+        u32 maxLength = (u32)(LOG_MAX_RECORD_SIZE - size - reserved);
+        if (precision >= 0) {
+          maxLength = Min(maxLength, (u32)precision);
+        }
+        u32 length = 0;
+        for (; length < maxLength && str[length]; ++length);
+
+        MemoryCopy(record + size, &length, sizeof(length));
+        MemoryCopy(record + size + sizeof(length), str, length);
+        record[size + sizeof(length) + length] = 0;
+        size += sizeof(length) + length + 1;
+      } break;
+    }
+  }
+
+  return size;
+}
+
+function LogRing*
+LogGetThreadRing(Logger *logger)
+{
+  // A ring from an earlier LoggerStart is gone, even when the logger struct is the same one
+  if (t_logRingGeneration != logger->generation) {
+    u64 ringIdx = AtomicAddU64(&logger->ringCount, 1) - 1;
+    t_logRing = (ringIdx < LOG_MAX_THREADS) ? &logger->rings[ringIdx] : 0;
+    t_logRingGeneration = logger->generation;
+  }
+
+  return t_logRing;
+}
+
+function void
+LogWrite(LogSite *site, char *fmt, ...)
+{
+  Logger *logger = g_currentLogger;
+  if (logger) {
+    u64 timestampNs = OSNowNs();
+
+    // Ids from an earlier LoggerStart index some other table, so the site registers again
+    u64 siteId = AtomicLoadU64(&site->formatId);
+    if ((u32)(siteId >> 32) != (u32)logger->generation) {
+      siteId = ((u64)logger->generation << 32) | LogRegisterFormat(logger, site, fmt);
+      AtomicStoreU64(&site->formatId, siteId);
+    }
+    u64 formatId = (u32)siteId;
+
+    LogRing *ring = LogGetThreadRing(logger);
+    if (!ring || formatId == LOG_FORMAT_NONE) {
+      AtomicAddU64(&logger->droppedNoSlot, 1);
+    } else {
+      u64 recordStorage[LOG_MAX_RECORD_SIZE / sizeof(u64)];
+      u8 *record = (u8*)recordStorage;
+      va_list args;
+      va_start(args, fmt);
+      u64 size = LogEncodeArgs(&logger->formats[formatId], record, sizeof(LogRecordHeader), args);
+      va_end(args);
+      size = AlignUpPow2(size, LOG_RECORD_ALIGN);
+
+      LogRecordHeader *header = (LogRecordHeader*)record;
+      header->formatId = (u32)formatId;
+      header->size = (u32)size;
+      header->timestampNs = timestampNs;
+
+      // Records never wrap, pad to the end of the ring when this one doesn't fit there
+      u64 writePos = ring->writePos;
+      u64 offset = writePos & (LOG_RING_SIZE - 1);
+      u64 padding = (LOG_RING_SIZE - offset < size) ? LOG_RING_SIZE - offset : 0;
+      if (writePos + padding + size - AtomicLoadU64(&ring->readPos) <= LOG_RING_SIZE) {
+        if (padding) {
+          LogRecordHeader *pad = (LogRecordHeader*)(ring->data + offset);
+          pad->formatId = 0;
+          pad->size = (u32)padding;
+          writePos += padding;
+          offset = 0;
+        }
+        MemoryCopy(ring->data + offset, record, size);
+        AtomicStoreU64(&ring->writePos, writePos + size);
+      } else {
+        AtomicStoreU64(&ring->dropped, ring->dropped + 1);
+      }
+    }
+  }
+}
+
+// Logger thread
+
+function void
+LogFlush(Logger *logger)
+{
+  if (logger->outputSize) {
+    if (logger->file.handle) {
+      logger->fileOffset += OSFileWrite(logger->file, logger->fileOffset, logger->output, logger->outputSize);
+    }
+    if (logger->consoleSink) {
+      logger->output[logger->outputSize] = 0;
+      logger->consoleSink(Str8(logger->output, logger->outputSize));
+    }
+    logger->outputSize = 0;
+  }
+}
+
+function void
+LogPrint(Logger *logger, char *fmt, ...)
+{
+  if (LOG_OUTPUT_SIZE - logger->outputSize < LOG_MAX_LINE_SIZE) {
+    LogFlush(logger);
+  }
+
+  va_list args;
+  va_start(args, fmt);
+  u64 left = LOG_OUTPUT_SIZE - logger->outputSize;
+  int written = stbsp_vsnprintf((char*)logger->output + logger->outputSize, (int)left, fmt, args);
+  va_end(args);
+  logger->outputSize += Min((u64)Max(written, 0), left - 1);
+}
+
+#define LogFormatSegment(value) \
+  (segment->starCount == 0 ? stbsp_snprintf(at, left, segment->fmt, value) : \
+   segment->starCount == 1 ? stbsp_snprintf(at, left, segment->fmt, stars[0], value) : \
+                             stbsp_snprintf(at, left, segment->fmt, stars[0], stars[1], value))
+
+function void
+LogFormatRecord(Logger *logger, LogRecordHeader *header)
+{
+  if (LOG_OUTPUT_SIZE - logger->outputSize < LOG_MAX_LINE_SIZE) {
+    LogFlush(logger);
+  }
+  char *lineEnd = (char*)logger->output + logger->outputSize + LOG_MAX_LINE_SIZE - 1; // Room for the newline
+
+  LogFormat *format = &logger->formats[header->formatId];
+  f64 seconds = (f64)(header->timestampNs - Min(header->timestampNs, logger->startNs)) / (f64)OS_NS_PER_SEC;
+  LogPrint(logger, "[%10.6f] %-7s ", seconds, g_logLevelNames[format->level]);
+
+  u8 *arg = (u8*)(header + 1);
+  for (u32 segmentIdx = 0; segmentIdx < format->segmentCount; ++segmentIdx) {
+    LogSegment *segment = &format->segments[segmentIdx];
+    char *at = (char*)logger->output + logger->outputSize;
+    int left = (int)(lineEnd - at);
+
+    s32 stars[2] = {0};
+    for (u32 starIdx = 0; starIdx < segment->starCount; ++starIdx) {
+      MemoryCopy(&stars[starIdx], arg, sizeof(s32));
+      arg += sizeof(s32);
+    }
+
+    int written = 0;
+    switch (segment->kind) {
+      case LogArg_None: {
+        written = stbsp_snprintf(at, left, segment->fmt);
+      } break;
+
+      case LogArg_Int: {
+        s32 value;
+        MemoryCopy(&value, arg, sizeof(value));
+        arg += sizeof(value);
+        written = LogFormatSegment(value);
+      } break;
+
+      case LogArg_S64: {
+        s64 value;
+        MemoryCopy(&value, arg, sizeof(value));
+        arg += sizeof(value);
+        written = LogFormatSegment(value);
+      } break;
+
+      case LogArg_F64: {
+        f64 value;
+        MemoryCopy(&value, arg, sizeof(value));
+        arg += sizeof(value);
+        written = LogFormatSegment(value);
+      } break;
+
+      case LogArg_Ptr: {
+        u64 value;
+        MemoryCopy(&value, arg, sizeof(value));
+        arg += sizeof(value);
+        written = LogFormatSegment((void*)value);
+      } break;
+
+      case LogArg_Str: {
+        u32 length;
+        MemoryCopy(&length, arg, sizeof(length));
+        char *value = (char*)arg + sizeof(length);
+        arg += sizeof(length) + length + 1;
+        written = LogFormatSegment(value);
+      } break;
+    }
+    logger->outputSize += Min(Max(written, 0), Max(left - 1, 0));
+  }
+
+  logger->output[logger->outputSize++] = '\n';
+}
+
+// Skips padding, returns the next record or 0 if the ring is empty
+function LogRecordHeader*
+LogPeekRecord(LogRing *ring)
+{
+  LogRecordHeader *result = 0;
+  u64 writePos = AtomicLoadU64(&ring->writePos);
+  for (u64 readPos = ring->readPos; readPos < writePos && !result;) {
+    LogRecordHeader *header = (LogRecordHeader*)(ring->data + (readPos & (LOG_RING_SIZE - 1)));
+    if (header->formatId) {
+      result = header;
+    } else {
+      readPos += header->size;
+      AtomicStoreU64(&ring->readPos, readPos);
+    }
+  }
+
+  return result;
+}
+
+function void
+LogDrain(Logger *logger)
+{
+  u64 ringCount = Min(AtomicLoadU64(&logger->ringCount), LOG_MAX_THREADS);
+  for (;;) {
+    // Oldest record across all threads first
+    LogRing *oldestRing = 0;
+    LogRecordHeader *oldest = 0;
+    for (u64 ringIdx = 0; ringIdx < ringCount; ++ringIdx) {
+      LogRecordHeader *header = LogPeekRecord(&logger->rings[ringIdx]);
+      if (header && (!oldest || header->timestampNs < oldest->timestampNs)) {
+        oldest = header;
+        oldestRing = &logger->rings[ringIdx];
+      }
+    }
+    if (!oldest) {
+      break;
+    }
+
+    LogFormatRecord(logger, oldest);
+    AtomicStoreU64(&oldestRing->readPos, oldestRing->readPos + oldest->size);
+  }
+
+  u64 dropped = AtomicLoadU64(&logger->droppedNoSlot);
+  for (u64 ringIdx = 0; ringIdx < ringCount; ++ringIdx) {
+    dropped += AtomicLoadU64(&logger->rings[ringIdx].dropped);
+  }
+  if (dropped != logger->reportedDrops) {
+    LogPrint(logger, "[log] dropped %llu messages\n", dropped - logger->reportedDrops);
+    logger->reportedDrops = dropped;
+  }
+
+  LogFlush(logger);
+}
+
+function void
+LoggerThreadProc(void *param)
+{
+  Logger *logger = (Logger*)param;
+  while (AtomicLoadU64(&logger->running)) {
+    LogDrain(logger);
+    OSSleepUntilNs(OSNowNs() + LOG_POLL_NS);
+  }
+  LogDrain(logger);
+}
+
+// Setup
+
+function void
+LoggerStart(Logger *logger, String8 path, LogSinkFunc *consoleSink)
+{
+  MemoryZeroStruct(logger);
+  logger->generation = AtomicAddU64(&g_logGeneration, 1);
+  logger->memory = OSMemReserve(LOG_ARENA_SIZE);
+  OSMemCommit(logger->memory, LOG_ARENA_SIZE);
+  Arena *arena = ArenaAlloc(logger->memory, LOG_ARENA_SIZE);
+  logger->arena = arena;
+  logger->formatIds = HashMapAllocT(arena, u64, LOG_MAX_FORMATS);
+  logger->formats = ArenaPushN(arena, LogFormat, LOG_MAX_FORMATS);
+  logger->formatCount = 1;
+  for (u32 ringIdx = 0; ringIdx < LOG_MAX_THREADS; ++ringIdx) {
+    logger->rings[ringIdx].data = ArenaPush(arena, LOG_RING_SIZE, CACHE_LINE_SIZE);
+  }
+
+  if (path.size) {
+    logger->file = OSFileOpenWrite(path);
+  }
+  logger->consoleSink = consoleSink;
+  logger->startNs = OSNowNs();
+  logger->output = ArenaPushN(arena, u8, LOG_OUTPUT_SIZE + 1);
+
+  g_currentLogger = logger;
+  LogSetWriteFunc(LogWrite);
+  logger->running = 1;
+  logger->thread = OSThreadLaunch(LoggerThreadProc, logger);
+}
+
+function void
+LoggerStop(Logger *logger)
+{
+  if (g_currentLogger == logger) {
+    LogSetWriteFunc(0);
+    g_currentLogger = 0;
+  }
+  AtomicStoreU64(&logger->running, 0);
+  OSThreadJoin(logger->thread);
+  OSFileClose(logger->file);
+  OSMemRelease(logger->memory, LOG_ARENA_SIZE);
+  logger->memory = 0;
+  logger->arena = 0;
+}
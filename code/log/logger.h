@@ -0,0 +1,119 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+/*
+  Deferred formatting logger behind LogWrite (base/log.h). A callsite's first message parses
+  its format into one segment per conversion, after that a message is just the format id,
+  a timestamp and the raw arguments (strings copied) pushed into the calling thread's
+  lock-free ring. The logger thread merges the rings by timestamp, formats each segment
+  with stb_sprintf and writes the text to the log file and the console sink.
+  A full ring drops the message and counts it, callers never block.
+*/
+
+#define LOG_MAX_THREADS     16
+#define LOG_MAX_FORMATS     1024
+#define LOG_MAX_SEGMENTS    16 // Conversions per format, the rest of a longer format is cut
+#define LOG_RING_SIZE       Kilobytes(64) // Per thread, power of 2
+#define LOG_MAX_RECORD_SIZE 512 // Long string arguments get truncated to fit
+#define LOG_RECORD_ALIGN    16
+#define LOG_OUTPUT_SIZE     Kilobytes(64)
+#define LOG_MAX_LINE_SIZE   Kilobytes(2)
+#define LOG_POLL_NS         (2 * OS_NS_PER_MS)
+#define LOG_ARENA_SIZE      Megabytes(4) // Rings, format table and output, power of 2
+#define LOG_FORMAT_NONE     0xFFFFFFFF // Site id once the format table is full, its messages are dropped
+
+typedef u8 LogArgKind;
+enum
+{
+  LogArg_None, // Literal text only
+  LogArg_Int,
+  LogArg_S64,
+  LogArg_F64,
+  LogArg_Ptr,
+  LogArg_Str,  // Stored as u32 length, bytes and a terminator
+};
+
+typedef struct LogSegment LogSegment;
+struct LogSegment
+{
+  char *fmt;       // Literal text followed by at most one conversion
+  LogArgKind kind;
+  u8 starCount;    // Width/precision given as int arguments
+  b8 hasStarPrecision;
+  s32 precision;   // Literal precision, -1 if none
+};
+
+typedef struct LogFormat LogFormat;
+struct LogFormat
+{
+  LogLevel level;
+  u32 segmentCount;
+  LogSegment segments[LOG_MAX_SEGMENTS + 1]; // Plus the trailing literal
+};
+
+typedef struct LogRecordHeader LogRecordHeader;
+struct LogRecordHeader
+{
+  u32 formatId; // 0 pads to the end of the ring
+  u32 size;     // Including the header, multiple of LOG_RECORD_ALIGN
+  u64 timestampNs;
+};
+
+typedef struct LogRing LogRing;
+struct LogRing
+{
+  u8 *data;
+
+  // Calling thread
+  u8 pad0[CACHE_LINE_SIZE];
+  volatile u64 writePos;
+  volatile u64 dropped;
+
+  // Logger thread
+  u8 pad1[CACHE_LINE_SIZE];
+  volatile u64 readPos;
+  u8 pad2[CACHE_LINE_SIZE];
+};
+
+typedef void LogSinkFunc(String8 text);
+
+typedef struct Logger Logger;
+struct Logger
+{
+  LogRing rings[LOG_MAX_THREADS];
+  volatile u64 ringCount; // May run past LOG_MAX_THREADS, later threads don't get to log
+  volatile u64 droppedNoSlot; // From threads without a ring and sites without a format
+  u64 generation; // Per LoggerStart, a thread's cached ring and a site's id are only good for the same one
+
+  // Own memory, formats get registered from whichever thread logs first
+  void *memory;
+  Arena *arena;
+
+  // Formats are only registered once per callsite, so a spin lock is plenty
+  volatile u64 formatLock;
+  HashMap *formatIds; // Hash of format, file and line -> id
+  LogFormat *formats; // Indexed by id, 0 is unused
+  u64 formatCount;
+
+  // Logger thread
+  OSFile file;
+  u64 fileOffset;
+  LogSinkFunc *consoleSink;
+  u64 startNs;
+  u64 reportedDrops;
+  u8 *output;
+  u64 outputSize;
+  volatile u64 running;
+  OSThread thread;
+};
+
+// Path and sink are optional
+function void LoggerStart(Logger *logger, String8 path, LogSinkFunc *consoleSink);
+// Writes out whatever is still queued and releases the logger's memory. Logging after this
+// is a no-op, the other threads have to be done with it before
+function void LoggerStop(Logger *logger);
+
+// Any thread, LogWriteFunc for the logger LoggerStart was last called with
+function void LogWrite(LogSite *site, char *fmt, ...);
+
+#endif // LOGGER_H
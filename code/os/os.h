@@ -0,0 +1,173 @@
+#ifndef OS_H
+#define OS_H
+
+/*
+  Thin layer over the host OS so the platform layers don't have to
+  re-implement memory, file and timing helpers.
+*/
+
+// Setup
+
+function void OSInit(void);
+
+// Memory
+
+function void* OSMemReserve(u64 size);
+function b32   OSMemCommit(void *ptr, u64 size); // False when the OS is out of memory to commit
+function void  OSMemDecommit(void *ptr, u64 size);
+function void  OSMemRelease(void *ptr, u64 size);
+// Reserves and commits on 2MB pages when the OS lets us, regular pages otherwise.
+// *pageSize says what we got, release with OSMemReleaseLarge and the same size
+function void* OSMemAllocLarge(u64 size, u64 *pageSize);
+function void  OSMemReleaseLarge(void *ptr, u64 size);
+
+// Files
+
+function u64 OSGetLastWriteTime(String8 path);
+function b32 OSCopyFile(String8 src, String8 dest);
+
+typedef struct OSFile OSFile;
+struct OSFile
+{
+  u64 handle; // 0 when invalid
+};
+
+// Paths must be null terminated
+function OSFile OSFileOpen(String8 path);      // Read only
+function OSFile OSFileOpenWrite(String8 path); // Write only, creates or truncates
+function void   OSFileClose(OSFile file);
+function u64    OSFileSize(OSFile file);
+function u64    OSFileRead(OSFile file, u64 offset, void *buffer, u64 size);  // Returns bytes read
+function u64    OSFileWrite(OSFile file, u64 offset, void *buffer, u64 size); // Returns bytes written
+
+// Time
+
+#define OS_NS_PER_SEC 1000000000ull
+#define OS_NS_PER_MS  1000000ull
+#define OS_NS_PER_US  1000ull
+
+function u64  OSNowNs(void);
+function void OSSleepUntilNs(u64 deadlineNs); // May wake late by the scheduler granularity, never early
+
+// Threads
+
+#define OS_MAX_THREADS 64
+
+typedef void OSThreadFunc(void *param);
+
+typedef struct OSThread OSThread;
+struct OSThread
+{
+  u64 handle;
+};
+
+function OSThread OSThreadLaunch(OSThreadFunc *func, void *param);
+function void     OSThreadJoin(OSThread thread);
+function u32      OSProcessorCount(void); // Logical processors
+
+#define OS_MAX_SEMAPHORES 64
+
+typedef struct OSSemaphore OSSemaphore;
+struct OSSemaphore
+{
+  u64 handle; // 0 when invalid
+};
+
+// Semaphores are few and live as long as the process, like threads
+function OSSemaphore OSSemaphoreAlloc(u32 initialCount);
+function void        OSSemaphoreSignal(OSSemaphore semaphore, u32 count);
+function void        OSSemaphoreWait(OSSemaphore semaphore);
+
+// Fork-join pool: OSJobPoolRun calls func once for every job index, on the calling thread
+// and the workers, and returns once all of them finished. For short bursts of data
+// parallel work, like the passes of a sort, so finished jobs are spun on, not waited on.
+
+#define OS_JOB_MAX_WORKERS 15
+
+typedef void OSJobFunc(void *param, u32 jobIdx, u32 jobCount);
+
+typedef struct OSJobPool OSJobPool;
+struct OSJobPool
+{
+  OSSemaphore wake;
+  OSThread workers[OS_JOB_MAX_WORKERS];
+  u32 workerCount;
+
+  OSJobFunc *func;
+  void *param;
+  volatile u64 nextJob;
+  volatile u64 pendingJobs;
+  volatile u64 running;
+};
+
+function void OSJobPoolStart(OSJobPool *pool, u32 workerCount); // Clamped to OS_JOB_MAX_WORKERS, may end up 0
+function void OSJobPoolStop(OSJobPool *pool);
+function u32  OSJobPoolJobCount(OSJobPool *pool); // Workers plus the caller
+function void OSJobPoolRun(OSJobPool *pool, OSJobFunc *func, void *param);
+
+// Gamepads
+
+#define OS_MAX_GAMEPADS 3
+
+typedef u32 OSGamepadButtons;
+enum
+{
+  OSGamepadButton_South     = (1 << 0), // A on Xbox pads
+  OSGamepadButton_East      = (1 << 1),
+  OSGamepadButton_West      = (1 << 2),
+  OSGamepadButton_North     = (1 << 3),
+  OSGamepadButton_DPadUp    = (1 << 4),
+  OSGamepadButton_DPadDown  = (1 << 5),
+  OSGamepadButton_DPadLeft  = (1 << 6),
+  OSGamepadButton_DPadRight = (1 << 7),
+  OSGamepadButton_Start     = (1 << 8),
+  OSGamepadButton_Back      = (1 << 9),
+};
+
+typedef struct OSGamepadState OSGamepadState;
+struct OSGamepadState
+{
+  b32 isConnected;
+  OSGamepadButtons buttons;
+  f32 stickX, stickY; // Left stick in [-1, 1], +y is up, no deadzone applied
+};
+
+// Not thread safe, call from a single (input) thread
+function void OSGamepadPoll(OSGamepadState *pads, u32 count);
+
+// Frame pacing
+
+#define OS_FRAME_HISTORY 128 // Power of 2
+
+typedef struct OSFrameStats OSFrameStats;
+struct OSFrameStats
+{
+  u64 count;
+  f32 targetMs;
+  f32 meanMs;
+  f32 minMs;
+  f32 maxMs;
+  f32 jitterMs; // Standard deviation of present-to-present intervals
+  u64 missed;   // Intervals longer than 1.5x the target
+};
+
+typedef struct OSFramePacer OSFramePacer;
+struct OSFramePacer
+{
+  u64 targetNs;
+  u64 deadlineNs;
+  u64 spinNs; // Tail of the wait that is spun instead of slept, adapts to sleep overshoot
+
+  u64 lastPresentNs;
+  u64 waitNs; // Spent in OSFramePacerWait since the last present
+  u64 workNs; // Last present interval minus the wait, what the frame cost including the swap
+  u64 intervals[OS_FRAME_HISTORY];
+  u64 intervalCount;
+};
+
+function void         OSFramePacerInit(OSFramePacer *pacer, u32 refreshRate);
+function void         OSFramePacerWait(OSFramePacer *pacer);
+function void         OSFramePacerMarkPresent(OSFramePacer *pacer);
+function OSFrameStats OSFramePacerStats(OSFramePacer *pacer);
+
+#endif // OS_H
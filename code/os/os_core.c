@@ -0,0 +1,220 @@
+// Platform agnostic helpers built on top of the OS primitives
+
+#include <math.h>
+
+#if ARCH_X64
+# include <immintrin.h>
+# define OSCPUPause() _mm_pause()
+#else
+# define OSCPUPause()
+#endif
+
+// Threads
+
+typedef struct OSThreadEntry OSThreadEntry;
+struct OSThreadEntry
+{
+  OSThreadFunc *func;
+  void *param;
+};
+
+global OSThreadEntry g_osThreadEntries[OS_MAX_THREADS];
+global u64 g_osThreadEntryCount;
+
+// Trampoline data for the OS specific thread proc, threads are few and never freed
+function OSThreadEntry*
+OSThreadEntryAlloc(OSThreadFunc *func, void *param)
+{
+  OSThreadEntry *result = 0;
+  u64 idx = AtomicAddU64(&g_osThreadEntryCount, 1) - 1;
+  if (idx < OS_MAX_THREADS) {
+    result = &g_osThreadEntries[idx];
+    result->func = func;
+    result->param = param;
+  }
+
+  return result;
+}
+
+// Job pool
+
+function void
+OSJobPoolRunJobs(OSJobPool *pool)
+{
+  // A worker woken twice before another wakes at all just runs two jobs
+  u32 jobCount = OSJobPoolJobCount(pool);
+  u64 jobIdx = AtomicAddU64(&pool->nextJob, 1) - 1;
+  if (jobIdx < jobCount) {
+    pool->func(pool->param, (u32)jobIdx, jobCount);
+    AtomicAddU64(&pool->pendingJobs, (u64)-1);
+  }
+}
+
+function void
+OSJobPoolWorker(void *param)
+{
+  OSJobPool *pool = (OSJobPool*)param;
+  for (;;) {
+    OSSemaphoreWait(pool->wake);
+    if (!AtomicLoadU64(&pool->running)) {
+      break;
+    }
+    OSJobPoolRunJobs(pool);
+  }
+}
+
+function void
+OSJobPoolStart(OSJobPool *pool, u32 workerCount)
+{
+  MemoryZeroStruct(pool);
+  pool->wake = OSSemaphoreAlloc(0);
+  pool->running = 1;
+  if (pool->wake.handle) {
+    workerCount = Min(workerCount, OS_JOB_MAX_WORKERS);
+    for (u32 i = 0; i < workerCount; ++i) {
+      OSThread worker = OSThreadLaunch(OSJobPoolWorker, pool);
+      if (!worker.handle) {
+        break;
+      }
+      pool->workers[pool->workerCount++] = worker;
+    }
+  }
+}
+
+function void
+OSJobPoolStop(OSJobPool *pool)
+{
+  AtomicStoreU64(&pool->running, 0);
+  OSSemaphoreSignal(pool->wake, pool->workerCount);
+  for (u32 i = 0; i < pool->workerCount; ++i) {
+    OSThreadJoin(pool->workers[i]);
+  }
+  pool->workerCount = 0;
+}
+
+function u32
+OSJobPoolJobCount(OSJobPool *pool)
+{
+  u32 result = pool->workerCount + 1;
+  return result;
+}
+
+function void
+OSJobPoolRun(OSJobPool *pool, OSJobFunc *func, void *param)
+{
+  pool->func = func;
+  pool->param = param;
+  AtomicStoreU64(&pool->pendingJobs, OSJobPoolJobCount(pool));
+  AtomicStoreU64(&pool->nextJob, 0);
+  OSSemaphoreSignal(pool->wake, pool->workerCount);
+
+  // The caller takes jobs too, then waits out the ones still running elsewhere
+  OSJobPoolRunJobs(pool);
+  while (AtomicLoadU64(&pool->pendingJobs)) {
+    OSJobPoolRunJobs(pool);
+    OSCPUPause();
+  }
+}
+
+// Frame pacing
+
+#define OS_FRAME_SPIN_MIN_NS    (200 * OS_NS_PER_US)
+#define OS_FRAME_SPIN_MAX_NS    (4 * OS_NS_PER_MS)
+#define OS_FRAME_SPIN_MARGIN_NS (100 * OS_NS_PER_US)
+
+function void
+OSFramePacerInit(OSFramePacer *pacer, u32 refreshRate)
+{
+  MemoryZeroStruct(pacer);
+  pacer->targetNs = OS_NS_PER_SEC / Max(refreshRate, 1);
+  pacer->spinNs = OS_FRAME_SPIN_MAX_NS / 2;
+  pacer->deadlineNs = OSNowNs() + pacer->targetNs;
+}
+
+function void
+OSFramePacerWait(OSFramePacer *pacer)
+{
+  u64 now = OSNowNs();
+  u64 startNs = now;
+
+  // Sleep through the bulk of the wait
+  if (now + pacer->spinNs < pacer->deadlineNs) {
+    u64 wakeNs = pacer->deadlineNs - pacer->spinNs;
+    OSSleepUntilNs(wakeNs);
+    now = OSNowNs();
+
+    // Widen the spin window as soon as the scheduler wakes us late, narrow it slowly
+    u64 wantedNs = (now - Min(now, wakeNs)) + OS_FRAME_SPIN_MARGIN_NS;
+    if (wantedNs > pacer->spinNs) {
+      pacer->spinNs = wantedNs;
+    } else {
+      pacer->spinNs -= (pacer->spinNs - wantedNs) / 16;
+    }
+    pacer->spinNs = Clamp(pacer->spinNs, OS_FRAME_SPIN_MIN_NS, OS_FRAME_SPIN_MAX_NS);
+  }
+
+  // Spin the tail
+  for (; now < pacer->deadlineNs; now = OSNowNs()) {
+    OSCPUPause();
+  }
+
+  pacer->waitNs += now - startNs;
+
+  // Keep the phase when we're a little late, resync if we dropped a whole frame
+  pacer->deadlineNs += pacer->targetNs;
+  if (pacer->deadlineNs <= now) {
+    pacer->deadlineNs = now + pacer->targetNs;
+  }
+}
+
+function void
+OSFramePacerMarkPresent(OSFramePacer *pacer)
+{
+  u64 now = OSNowNs();
+  if (pacer->lastPresentNs) {
+    u64 intervalNs = now - pacer->lastPresentNs;
+    pacer->intervals[pacer->intervalCount % OS_FRAME_HISTORY] = intervalNs;
+    pacer->intervalCount++;
+    pacer->workNs = intervalNs - Min(pacer->waitNs, intervalNs);
+  }
+  pacer->lastPresentNs = now;
+  pacer->waitNs = 0;
+}
+
+function OSFrameStats
+OSFramePacerStats(OSFramePacer *pacer)
+{
+  OSFrameStats result = {0};
+  result.count = Min(pacer->intervalCount, OS_FRAME_HISTORY);
+  result.targetMs = (f32)pacer->targetNs / (f32)OS_NS_PER_MS;
+
+  if (result.count) {
+    u64 minNs = ~0ull, maxNs = 0, sumNs = 0;
+    for (u64 i = 0; i < result.count; ++i) {
+      u64 interval = pacer->intervals[i];
+      minNs = Min(minNs, interval);
+      maxNs = Max(maxNs, interval);
+      sumNs += interval;
+      if (interval * 2 > pacer->targetNs * 3) {
+        result.missed++;
+      }
+    }
+
+    f64 meanNs = (f64)sumNs / (f64)result.count;
+    f64 variance = 0;
+    for (u64 i = 0; i < result.count; ++i) {
+      f64 delta = (f64)pacer->intervals[i] - meanNs;
+      variance += delta * delta;
+    }
+    variance /= (f64)result.count;
+
+    f64 stddevNs = sqrt(variance);
+
+    result.meanMs = (f32)(meanNs / (f64)OS_NS_PER_MS);
+    result.minMs = (f32)minNs / (f32)OS_NS_PER_MS;
+    result.maxMs = (f32)maxNs / (f32)OS_NS_PER_MS;
+    result.jitterMs = (f32)(stddevNs / (f64)OS_NS_PER_MS);
+  }
+
+  return result;
+}
@@ -0,0 +1,9 @@
+#include "os_core.c"
+
+#if OS_WINDOWS
+# include "os_windows.c"
+#elif OS_LINUX
+# include "os_linux.c"
+#else
+# error "Missing OS implementation for this platform!"
+#endif
@@ -0,0 +1,470 @@
+#if !defined(_GNU_SOURCE)
+# error "Define _GNU_SOURCE before the first include of the translation unit"
+#endif
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct LinuxGamepad LinuxGamepad;
+struct LinuxGamepad
+{
+  int fd; // -1 when the slot is free, 0 is a valid descriptor once stdin is closed
+  dev_t device;
+  struct input_absinfo absX, absY;
+};
+
+global LinuxGamepad g_linuxGamepads[OS_MAX_GAMEPADS];
+global u64 g_linuxGamepadScanNs;
+
+// Setup
+
+function void
+OSInit(void)
+{
+  for (u32 padIdx = 0; padIdx < OS_MAX_GAMEPADS; ++padIdx) {
+    g_linuxGamepads[padIdx].fd = -1;
+  }
+}
+
+// Memory
+
+function void*
+OSMemReserve(u64 size)
+{
+  void *result = mmap(0, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return result == MAP_FAILED ? 0 : result;
+}
+
+function b32
+OSMemCommit(void *ptr, u64 size)
+{
+  b32 result = mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+  return result;
+}
+
+function void
+OSMemDecommit(void *ptr, u64 size)
+{
+  madvise(ptr, size, MADV_DONTNEED);
+  mprotect(ptr, size, PROT_NONE);
+}
+
+function void
+OSMemRelease(void *ptr, u64 size)
+{
+  munmap(ptr, size);
+}
+
+function b32
+LinuxTransparentHugePagesEnabled(void)
+{
+  // "always [madvise] never", the bracketed one is active
+  b32 result = 0;
+  int fd = open("/sys/kernel/mm/transparent_hugepage/enabled", O_RDONLY);
+  if (fd >= 0) {
+    char buffer[64] = {0};
+    ssize_t size = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    String8 setting = Str8((u8*)buffer, (u64)Max(size, 0));
+    result = (Str8Find(setting, Str8Lit("[never]"), 0, 0) == setting.size);
+  }
+
+  return result;
+}
+
+#define LINUX_HUGE_PAGE_SIZE Megabytes(2)
+
+function void*
+OSMemAllocLarge(u64 size, u64 *pageSize)
+{
+  u64 hugePageSize = LINUX_HUGE_PAGE_SIZE;
+  u64 alignedSize = AlignUpPow2(size, hugePageSize);
+
+  // Explicit huge pages only exist if someone set vm.nr_hugepages, fails up front when there aren't enough
+  void *result = mmap(0, alignedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  *pageSize = hugePageSize;
+  if (result == MAP_FAILED) {
+    // Transparent huge pages: over-reserve to get a 2MB aligned range, trim the ends and advise it
+    result = 0;
+    u8 *base = mmap(0, alignedSize + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base != MAP_FAILED) {
+      u8 *aligned = (u8*)AlignUpPow2((u64)base, hugePageSize);
+      if (aligned > base) {
+        munmap(base, (u64)(aligned - base));
+      }
+      u64 tailSize = (u64)(base + hugePageSize - aligned);
+      if (tailSize) {
+        munmap(aligned + alignedSize, tailSize);
+      }
+
+      if (!LinuxTransparentHugePagesEnabled() || madvise(aligned, alignedSize, MADV_HUGEPAGE) != 0) {
+        *pageSize = (u64)sysconf(_SC_PAGESIZE);
+      }
+      result = aligned;
+    }
+  }
+
+  return result;
+}
+
+function void
+OSMemReleaseLarge(void *ptr, u64 size)
+{
+  // Both paths mapped whole huge pages, and munmap of a MAP_HUGETLB range fails unless the length is too
+  munmap(ptr, AlignUpPow2(size, LINUX_HUGE_PAGE_SIZE));
+}
+
+// Files
+
+function u64
+OSGetLastWriteTime(String8 path)
+{
+  u64 result = 0;
+
+  struct stat st;
+  if (stat((char*)path.str, &st) == 0) {
+    result = (u64)st.st_mtim.tv_sec * OS_NS_PER_SEC + (u64)st.st_mtim.tv_nsec;
+  }
+
+  return result;
+}
+
+function b32
+OSCopyFile(String8 src, String8 dest)
+{
+  b32 result = 0;
+
+  int srcFd = open((char*)src.str, O_RDONLY);
+  if (srcFd >= 0) {
+    int destFd = open((char*)dest.str, O_WRONLY | O_CREAT | O_TRUNC, 0755);
+    if (destFd >= 0) {
+      result = 1;
+      u8 buffer[Kilobytes(64)];
+      for (ssize_t readSize; (readSize = read(srcFd, buffer, sizeof(buffer))) > 0;) {
+        if (write(destFd, buffer, readSize) != readSize) {
+          result = 0;
+          break;
+        }
+      }
+      close(destFd);
+    }
+    close(srcFd);
+  }
+
+  return result;
+}
+
+function OSFile
+OSFileOpen(String8 path)
+{
+  OSFile result = {0};
+  int fd = open((char*)path.str, O_RDONLY);
+  if (fd >= 0) {
+    result.handle = (u64)fd + 1;
+  }
+
+  return result;
+}
+
+function OSFile
+OSFileOpenWrite(String8 path)
+{
+  OSFile result = {0};
+  int fd = open((char*)path.str, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0) {
+    result.handle = (u64)fd + 1;
+  }
+
+  return result;
+}
+
+function void
+OSFileClose(OSFile file)
+{
+  if (file.handle) {
+    close((int)(file.handle - 1));
+  }
+}
+
+function u64
+OSFileSize(OSFile file)
+{
+  u64 result = 0;
+  struct stat st;
+  if (file.handle && fstat((int)(file.handle - 1), &st) == 0) {
+    result = (u64)st.st_size;
+  }
+
+  return result;
+}
+
+function u64
+OSFileRead(OSFile file, u64 offset, void *buffer, u64 size)
+{
+  u64 result = 0;
+  if (file.handle) {
+    for (ssize_t bytesRead = 0; result < size; result += bytesRead) {
+      bytesRead = pread((int)(file.handle - 1), (u8*)buffer + result, size - result, offset + result);
+      if (bytesRead <= 0) {
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+function u64
+OSFileWrite(OSFile file, u64 offset, void *buffer, u64 size)
+{
+  u64 result = 0;
+  if (file.handle) {
+    for (ssize_t bytesWritten = 0; result < size; result += bytesWritten) {
+      bytesWritten = pwrite((int)(file.handle - 1), (u8*)buffer + result, size - result, offset + result);
+      if (bytesWritten <= 0) {
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+// Time
+
+function u64
+OSNowNs(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * OS_NS_PER_SEC + (u64)ts.tv_nsec;
+}
+
+function void
+OSSleepUntilNs(u64 deadlineNs)
+{
+  struct timespec ts;
+  ts.tv_sec = deadlineNs / OS_NS_PER_SEC;
+  ts.tv_nsec = deadlineNs % OS_NS_PER_SEC;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR) {
+    // Interrupted by a signal, go back to sleep
+  }
+}
+
+// Threads
+
+function void*
+LinuxThreadProc(void *param)
+{
+  OSThreadEntry *entry = (OSThreadEntry*)param;
+  entry->func(entry->param);
+  return 0;
+}
+
+function OSThread
+OSThreadLaunch(OSThreadFunc *func, void *param)
+{
+  OSThread result = {0};
+  OSThreadEntry *entry = OSThreadEntryAlloc(func, param);
+  pthread_t thread;
+  if (entry && pthread_create(&thread, 0, LinuxThreadProc, entry) == 0) {
+    result.handle = (u64)thread;
+  }
+
+  return result;
+}
+
+function void
+OSThreadJoin(OSThread thread)
+{
+  if (thread.handle) {
+    pthread_join((pthread_t)thread.handle, 0);
+  }
+}
+
+function u32
+OSProcessorCount(void)
+{
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  u32 result = count > 0 ? (u32)count : 1;
+  return result;
+}
+
+global sem_t g_linuxSemaphores[OS_MAX_SEMAPHORES];
+global u64 g_linuxSemaphoreCount;
+
+function OSSemaphore
+OSSemaphoreAlloc(u32 initialCount)
+{
+  OSSemaphore result = {0};
+  u64 idx = AtomicAddU64(&g_linuxSemaphoreCount, 1) - 1;
+  if (idx < OS_MAX_SEMAPHORES && sem_init(&g_linuxSemaphores[idx], 0, initialCount) == 0) {
+    result.handle = (u64)&g_linuxSemaphores[idx];
+  }
+
+  return result;
+}
+
+function void
+OSSemaphoreSignal(OSSemaphore semaphore, u32 count)
+{
+  for (u32 i = 0; i < count; ++i) {
+    sem_post((sem_t*)semaphore.handle);
+  }
+}
+
+function void
+OSSemaphoreWait(OSSemaphore semaphore)
+{
+  while (sem_wait((sem_t*)semaphore.handle) != 0 && errno == EINTR) {
+    // Interrupted by a signal, keep waiting
+  }
+}
+
+// Gamepads (evdev, SDL_GameController can't be polled off the main thread)
+
+#define LinuxBitTest(bits, bit) (((bits)[(bit) / 8] >> ((bit) % 8)) & 1)
+
+function f32
+LinuxNormalizeAbs(struct input_absinfo *info, s32 value)
+{
+  f32 result = 0.f;
+  if (info->maximum > info->minimum) {
+    result = 2.f * (f32)(value - info->minimum) / (f32)(info->maximum - info->minimum) - 1.f;
+  }
+
+  return Clamp(result, -1.f, 1.f);
+}
+
+function void
+LinuxGamepadScan(void)
+{
+  DIR *dir = opendir("/dev/input");
+  if (dir) {
+    for (struct dirent *entry; (entry = readdir(dir));) {
+      if (MemoryCompare(entry->d_name, "event", 5) != 0) {
+        continue;
+      }
+
+      LinuxGamepad *slot = 0;
+      for (u32 padIdx = 0; padIdx < OS_MAX_GAMEPADS && !slot; ++padIdx) {
+        if (g_linuxGamepads[padIdx].fd < 0) {
+          slot = &g_linuxGamepads[padIdx];
+        }
+      }
+      if (!slot) {
+        break;
+      }
+
+      char path[64];
+      stbsp_snprintf(path, sizeof(path), "/dev/input/%s", entry->d_name);
+      int fd = open(path, O_RDONLY | O_NONBLOCK);
+      if (fd < 0) {
+        continue;
+      }
+
+      // Skip devices we already have open and anything that isn't a gamepad
+      struct stat st;
+      b32 isNew = (fstat(fd, &st) == 0);
+      for (u32 padIdx = 0; padIdx < OS_MAX_GAMEPADS && isNew; ++padIdx) {
+        isNew = !(g_linuxGamepads[padIdx].fd >= 0 && g_linuxGamepads[padIdx].device == st.st_rdev);
+      }
+      u8 keyBits[KEY_MAX / 8 + 1] = {0};
+      b32 isGamepad = (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) >= 0 &&
+                       LinuxBitTest(keyBits, BTN_GAMEPAD));
+      if (isNew && isGamepad) {
+        MemoryZeroStruct(slot);
+        slot->fd = fd;
+        slot->device = st.st_rdev;
+        ioctl(fd, EVIOCGABS(ABS_X), &slot->absX);
+        ioctl(fd, EVIOCGABS(ABS_Y), &slot->absY);
+      } else {
+        close(fd);
+      }
+    }
+    closedir(dir);
+  }
+}
+
+function void
+OSGamepadPoll(OSGamepadState *pads, u32 count)
+{
+  // Hotplug by rescanning once a second
+  u64 now = OSNowNs();
+  if (now >= g_linuxGamepadScanNs) {
+    LinuxGamepadScan();
+    g_linuxGamepadScanNs = now + OS_NS_PER_SEC;
+  }
+
+  u32 padCount = Min(count, OS_MAX_GAMEPADS);
+  for (u32 padIdx = 0; padIdx < padCount; ++padIdx) {
+    LinuxGamepad *gamepad = &g_linuxGamepads[padIdx];
+    OSGamepadState *pad = &pads[padIdx];
+    if (gamepad->fd < 0) {
+      MemoryZeroStruct(pad);
+      continue;
+    }
+    pad->isConnected = 1;
+
+    struct input_event events[64];
+    ssize_t readSize;
+    while ((readSize = read(gamepad->fd, events, sizeof(events))) > 0) {
+      for (u64 eventIdx = 0; eventIdx < (u64)readSize / sizeof(struct input_event); ++eventIdx) {
+        struct input_event *event = &events[eventIdx];
+        if (event->type == EV_KEY) {
+          // Positional names, BTN_X/BTN_Y alias North/West on xpad
+          OSGamepadButtons button = 0;
+          switch (event->code) {
+            case BTN_SOUTH:      button = OSGamepadButton_South; break;
+            case BTN_EAST:       button = OSGamepadButton_East; break;
+            case BTN_WEST:       button = OSGamepadButton_West; break;
+            case BTN_NORTH:      button = OSGamepadButton_North; break;
+            case BTN_DPAD_UP:    button = OSGamepadButton_DPadUp; break;
+            case BTN_DPAD_DOWN:  button = OSGamepadButton_DPadDown; break;
+            case BTN_DPAD_LEFT:  button = OSGamepadButton_DPadLeft; break;
+            case BTN_DPAD_RIGHT: button = OSGamepadButton_DPadRight; break;
+            case BTN_START:      button = OSGamepadButton_Start; break;
+            case BTN_SELECT:     button = OSGamepadButton_Back; break;
+          }
+          if (event->value) {
+            pad->buttons |= button;
+          } else {
+            pad->buttons &= ~button;
+          }
+        } else if (event->type == EV_ABS) {
+          switch (event->code) {
+            case ABS_X: pad->stickX = LinuxNormalizeAbs(&gamepad->absX, event->value); break;
+            case ABS_Y: pad->stickY = -LinuxNormalizeAbs(&gamepad->absY, event->value); break;
+            case ABS_HAT0X: {
+              pad->buttons &= ~(OSGamepadButton_DPadLeft | OSGamepadButton_DPadRight);
+              if (event->value < 0) pad->buttons |= OSGamepadButton_DPadLeft;
+              if (event->value > 0) pad->buttons |= OSGamepadButton_DPadRight;
+            } break;
+            case ABS_HAT0Y: {
+              pad->buttons &= ~(OSGamepadButton_DPadUp | OSGamepadButton_DPadDown);
+              if (event->value < 0) pad->buttons |= OSGamepadButton_DPadUp;
+              if (event->value > 0) pad->buttons |= OSGamepadButton_DPadDown;
+            } break;
+          }
+        }
+      }
+    }
+
+    if (readSize < 0 && errno != EAGAIN) {
+      // Unplugged
+      close(gamepad->fd);
+      MemoryZeroStruct(gamepad);
+      gamepad->fd = -1;
+      MemoryZeroStruct(pad);
+    }
+  }
+}
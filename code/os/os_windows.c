@@ -0,0 +1,366 @@
+#include <windows.h>
+#include <xinput.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+# define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+typedef DWORD WINAPI Win32XInputGetStateFunc(DWORD userIndex, XINPUT_STATE *state);
+
+global u64    g_win32PerfFrequency;
+global HANDLE g_win32SleepTimer;
+global Win32XInputGetStateFunc *g_win32XInputGetState;
+global u64    g_win32GamepadRetryNs[OS_MAX_GAMEPADS];
+
+// Setup
+
+function void
+OSInit(void)
+{
+  LARGE_INTEGER perfFrequency;
+  QueryPerformanceFrequency(&perfFrequency);
+  g_win32PerfFrequency = perfFrequency.QuadPart;
+
+  // High resolution timers (Win10 1803+) wake within ~0.5ms, otherwise bump the scheduler period
+  g_win32SleepTimer = CreateWaitableTimerExW(0, 0, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+  if (!g_win32SleepTimer) {
+    timeBeginPeriod(1);
+    g_win32SleepTimer = CreateWaitableTimerExW(0, 0, 0, TIMER_ALL_ACCESS);
+  }
+
+  // Load XInput ourselves so machines without the redistributable still start
+  HMODULE xinput = LoadLibraryA("xinput1_4.dll");
+  if (!xinput) {
+    xinput = LoadLibraryA("xinput9_1_0.dll");
+  }
+  if (xinput) {
+    g_win32XInputGetState = (Win32XInputGetStateFunc*)GetProcAddress(xinput, "XInputGetState");
+  }
+}
+
+// Memory
+
+function void*
+OSMemReserve(u64 size)
+{
+  return VirtualAlloc(0, size, MEM_RESERVE, PAGE_READWRITE);
+}
+
+function b32
+OSMemCommit(void *ptr, u64 size)
+{
+  b32 result = VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != 0;
+  return result;
+}
+
+function void
+OSMemDecommit(void *ptr, u64 size)
+{
+  VirtualFree(ptr, size, MEM_DECOMMIT);
+}
+
+function void
+OSMemRelease(void *ptr, u64 size)
+{
+  Unused(size);
+  VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+// Large pages need SeLockMemoryPrivilege, which the account has to be granted in the local security policy
+function b32
+Win32EnableLockMemoryPrivilege(void)
+{
+  b32 result = 0;
+  HANDLE token;
+  if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+    TOKEN_PRIVILEGES privileges = {0};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    if (LookupPrivilegeValueA(0, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid)) {
+      // Succeeds with ERROR_NOT_ALL_ASSIGNED when the account doesn't hold the privilege
+      AdjustTokenPrivileges(token, FALSE, &privileges, 0, 0, 0);
+      result = (GetLastError() == ERROR_SUCCESS);
+    }
+    CloseHandle(token);
+  }
+
+  return result;
+}
+
+function void*
+OSMemAllocLarge(u64 size, u64 *pageSize)
+{
+  void *result = 0;
+  u64 largePageSize = GetLargePageMinimum();
+  if (largePageSize && Win32EnableLockMemoryPrivilege()) {
+    // Large pages are committed and locked up front, and fail if physical memory is too fragmented
+    result = VirtualAlloc(0, AlignUpPow2(size, largePageSize), MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+  }
+
+  if (result) {
+    *pageSize = largePageSize;
+  } else {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    *pageSize = info.dwPageSize;
+    result = OSMemReserve(size);
+    if (result) {
+      OSMemCommit(result, size);
+    }
+  }
+
+  return result;
+}
+
+function void
+OSMemReleaseLarge(void *ptr, u64 size)
+{
+  OSMemRelease(ptr, size);
+}
+
+// Files
+
+function u64
+OSGetLastWriteTime(String8 path)
+{
+  u64 result = 0;
+
+  WIN32_FILE_ATTRIBUTE_DATA fileData;
+  if (GetFileAttributesExA((LPCSTR)path.str, GetFileExInfoStandard, &fileData)) {
+    result = ((u64)fileData.ftLastWriteTime.dwHighDateTime << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+  }
+
+  return result;
+}
+
+function b32
+OSCopyFile(String8 src, String8 dest)
+{
+  return CopyFileA((LPCSTR)src.str, (LPCSTR)dest.str, false) != 0;
+}
+
+function OSFile
+OSFileOpen(String8 path)
+{
+  OSFile result = {0};
+  HANDLE handle = CreateFileA((LPCSTR)path.str, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if (handle != INVALID_HANDLE_VALUE) {
+    result.handle = (u64)handle;
+  }
+
+  return result;
+}
+
+function OSFile
+OSFileOpenWrite(String8 path)
+{
+  OSFile result = {0};
+  HANDLE handle = CreateFileA((LPCSTR)path.str, GENERIC_WRITE, FILE_SHARE_READ, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+  if (handle != INVALID_HANDLE_VALUE) {
+    result.handle = (u64)handle;
+  }
+
+  return result;
+}
+
+function void
+OSFileClose(OSFile file)
+{
+  if (file.handle) {
+    CloseHandle((HANDLE)file.handle);
+  }
+}
+
+function u64
+OSFileSize(OSFile file)
+{
+  LARGE_INTEGER size = {0};
+  if (file.handle) {
+    GetFileSizeEx((HANDLE)file.handle, &size);
+  }
+
+  return (u64)size.QuadPart;
+}
+
+function u64
+OSFileRead(OSFile file, u64 offset, void *buffer, u64 size)
+{
+  u64 result = 0;
+  if (file.handle) {
+    // Positional read on a synchronous handle, so several threads can share a file
+    for (DWORD bytesRead = 0; result < size; result += bytesRead) {
+      OVERLAPPED overlapped = {0};
+      overlapped.Offset = (DWORD)(offset + result);
+      overlapped.OffsetHigh = (DWORD)((offset + result) >> 32);
+      DWORD toRead = (DWORD)Min(size - result, 0x80000000ull);
+      if (!ReadFile((HANDLE)file.handle, (u8*)buffer + result, toRead, &bytesRead, &overlapped) || bytesRead == 0) {
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+function u64
+OSFileWrite(OSFile file, u64 offset, void *buffer, u64 size)
+{
+  u64 result = 0;
+  if (file.handle) {
+    for (DWORD bytesWritten = 0; result < size; result += bytesWritten) {
+      OVERLAPPED overlapped = {0};
+      overlapped.Offset = (DWORD)(offset + result);
+      overlapped.OffsetHigh = (DWORD)((offset + result) >> 32);
+      DWORD toWrite = (DWORD)Min(size - result, 0x80000000ull);
+      if (!WriteFile((HANDLE)file.handle, (u8*)buffer + result, toWrite, &bytesWritten, &overlapped) || bytesWritten == 0) {
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+// Time
+
+function u64
+OSNowNs(void)
+{
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+
+  u64 seconds = counter.QuadPart / g_win32PerfFrequency;
+  u64 remainder = counter.QuadPart % g_win32PerfFrequency;
+  return seconds * OS_NS_PER_SEC + (remainder * OS_NS_PER_SEC) / g_win32PerfFrequency;
+}
+
+function void
+OSSleepUntilNs(u64 deadlineNs)
+{
+  u64 now = OSNowNs();
+  if (now < deadlineNs) {
+    // Relative due times are negative and in 100ns units
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -(LONGLONG)((deadlineNs - now) / 100);
+    if (g_win32SleepTimer && SetWaitableTimer(g_win32SleepTimer, &dueTime, 0, 0, 0, false)) {
+      WaitForSingleObject(g_win32SleepTimer, INFINITE);
+    } else {
+      Sleep((DWORD)((deadlineNs - now) / OS_NS_PER_MS));
+    }
+  }
+}
+
+// Threads
+
+function DWORD WINAPI
+Win32ThreadProc(LPVOID param)
+{
+  OSThreadEntry *entry = (OSThreadEntry*)param;
+  entry->func(entry->param);
+  return 0;
+}
+
+function OSThread
+OSThreadLaunch(OSThreadFunc *func, void *param)
+{
+  OSThread result = {0};
+  OSThreadEntry *entry = OSThreadEntryAlloc(func, param);
+  if (entry) {
+    result.handle = (u64)CreateThread(0, 0, Win32ThreadProc, entry, 0, 0);
+  }
+
+  return result;
+}
+
+function void
+OSThreadJoin(OSThread thread)
+{
+  if (thread.handle) {
+    WaitForSingleObject((HANDLE)thread.handle, INFINITE);
+    CloseHandle((HANDLE)thread.handle);
+  }
+}
+
+function u32
+OSProcessorCount(void)
+{
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  u32 result = Max((u32)info.dwNumberOfProcessors, 1);
+  return result;
+}
+
+function OSSemaphore
+OSSemaphoreAlloc(u32 initialCount)
+{
+  OSSemaphore result = {0};
+  result.handle = (u64)CreateSemaphoreA(0, (LONG)initialCount, MAXLONG, 0);
+  return result;
+}
+
+function void
+OSSemaphoreSignal(OSSemaphore semaphore, u32 count)
+{
+  if (count) {
+    ReleaseSemaphore((HANDLE)semaphore.handle, (LONG)count, 0);
+  }
+}
+
+function void
+OSSemaphoreWait(OSSemaphore semaphore)
+{
+  WaitForSingleObject((HANDLE)semaphore.handle, INFINITE);
+}
+
+// Gamepads
+
+function f32
+Win32NormalizeStick(SHORT value)
+{
+  f32 result = (f32)value / 32767.f;
+  return Clamp(result, -1.f, 1.f);
+}
+
+function void
+OSGamepadPoll(OSGamepadState *pads, u32 count)
+{
+  read_only struct { WORD xinput; OSGamepadButtons os; } buttonMap[] = {
+    {XINPUT_GAMEPAD_A,          OSGamepadButton_South},
+    {XINPUT_GAMEPAD_B,          OSGamepadButton_East},
+    {XINPUT_GAMEPAD_X,          OSGamepadButton_West},
+    {XINPUT_GAMEPAD_Y,          OSGamepadButton_North},
+    {XINPUT_GAMEPAD_DPAD_UP,    OSGamepadButton_DPadUp},
+    {XINPUT_GAMEPAD_DPAD_DOWN,  OSGamepadButton_DPadDown},
+    {XINPUT_GAMEPAD_DPAD_LEFT,  OSGamepadButton_DPadLeft},
+    {XINPUT_GAMEPAD_DPAD_RIGHT, OSGamepadButton_DPadRight},
+    {XINPUT_GAMEPAD_START,      OSGamepadButton_Start},
+    {XINPUT_GAMEPAD_BACK,       OSGamepadButton_Back},
+  };
+
+  u64 now = OSNowNs();
+  u32 padCount = Min(count, Min(OS_MAX_GAMEPADS, XUSER_MAX_COUNT));
+  for (u32 padIdx = 0; padIdx < padCount && g_win32XInputGetState; ++padIdx) {
+    OSGamepadState *pad = &pads[padIdx];
+
+    // XInputGetState on an empty slot can stall for a long time, so only retry those once a second
+    if (!pad->isConnected && now < g_win32GamepadRetryNs[padIdx]) {
+      continue;
+    }
+
+    XINPUT_STATE state;
+    if (g_win32XInputGetState(padIdx, &state) == ERROR_SUCCESS) {
+      pad->isConnected = 1;
+      pad->buttons = 0;
+      for (u32 i = 0; i < ArrayCount(buttonMap); ++i) {
+        if (state.Gamepad.wButtons & buttonMap[i].xinput) {
+          pad->buttons |= buttonMap[i].os;
+        }
+      }
+      pad->stickX = Win32NormalizeStick(state.Gamepad.sThumbLX);
+      pad->stickY = Win32NormalizeStick(state.Gamepad.sThumbLY);
+    } else {
+      MemoryZeroStruct(pad);
+      g_win32GamepadRetryNs[padIdx] = now + OS_NS_PER_SEC;
+    }
+  }
+}
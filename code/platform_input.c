@@ -0,0 +1,363 @@
+/*
+  Input gathering shared by the platform layers.
+  Platforms push events as they arrive, PlatformInputEnd flattens them into the
+  tick's GameInput and derives the per-source state the game reads.
+  Gamepads are sampled at 1kHz on their own thread and latched right before the tick.
+*/
+
+#define PLATFORM_GAMEPAD_POLL_NS    (OS_NS_PER_SEC / 1000)
+#define PLATFORM_GAMEPAD_QUEUE_SIZE 1024
+#define PLATFORM_GAMEPAD_DEADZONE   0.24f
+
+typedef u32 PlatformKeyboardDir;
+enum
+{
+  PlatformKeyboardDir_Up,
+  PlatformKeyboardDir_Down,
+  PlatformKeyboardDir_Left,
+  PlatformKeyboardDir_Right,
+  PlatformKeyboardDir_COUNT,
+};
+
+typedef struct PlatformInputEventNode PlatformInputEventNode;
+struct PlatformInputEventNode
+{
+  PlatformInputEventNode *next;
+  GameInputEvent event;
+};
+
+typedef struct PlatformInput PlatformInput;
+struct PlatformInput
+{
+  // Events of the tick being gathered
+  Arena *arena;
+  PlatformInputEventNode *first;
+  PlatformInputEventNode *last;
+  u64 eventCount;
+  u64 tickStartNs;
+  u64 lastEventNs;
+
+  // One bit per physical key, so W + Up don't move you twice as fast
+  u32 dirKeysDown[PlatformKeyboardDir_COUNT];
+  f32 keyboardAxes[2];
+
+  GameInput prevInput;
+
+  // Oldest event of a tick to the present that showed it
+  u64 latencySumNs;
+  u64 latencyMaxNs;
+  u64 latencyCount;
+};
+
+typedef struct PlatformGamepadThread PlatformGamepadThread;
+struct PlatformGamepadThread
+{
+  SPSCQueue *events; // GameInputEvent, gamepad thread -> main thread
+  volatile u64 running;
+  volatile u64 dropped;
+  OSThread thread;
+};
+
+function void
+PlatformInputInit(PlatformInput *input, Arena *arena, u64 nowNs)
+{
+  MemoryZeroStruct(input);
+  input->arena = arena;
+  input->tickStartNs = nowNs;
+  input->lastEventNs = nowNs;
+  input->prevInput.sources[0].isConnected = 1;
+}
+
+function void
+PlatformInputPushEvent(PlatformInput *input, GameInputEvent event)
+{
+  event.timestampNs = Max(event.timestampNs, input->tickStartNs);
+  input->lastEventNs = Max(event.timestampNs, input->lastEventNs);
+
+  PlatformInputEventNode *node = ArenaPushN(input->arena, PlatformInputEventNode, 1);
+  if (node) {
+    node->event = event;
+    input->eventCount++;
+
+    // Keep the list sorted, only events latched from the gamepad thread land out of order
+    if (!input->last || input->last->event.timestampNs <= event.timestampNs) {
+      SLLQueuePush(input->first, input->last, node);
+    } else if (event.timestampNs < input->first->event.timestampNs) {
+      SLLQueuePushFront(input->first, input->last, node);
+    } else {
+      PlatformInputEventNode *prev = input->first;
+      while (prev->next->event.timestampNs <= event.timestampNs) {
+        prev = prev->next;
+      }
+      node->next = prev->next;
+      prev->next = node;
+    }
+  }
+}
+
+function void
+PlatformInputPushButton(PlatformInput *input, u32 source, u32 button, b32 isDown, u64 timestampNs)
+{
+  GameInputEvent event = {0};
+  event.timestampNs = timestampNs;
+  event.kind = GameInputEvent_Button;
+  event.source = source;
+  event.index = button;
+  event.isDown = isDown;
+  PlatformInputPushEvent(input, event);
+}
+
+function void
+PlatformInputPushAxis(PlatformInput *input, u32 source, GameInputAxis axis, f32 value, u64 timestampNs)
+{
+  GameInputEvent event = {0};
+  event.timestampNs = timestampNs;
+  event.kind = GameInputEvent_Axis;
+  event.source = source;
+  event.index = axis;
+  event.value = value;
+  PlatformInputPushEvent(input, event);
+}
+
+function void
+PlatformInputPushDirKey(PlatformInput *input, PlatformKeyboardDir dir, u32 keyBit, b32 isDown, u64 timestampNs)
+{
+  if (isDown) {
+    input->dirKeysDown[dir] |= keyBit;
+  } else {
+    input->dirKeysDown[dir] &= ~keyBit;
+  }
+
+  f32 axes[2];
+  axes[GameInputAxis_X] = (f32)(input->dirKeysDown[PlatformKeyboardDir_Right] != 0) - (f32)(input->dirKeysDown[PlatformKeyboardDir_Left] != 0);
+  axes[GameInputAxis_Y] = (f32)(input->dirKeysDown[PlatformKeyboardDir_Up] != 0) - (f32)(input->dirKeysDown[PlatformKeyboardDir_Down] != 0);
+  for (u32 axis = 0; axis < ArrayCount(axes); ++axis) {
+    if (axes[axis] != input->keyboardAxes[axis]) {
+      input->keyboardAxes[axis] = axes[axis];
+      PlatformInputPushAxis(input, 0, axis, axes[axis], timestampNs);
+    }
+  }
+}
+
+function GameInput
+PlatformInputEnd(PlatformInput *input, u64 nowNs)
+{
+  GameInput result = {0};
+  result.tickStartNs = input->tickStartNs;
+  result.tickEndNs = Max(nowNs, input->lastEventNs);
+  result.events = ArenaPushN(input->arena, GameInputEvent, input->eventCount);
+  if (result.events) {
+    for (PlatformInputEventNode *node = input->first; node; node = node->next) {
+      result.events[result.eventCount++] = node->event;
+    }
+  }
+
+  // Derive state by replaying the events on top of the last tick's state
+  for (u32 sourceIdx = 0; sourceIdx < NUM_INPUT_SOURCES; ++sourceIdx) {
+    GameInputSource *source = &result.sources[sourceIdx];
+    *source = input->prevInput.sources[sourceIdx];
+    for (u32 buttonIdx = 0; buttonIdx < NUM_BUTTONS; ++buttonIdx) {
+      source->buttons[buttonIdx].halfTransitionCount = 0;
+    }
+  }
+
+  for (u64 eventIdx = 0; eventIdx < result.eventCount; ++eventIdx) {
+    GameInputEvent *event = &result.events[eventIdx];
+    if (event->source < NUM_INPUT_SOURCES) {
+      GameInputSource *source = &result.sources[event->source];
+      switch (event->kind) {
+        case GameInputEvent_Button: {
+          if (event->index < NUM_BUTTONS) {
+            GameButtonState *button = &source->buttons[event->index];
+            if (button->isDown != event->isDown) {
+              button->isDown = event->isDown;
+              button->halfTransitionCount++;
+            }
+          }
+        } break;
+
+        case GameInputEvent_Axis: {
+          if (event->index == GameInputAxis_X) source->xAxis = event->value;
+          if (event->index == GameInputAxis_Y) source->yAxis = event->value;
+        } break;
+
+        case GameInputEvent_Connection: {
+          source->isConnected = event->isConnected;
+          if (!event->isConnected) {
+            source->xAxis = source->yAxis = 0.f;
+            for (u32 buttonIdx = 0; buttonIdx < NUM_BUTTONS; ++buttonIdx) {
+              GameButtonState *button = &source->buttons[buttonIdx];
+              button->halfTransitionCount += (button->isDown != 0);
+              button->isDown = 0;
+            }
+          }
+        } break;
+      }
+    }
+  }
+
+  input->prevInput = result;
+  input->prevInput.events = 0;
+  input->prevInput.eventCount = 0;
+
+  input->first = input->last = 0;
+  input->eventCount = 0;
+  input->tickStartNs = result.tickEndNs;
+  input->lastEventNs = result.tickEndNs;
+
+  return result;
+}
+
+// Gamepad thread
+
+function void
+PlatformGamepadPushEvent(PlatformGamepadThread *thread, GameInputEvent event)
+{
+  if (!SPSCQueuePush(thread->events, &event)) {
+    AtomicAddU64(&thread->dropped, 1);
+  }
+}
+
+function f32
+PlatformGamepadApplyDeadzone(f32 value)
+{
+  f32 magnitude = value < 0.f ? -value : value;
+  f32 result = 0.f;
+  if (magnitude > PLATFORM_GAMEPAD_DEADZONE) {
+    result = (magnitude - PLATFORM_GAMEPAD_DEADZONE) / (1.f - PLATFORM_GAMEPAD_DEADZONE);
+    result = value < 0.f ? -result : result;
+  }
+
+  return result;
+}
+
+function void
+PlatformGamepadThreadProc(void *param)
+{
+  read_only OSGamepadButtons buttonMap[NUM_BUTTONS] = {
+    OSGamepadButton_South, OSGamepadButton_East, OSGamepadButton_West, OSGamepadButton_North,
+  };
+
+  PlatformGamepadThread *thread = (PlatformGamepadThread*)param;
+  OSGamepadState pads[OS_MAX_GAMEPADS] = {0};
+  GameInputSource sent[OS_MAX_GAMEPADS] = {0}; // What the main thread will have seen so far
+
+  u64 deadlineNs = OSNowNs();
+  while (AtomicLoadU64(&thread->running)) {
+    OSGamepadPoll(pads, OS_MAX_GAMEPADS);
+
+    GameInputEvent event = {0};
+    event.timestampNs = OSNowNs();
+    for (u32 padIdx = 0; padIdx < OS_MAX_GAMEPADS && padIdx + 1 < NUM_INPUT_SOURCES; ++padIdx) {
+      OSGamepadState *pad = &pads[padIdx];
+      GameInputSource *source = &sent[padIdx];
+      event.source = padIdx + 1;
+
+      if (pad->isConnected != source->isConnected) {
+        event.kind = GameInputEvent_Connection;
+        event.index = 0;
+        event.isConnected = pad->isConnected;
+        PlatformGamepadPushEvent(thread, event);
+        MemoryZeroStruct(source);
+        source->isConnected = pad->isConnected;
+      }
+
+      for (u32 buttonIdx = 0; buttonIdx < NUM_BUTTONS; ++buttonIdx) {
+        b32 isDown = (pad->buttons & buttonMap[buttonIdx]) != 0;
+        if (isDown != source->buttons[buttonIdx].isDown) {
+          event.kind = GameInputEvent_Button;
+          event.index = buttonIdx;
+          event.isDown = isDown;
+          PlatformGamepadPushEvent(thread, event);
+          source->buttons[buttonIdx].isDown = isDown;
+        }
+      }
+
+      // D-pad wins over the stick
+      f32 axes[2];
+      axes[GameInputAxis_X] = PlatformGamepadApplyDeadzone(pad->stickX);
+      axes[GameInputAxis_Y] = PlatformGamepadApplyDeadzone(pad->stickY);
+      if (pad->buttons & (OSGamepadButton_DPadLeft | OSGamepadButton_DPadRight)) {
+        axes[GameInputAxis_X] = (pad->buttons & OSGamepadButton_DPadRight) ? 1.f : -1.f;
+      }
+      if (pad->buttons & (OSGamepadButton_DPadUp | OSGamepadButton_DPadDown)) {
+        axes[GameInputAxis_Y] = (pad->buttons & OSGamepadButton_DPadUp) ? 1.f : -1.f;
+      }
+
+      f32 *sentAxes[2];
+      sentAxes[GameInputAxis_X] = &source->xAxis;
+      sentAxes[GameInputAxis_Y] = &source->yAxis;
+      for (u32 axis = 0; axis < ArrayCount(axes); ++axis) {
+        // Sticks are noisy at 1kHz, only report moves of more than ~1/256
+        f32 delta = axes[axis] - *sentAxes[axis];
+        b32 changed = (delta > (1.f / 256.f) || delta < -(1.f / 256.f) ||
+                       (axes[axis] == 0.f && *sentAxes[axis] != 0.f));
+        if (changed) {
+          event.kind = GameInputEvent_Axis;
+          event.index = axis;
+          event.value = axes[axis];
+          PlatformGamepadPushEvent(thread, event);
+          *sentAxes[axis] = axes[axis];
+        }
+      }
+    }
+
+    // Don't burst to catch up after a late wake, just resync
+    deadlineNs = Max(deadlineNs + PLATFORM_GAMEPAD_POLL_NS, event.timestampNs);
+    OSSleepUntilNs(deadlineNs);
+  }
+}
+
+function void
+PlatformGamepadThreadStart(PlatformGamepadThread *thread, Arena *arena)
+{
+  MemoryZeroStruct(thread);
+  thread->events = SPSCQueueAllocN(arena, GameInputEvent, PLATFORM_GAMEPAD_QUEUE_SIZE);
+  if (thread->events) {
+    thread->running = 1;
+    thread->thread = OSThreadLaunch(PlatformGamepadThreadProc, thread);
+  }
+}
+
+function void
+PlatformGamepadThreadStop(PlatformGamepadThread *thread)
+{
+  AtomicStoreU64(&thread->running, 0);
+  OSThreadJoin(thread->thread);
+}
+
+// Late latch: pull everything the gamepad thread sampled so far into the current tick
+function void
+PlatformInputLatchGamepads(PlatformInput *input, PlatformGamepadThread *thread)
+{
+  if (thread->events) {
+    for (GameInputEvent event; SPSCQueuePop(thread->events, &event);) {
+      PlatformInputPushEvent(input, event);
+    }
+  }
+}
+
+function void
+PlatformInputMarkPresent(PlatformInput *input, GameInput *tick, u64 presentNs)
+{
+  if (tick->eventCount) {
+    u64 latencyNs = presentNs - Min(presentNs, tick->events[0].timestampNs);
+    input->latencySumNs += latencyNs;
+    input->latencyMaxNs = Max(input->latencyMaxNs, latencyNs);
+    input->latencyCount++;
+  }
+}
+
+function String8
+PlatformInputLatencyReport(PlatformInput *input, Arena *arena)
+{
+  String8 result = {0};
+  if (input->latencyCount) {
+    f32 avgMs = (f32)(input->latencySumNs / input->latencyCount) / (f32)OS_NS_PER_MS;
+    f32 maxMs = (f32)input->latencyMaxNs / (f32)OS_NS_PER_MS;
+    result = PushStr8F(arena, "input->present: %.02fms avg, %.02fms max (%llu ticks)\n", avgMs, maxMs, input->latencyCount);
+    input->latencySumNs = input->latencyMaxNs = input->latencyCount = 0;
+  }
+
+  return result;
+}
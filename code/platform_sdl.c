@@ -8,27 +8,63 @@
 // Unity build
 
 // Headers
+#define _GNU_SOURCE // Before any system header, os_linux.c needs mmap flags, st_mtim and the pthread extras
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
-#include <SDL_opengl.h>
 
 #include "base/base_include.h"
-// #include "os/os.h"
+#include "os/os.h"
+#include "render/render.h"
 #include "game.h"
+#include "audio/audio_include.h"
+#include "log/logger.h"
+#include "render/render_sort.h"
+#include "render/render_sokol.h"
+#include "render/render_software.h"
+#if OS_LINUX
+#include "render/render_offscreen.h"
+#endif
 
 // Source
+#define SOKOL_IMPL
+#define SOKOL_DEBUG
+#define SOKOL_GLCORE33
+#include <sokol/sokol_log.h>
+#include <sokol/sokol_gfx.h>
+#include <sokol/sokol_gp.h>
+
 #define STB_SPRINTF_IMPLEMENTATION
 #include <stb/stb_sprintf.h>
 #include "base/base_include.c"
-
-#if OS_WINDOWS
-# include "os/os_windows.c"
-#elif OS_MAC || OS_LINUX
-# error "Missing implementation for Unix-like systems!"
-#endif // OS detection
+#include "os/os_include.c"
+#include "platform_input.c"
+#include "audio/audio_include.c"
+#include "log/logger.c"
+#include "render/render.c"
+#include "render/render_sort.c"
+#include "render/render_sokol.c"
+#include "render/render_software.c"
+#if OS_LINUX
+#include "render/render_offscreen.c"
+#endif
+
+#define HEADLESS_WIDTH           800
+#define HEADLESS_HEIGHT          600
+#define HEADLESS_FRAMES          600 // Default for -frames
+#define HEADLESS_FRAME_NS        (OS_NS_PER_SEC / 60)
+#define HEADLESS_GOLDEN_INTERVAL 60  // Frames between golden image checks, the last frame is always checked
 
 // Globals
-global u64 g_perfFrequency;
+global Mixer g_mixer;
+global AudioStreamer g_streamer;
+global Logger g_logger;
+global RenderBackend g_renderer;
+global RenderSoftware g_softwareRenderer; // Headless runs only
+global b32 g_isHeadless;
+global b32 g_isSoftwareRenderer; // Headless without -gl
+#if OS_LINUX
+global RenderOffscreen g_offscreen; // Headless with -gl
+#endif
 
 typedef struct GameHandle GameHandle;
 struct GameHandle
@@ -54,22 +90,76 @@ struct PlatformState
 
   // Misc
   String8 basePath;
+  b32 isHeadless; // No window, no GL, no audio device
 
   // SDL handles
   SDL_Window   *window;
   SDL_GLContext glContext;
+  SDL_AudioDeviceID audioDevice;
 };
 
-function u64
-GetWallClock(void)
+// Public API
+
+extern void
+DebugPrint(String8 msg)
+{
+  SDL_Log("%.*s", Str8Expand(msg));
+}
+
+extern u64
+AudioPlay(GameSound *sound, f32 volume, b32 isLooping)
+{
+  return MixerPlay(&g_mixer, sound, volume, isLooping);
+}
+
+extern u64
+AudioPlayStream(String8 path, f32 volume, b32 isLooping)
+{
+  AudioStream *stream = AudioStreamOpen(&g_streamer, path, isLooping);
+  u64 result = MixerPlayStream(&g_mixer, stream, volume);
+  if (stream && !result) {
+    AudioStreamRelease(stream);
+  }
+
+  return result;
+}
+
+extern void
+AudioStop(u64 voice)
 {
-  return SDL_GetPerformanceCounter();
+  MixerStop(&g_mixer, voice);
 }
 
-function f32
-GetSecondsElapsed(u64 oldCounter, u64 newCounter)
+extern void
+AudioSetVolume(u64 voice, f32 volume)
 {
-  return (f32)(newCounter - oldCounter) / (f32)g_perfFrequency;
+  MixerSetVolume(&g_mixer, voice, volume);
+}
+
+extern RenderTexture
+RenderTextureCreate(u32 width, u32 height, void *pixels)
+{
+  RenderTexture result = g_isSoftwareRenderer ? RenderSoftwareTextureCreate(&g_softwareRenderer, width, height, pixels) :
+                                        RenderBackendTextureCreate(&g_renderer, width, height, pixels);
+  return result;
+}
+
+// Internal functions
+
+function void*
+AllocMemory(u64 size, b32 useLargePages, char *name)
+{
+  void *result = 0;
+  if (useLargePages) {
+    u64 pageSize;
+    result = OSMemAllocLarge(size, &pageSize);
+    SDL_Log("%s: %lluMB on %lluKB pages", name, (unsigned long long)(size >> 20), (unsigned long long)(pageSize >> 10));
+  } else {
+    result = OSMemReserve(size);
+    OSMemCommit(result, size);
+  }
+
+  return result;
 }
 
 function int
@@ -83,53 +173,97 @@ GetWindowRefresh(SDL_Window *window)
   return result;
 }
 
+function u64
+GetEventTimeNs(Uint32 timestamp)
+{
+  // SDL stamps events with SDL_GetTicks, rebase that onto OSNowNs
+  u64 now = OSNowNs();
+  u64 ageNs = (u64)(SDL_GetTicks() - timestamp) * OS_NS_PER_MS;
+  return now - Min(now, ageNs);
+}
+
 function void
-ProcessInput(GameButtonState *oldState, GameButtonState *newState, b32 isDown)
+AudioCallback(void *userData, Uint8 *stream, int length)
 {
-  newState->isDown = isDown;
-  newState->halfTransitionCount = (oldState->isDown != newState->isDown) ? 1 : 0;
+  Mixer *mixer = (Mixer*)userData;
+  MixerRender(mixer, (f32*)stream, (u64)length / (2 * sizeof(f32)));
+}
+
+function void
+InitAudio(PlatformState *app)
+{
+  MixerInit(&g_mixer, app->permanentArena);
+  AudioStreamerStart(&g_streamer, app->permanentArena);
+
+  SDL_AudioSpec want = {0};
+  want.freq = GAME_AUDIO_SAMPLE_RATE;
+  want.format = AUDIO_F32SYS;
+  want.channels = 2;
+  want.samples = 512;
+  want.callback = AudioCallback;
+  want.userdata = &g_mixer;
+
+  // No allowed changes, SDL converts for us if the device wants something else.
+  // Headless runs leave the mixer inactive, so sounds play silently
+  SDL_AudioSpec have;
+  app->audioDevice = app->isHeadless ? 0 : SDL_OpenAudioDevice(0, 0, &want, &have, 0);
+  if (app->audioDevice) {
+    g_mixer.isActive = true;
+    SDL_PauseAudioDevice(app->audioDevice, 0);
+  } else if (!app->isHeadless) {
+    DebugPrint(Str8Lit("Unable to open an audio device!\n"));
+  }
 }
 
 function PlatformState
-PlatformInit(void)
+PlatformInit(b32 useLargePages, b32 isHeadless)
 {
   read_only char *windowTitle = "Game";
   read_only u32 windowWidth = 800, windowHeight = 600;
 
-  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) == 0) {
-    SDL_Window *window = SDL_CreateWindow(
+  // Headless runs only need SDL for paths and loading the game
+  SDL_Window *window = 0;
+  SDL_GLContext glContext = 0;
+  b32 isReady = false;
+  if (isHeadless) {
+    isReady = SDL_Init(0) == 0;
+  } else if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) == 0) {
+    window = SDL_CreateWindow(
       windowTitle,
       SDL_WINDOWPOS_UNDEFINED,
       SDL_WINDOWPOS_UNDEFINED,
       windowWidth, windowHeight,
-      SDL_WINDOW_OPENGL);
+      SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE); // The renderer follows the drawable size every frame
     if (window != 0) {
       SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG);
       SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
       SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
       SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
-      SDL_GLContext glContext = SDL_GL_CreateContext(window);
+      glContext = SDL_GL_CreateContext(window);
       SDL_GL_SetSwapInterval(0);
+      isReady = true;
+    }
+  }
 
-      u64 platformMemorySize = Gigabytes(1);
-      void *platformMemory = OSMemReserve(platformMemorySize);
-      OSMemCommit(platformMemory, platformMemorySize);
+  if (isReady) {
+    u64 platformMemorySize = Gigabytes(1);
+    void *platformMemory = AllocMemory(platformMemorySize, useLargePages, "platform memory");
 
-      u64 arenaSize = platformMemorySize / 2;
-      void *permArenaMemory = platformMemory;
-      void *frameArenaMemory = (u8*)platformMemory + arenaSize;
+    u64 arenaSize = platformMemorySize / 2;
+    void *permArenaMemory = platformMemory;
+    void *frameArenaMemory = (u8*)platformMemory + arenaSize;
 
-      char *basePath = SDL_GetBasePath();
-      return (PlatformState) {
-        .permanentArena = ArenaAlloc(permArenaMemory, arenaSize),
-        .frameArena = ArenaAlloc(frameArenaMemory, arenaSize),
+    char *basePath = SDL_GetBasePath();
+    return (PlatformState) {
+      .permanentArena = ArenaAlloc(permArenaMemory, arenaSize),
+      .frameArena = ArenaAlloc(frameArenaMemory, arenaSize),
 
-        .basePath = Str8C(basePath),
+      .basePath = Str8C(basePath),
+      .isHeadless = isHeadless,
 
-        .window = window,
-        .glContext = glContext,
-        };
-    }
+      .window = window,
+      .glContext = glContext,
+      };
   }
 
   return (PlatformState){0};
@@ -142,7 +276,7 @@ GetGameHandle(String8 source, String8 temp)
 
   result.dllLastWriteTime = OSGetLastWriteTime(source);
 
-  OSCopyFile((char*)source.str, (char*)temp.str);
+  OSCopyFile(source, temp);
   result.handle = SDL_LoadObject((char*)temp.str);
   if (result.handle) {
     #define X(ret, name, ...) \
@@ -165,61 +299,310 @@ ReleaseGameHandle(GameHandle *handle)
   }
 }
 
+typedef struct HeadlessChecks HeadlessChecks;
+struct HeadlessChecks
+{
+  String8 goldenDir; // Empty when not checking
+  u64 frameCount;
+  u64 checked, recorded, failed;
+};
+
+function b32
+HeadlessIsChecked(HeadlessChecks *checks, u64 frameIdx)
+{
+  b32 result = checks->goldenDir.size && (frameIdx % HEADLESS_GOLDEN_INTERVAL == 0 || frameIdx == checks->frameCount);
+  return result;
+}
+
+// Golden images live in goldenDir as frame_<index>.tga: a missing one gets recorded, a
+// different one fails the run and the frame is written next to it as frame_<index>_actual.tga.
+// The two renderers round differently, each needs its own goldenDir
+function void
+HeadlessCheckFrame(HeadlessChecks *checks, Arena *arena, u64 frameIdx, u32 *pixels)
+{
+  if (HeadlessIsChecked(checks, frameIdx)) {
+    String8 goldenDir = checks->goldenDir;
+    u64 pixelCount = HEADLESS_WIDTH * HEADLESS_HEIGHT;
+    u64 hash = HashBytes(pixels, pixelCount * sizeof(u32), HASH_DEFAULT_SEED);
+    String8 path = PushStr8F(arena, "%.*s/frame_%05llu.tga", Str8Expand(goldenDir), frameIdx);
+    u64 goldenWidth = 0, goldenHeight = 0;
+    u32 *golden = RenderSoftwareLoadImage(arena, path, &goldenWidth, &goldenHeight);
+    b32 isSameSize = goldenWidth == HEADLESS_WIDTH && goldenHeight == HEADLESS_HEIGHT;
+    if (!golden) {
+      if (RenderSoftwareSaveImage(path, pixels, HEADLESS_WIDTH, HEADLESS_HEIGHT)) {
+        LogInfo("headless frame %llu: recorded %.*s (%016llx)", frameIdx, Str8Expand(path), hash);
+        checks->recorded++;
+      } else {
+        LogError("headless frame %llu: unable to write %.*s", frameIdx, Str8Expand(path));
+        checks->failed++;
+      }
+    } else if (!isSameSize || HashBytes(golden, pixelCount * sizeof(u32), HASH_DEFAULT_SEED) != hash) {
+      u64 differing = 0;
+      for (u64 pixelIdx = 0; isSameSize && pixelIdx < pixelCount; ++pixelIdx) {
+        differing += golden[pixelIdx] != pixels[pixelIdx];
+      }
+      String8 actualPath = PushStr8F(arena, "%.*s/frame_%05llu_actual.tga", Str8Expand(goldenDir), frameIdx);
+      RenderSoftwareSaveImage(actualPath, pixels, HEADLESS_WIDTH, HEADLESS_HEIGHT);
+      LogError("headless frame %llu: differs from %.*s (%llux%llu golden, %llu pixels differ), wrote %.*s",
+               frameIdx, Str8Expand(path), goldenWidth, goldenHeight, differing, Str8Expand(actualPath));
+      checks->failed++;
+    }
+    checks->checked++;
+  }
+}
+
+// Runs the game for a fixed number of frames with idle input, so every run renders the same
+// frames. On the software renderer by default, on the sokol backend in an offscreen GL
+// context with -gl. The GL frames are read back asynchronously, only the checked ones
+// unless readbackAll. Returns the exit code
+function int
+RunHeadless(PlatformState *app, GameHandle *game, GameMemory gameMemory, RenderCommands *renderCommands,
+            u64 frameCount, String8 goldenDir, b32 readbackAll)
+{
+  HeadlessChecks checks = {0};
+  checks.goldenDir = goldenDir;
+  checks.frameCount = frameCount;
+  u32 *readbackPixels = g_isSoftwareRenderer ? 0 : ArenaPushN(app->permanentArena, u32, HEADLESS_WIDTH * HEADLESS_HEIGHT);
+
+  u64 renderNs = 0, maxRenderNs = 0, rasterNs = 0;
+  u64 runStartNs = OSNowNs();
+  for (u64 frameIdx = 1; frameIdx <= frameCount; ++frameIdx) {
+    GameInput input = {0};
+    input.tickStartNs = (frameIdx - 1) * HEADLESS_FRAME_NS;
+    input.tickEndNs = frameIdx * HEADLESS_FRAME_NS;
+    game->Update(gameMemory, input);
+    RenderCommandsBegin(renderCommands, HEADLESS_WIDTH, HEADLESS_HEIGHT);
+    game->Render(gameMemory, renderCommands);
+
+    // For GL it's the cost of submitting, the GPU catches up in the readbacks and at the end
+    u64 renderStartNs = OSNowNs();
+    if (g_isSoftwareRenderer) {
+      RenderSoftwareExecute(&g_softwareRenderer, renderCommands);
+      rasterNs += g_softwareRenderer.stats.rasterNs;
+    } else {
+      RenderBackendExecute(&g_renderer, renderCommands);
+    }
+    u64 frameRenderNs = OSNowNs() - renderStartNs;
+    renderNs += frameRenderNs;
+    maxRenderNs = Max(maxRenderNs, frameRenderNs);
+
+    if (g_isSoftwareRenderer) {
+      // The framebuffer is only missing when it couldn't be allocated
+      if (g_softwareRenderer.width == HEADLESS_WIDTH && g_softwareRenderer.height == HEADLESS_HEIGHT) {
+        HeadlessCheckFrame(&checks, app->frameArena, frameIdx, g_softwareRenderer.pixels);
+      } else {
+        LogError("headless frame %llu: no framebuffer to check", frameIdx);
+        checks.failed++;
+      }
+    }
+#if OS_LINUX
+    else {
+      // With every buffer in flight the oldest readback has to finish first
+      u64 readbackIdx = 0;
+      if (readbackAll || HeadlessIsChecked(&checks, frameIdx)) {
+        while (!RenderOffscreenReadbackBegin(&g_offscreen, frameIdx) && g_offscreen.readbackCount) {
+          if (RenderOffscreenReadbackEnd(&g_offscreen, readbackPixels, &readbackIdx, true)) {
+            HeadlessCheckFrame(&checks, app->frameArena, readbackIdx, readbackPixels);
+          }
+        }
+      }
+      while (RenderOffscreenReadbackEnd(&g_offscreen, readbackPixels, &readbackIdx, false)) {
+        HeadlessCheckFrame(&checks, app->frameArena, readbackIdx, readbackPixels);
+      }
+    }
+#endif
+
+    ArenaClear(app->frameArena);
+  }
+
+#if OS_LINUX
+  if (!g_isSoftwareRenderer) {
+    u64 readbackIdx = 0;
+    while (g_offscreen.readbackCount) {
+      if (RenderOffscreenReadbackEnd(&g_offscreen, readbackPixels, &readbackIdx, true)) {
+        HeadlessCheckFrame(&checks, app->frameArena, readbackIdx, readbackPixels);
+      }
+    }
+    glFinish();
+  }
+#endif
+  u64 runNs = OSNowNs() - runStartNs;
+
+  f32 frames = (f32)Max(frameCount, 1);
+  LogInfo("headless: %llu frames at %ux%u on %s, %.01f frames/s, render %.03fms avg, %.03fms max",
+          frameCount, HEADLESS_WIDTH, HEADLESS_HEIGHT, g_isSoftwareRenderer ? "the software renderer" : "GL",
+          frames / ((f32)runNs / (f32)OS_NS_PER_SEC), (f32)renderNs / frames / (f32)OS_NS_PER_MS,
+          (f32)maxRenderNs / (f32)OS_NS_PER_MS);
+  if (g_isSoftwareRenderer) {
+    LogInfo("headless software: %.03fms raster avg, %u threads",
+            (f32)rasterNs / frames / (f32)OS_NS_PER_MS, OSJobPoolJobCount(&g_softwareRenderer.pool));
+  }
+#if OS_LINUX
+  else {
+    RenderOffscreenStats *stats = &g_offscreen.stats;
+    LogInfo("headless readbacks: %llu, %llu stalled for %.03fms, %.03fms mapping",
+            stats->readbacks, stats->stalls, (f32)stats->waitNs / (f32)OS_NS_PER_MS, (f32)stats->mapNs / (f32)OS_NS_PER_MS);
+  }
+#endif
+  if (goldenDir.size) {
+    LogInfo("headless: %llu golden frames checked, %llu recorded, %llu failed", checks.checked, checks.recorded, checks.failed);
+  }
+
+  int result = checks.failed ? 1 : 0;
+  return result;
+}
+
+// Stops what a headless run started, the window path never started the offscreen context.
+// Safe before the renderer was initialized, its shutdown skips what never started
+function void
+ShutdownHeadless(void)
+{
+  AudioStreamerStop(&g_streamer);
+  if (g_isSoftwareRenderer) {
+    RenderSoftwareShutdown(&g_softwareRenderer);
+  } else {
+    RenderBackendShutdown(&g_renderer);
+#if OS_LINUX
+    RenderOffscreenShutdown(&g_offscreen);
+#endif
+  }
+  LoggerStop(&g_logger);
+  SDL_Quit();
+}
+
 int
-main(void)
+main(int argc, char **argv)
 {
-  PlatformState app = PlatformInit();
-  if (!app.window) {
+  OSInit();
+
+  // -largepages backs the arenas with 2MB pages (hugetlbfs if reserved, transparent huge pages otherwise)
+  // -headless renders -frames frames on the CPU without a window, checking them against -golden <dir>.
+  // With -gl (Linux only) they go through the GL backend offscreen instead, -readback reads every one back
+  b32 useLargePages = false;
+  b32 useGL = false;
+  b32 readbackAll = false;
+  u64 headlessFrames = HEADLESS_FRAMES;
+  String8 goldenDir = {0};
+  for (int argIdx = 1; argIdx < argc; ++argIdx) {
+    String8 arg = Str8C(argv[argIdx]);
+    b32 hasValue = argIdx + 1 < argc;
+    if (Str8Match(arg, Str8Lit("-largepages"), 0)) {
+      useLargePages = true;
+    } else if (Str8Match(arg, Str8Lit("-headless"), 0)) {
+      g_isHeadless = true;
+    } else if (Str8Match(arg, Str8Lit("-gl"), 0)) {
+      useGL = OS_LINUX;
+    } else if (Str8Match(arg, Str8Lit("-readback"), 0)) {
+      readbackAll = true;
+    } else if (Str8Match(arg, Str8Lit("-frames"), 0) && hasValue) {
+      argIdx++;
+      headlessFrames = (u64)SDL_strtoull(argv[argIdx], 0, 10);
+    } else if (Str8Match(arg, Str8Lit("-golden"), 0) && hasValue) {
+      argIdx++;
+      goldenDir = Str8C(argv[argIdx]);
+    }
+  }
+
+  g_isSoftwareRenderer = g_isHeadless && !useGL;
+
+  PlatformState app = PlatformInit(useLargePages, g_isHeadless);
+  if (!app.permanentArena) {
     // TODO: Logging
     return 1;
   }
-
-  // Init globals
-  g_perfFrequency = SDL_GetPerformanceFrequency();
+  ArenaTrackName(app.permanentArena, "platform perm");
+  ArenaTrackName(app.frameArena, "platform frame");
+  ArenaTrackSetOverflowFunc(DebugPrint);
+  InitAudio(&app);
 
   // Determine game path
   String8 srcPathString = {0};
   String8 tmpPathString = {0};
+  String8 logPathString = {0};
   {
     TempArena temp = ArenaTempBegin(app.permanentArena);
     String8List srcPath = {0};
     String8List tmpPath = {0};
+    String8List logPath = {0};
     Str8ListPush(temp.arena, &srcPath, app.basePath);
     Str8ListPush(temp.arena, &srcPath, Str8Lit("game.dll"));
     Str8ListPush(temp.arena, &tmpPath, app.basePath);
     Str8ListPush(temp.arena, &tmpPath, Str8Lit("game_temp.dll"));
+    Str8ListPush(temp.arena, &logPath, app.basePath);
+    Str8ListPush(temp.arena, &logPath, Str8Lit("creep.log"));
     srcPathString = Str8ListJoin(app.permanentArena, &srcPath, 0);
     tmpPathString = Str8ListJoin(app.permanentArena, &tmpPath, 0);
+    logPathString = Str8ListJoin(app.permanentArena, &logPath, 0);
     ArenaTempEnd(temp);
   }
+  LoggerStart(&g_logger, logPathString, DebugPrint);
+
+#if OS_LINUX
+  // Has to be current with its framebuffer bound before sokol_gfx is set up
+  if (g_isHeadless && !g_isSoftwareRenderer && !RenderOffscreenInit(&g_offscreen, HEADLESS_WIDTH, HEADLESS_HEIGHT)) {
+    LogError("Unable to create an offscreen GL context!");
+    ShutdownHeadless();
+    return 1;
+  }
+#endif
+
+  // The GPU state outlives game reloads, the game only fills the command buffer
+  b32 isRendererValid = g_isSoftwareRenderer ? RenderSoftwareInit(&g_softwareRenderer, app.permanentArena, RENDER_MAX_COMMANDS) :
+                                       RenderBackendInit(&g_renderer, app.permanentArena, RENDER_MAX_COMMANDS);
+  if (!isRendererValid) {
+    LogError("Unable to initialize the renderer!");
+    // A headless run is there to check what gets rendered, without a renderer it failed
+    if (g_isHeadless) {
+      ShutdownHeadless();
+      return 1;
+    }
+  }
+  RenderCommands *renderCommands = RenderCommandsAlloc(app.permanentArena, RENDER_MAX_COMMANDS);
 
   GameMemory gameMemory = {0};
   gameMemory.size = Gigabytes(4); // TODO: How much memory do we need?
-  gameMemory.mem = OSMemReserve(gameMemory.size);
-  OSMemCommit(gameMemory.mem, gameMemory.size);
+  gameMemory.mem = AllocMemory(gameMemory.size, useLargePages, "game memory");
 
-  GameInput input[2] = {0};
-  GameInput *newInput = &input[0];
-  GameInput *oldInput = &input[1];
-  GameInputSource *keyboard = &newInput->sources[0];
-  GameInputSource *oldKeyboard = &oldInput->sources[0];
+  PlatformInput platformInput;
+  PlatformInputInit(&platformInput, app.frameArena, OSNowNs());
+  PlatformGamepadThread gamepadThread = {0};
+  if (!g_isHeadless) {
+    PlatformGamepadThreadStart(&gamepadThread, app.permanentArena);
+  }
 
-  GamePayload payload;
-  payload.memory = gameMemory;
+  PlatformAPI platformAPI = {0};
+  #define X(ret, name, ...) platformAPI.name = name;
+  PLATFORM_VTABLE
+  #undef X
 
   GameHandle game = GetGameHandle(srcPathString, tmpPathString);
   if (!game.valid) {
-    DebugPrint(Str8Lit("Unable to load game code!\n"));
+    LogError("Unable to load game code!");
+    if (g_isHeadless) {
+      ShutdownHeadless();
+    } else {
+      LoggerStop(&g_logger);
+    }
     return 1;
   }
-  game.Load(true, gameMemory);
+  game.Load(true, platformAPI, gameMemory);
+
+  if (g_isHeadless) {
+    int exitCode = RunHeadless(&app, &game, gameMemory, renderCommands, headlessFrames, goldenDir, readbackAll);
+    ShutdownHeadless();
+    return exitCode;
+  }
+
+  // Vsync is off so we control when we present, see OSFramePacerWait
+  OSFramePacer pacer;
+  OSFramePacerInit(&pacer, GetWindowRefresh(app.window));
 
   for (;!app.terminated;) {
     u64 newWriteTime = OSGetLastWriteTime(srcPathString);
     if (newWriteTime != game.dllLastWriteTime) {
       ReleaseGameHandle(&game);
       game = GetGameHandle(srcPathString, tmpPathString);
-      game.Load(false, gameMemory);
+      game.Load(false, platformAPI, gameMemory);
     }
 
     // Poll events
@@ -231,21 +614,21 @@ main(void)
           SDL_KeyboardEvent *keyEvent = (SDL_KeyboardEvent*)&event;
           if (!keyEvent->repeat) {
             b32 isDown = (keyEvent->state == SDL_PRESSED);
+            u64 timestampNs = GetEventTimeNs(keyEvent->timestamp);
             switch (keyEvent->keysym.sym) {
-              // TODO: Pretty hacky?
-              case SDLK_UP: fallthrough
-              case SDLK_w: if (isDown) ++keyboard->yAxis; else --keyboard->yAxis; break;
-              case SDLK_LEFT: fallthrough
-              case SDLK_a: if (isDown) --keyboard->xAxis; else ++keyboard->xAxis; break;
-              case SDLK_DOWN: fallthrough
-              case SDLK_s: if (isDown) --keyboard->yAxis; else ++keyboard->yAxis; break;
-              case SDLK_RIGHT: fallthrough
-              case SDLK_d: if (isDown) ++keyboard->xAxis; else --keyboard->xAxis; break;
-
-              case SDLK_q: ProcessInput(&oldKeyboard->primary, &keyboard->primary, isDown); break;
-              case SDLK_e: ProcessInput(&oldKeyboard->secondary, &keyboard->secondary, isDown); break;
-              case SDLK_r: ProcessInput(&oldKeyboard->tertiary, &keyboard->tertiary, isDown); break;
-              case SDLK_t: ProcessInput(&oldKeyboard->quaternary, &keyboard->quaternary, isDown); break;
+              case SDLK_w:     PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Up, 1, isDown, timestampNs); break;
+              case SDLK_a:     PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Left, 1, isDown, timestampNs); break;
+              case SDLK_s:     PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Down, 1, isDown, timestampNs); break;
+              case SDLK_d:     PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Right, 1, isDown, timestampNs); break;
+              case SDLK_UP:    PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Up, 2, isDown, timestampNs); break;
+              case SDLK_LEFT:  PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Left, 2, isDown, timestampNs); break;
+              case SDLK_DOWN:  PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Down, 2, isDown, timestampNs); break;
+              case SDLK_RIGHT: PlatformInputPushDirKey(&platformInput, PlatformKeyboardDir_Right, 2, isDown, timestampNs); break;
+
+              case SDLK_q: PlatformInputPushButton(&platformInput, 0, 0, isDown, timestampNs); break;
+              case SDLK_e: PlatformInputPushButton(&platformInput, 0, 1, isDown, timestampNs); break;
+              case SDLK_r: PlatformInputPushButton(&platformInput, 0, 2, isDown, timestampNs); break;
+              case SDLK_t: PlatformInputPushButton(&platformInput, 0, 3, isDown, timestampNs); break;
             }
           }
         } break;
@@ -256,16 +639,68 @@ main(void)
       }
     }
 
-    payload.input = *newInput;
-    game.Update(&payload);
-    game.Render(&payload);
+    int frameWidth, frameHeight;
+    SDL_GL_GetDrawableSize(app.window, &frameWidth, &frameHeight);
+    PlatformInputLatchGamepads(&platformInput, &gamepadThread);
+    GameInput input = PlatformInputEnd(&platformInput, OSNowNs());
+    game.Update(gameMemory, input);
+    RenderCommandsBegin(renderCommands, frameWidth, frameHeight);
+    game.Render(gameMemory, renderCommands);
+    RenderBackendExecute(&g_renderer, renderCommands);
 
     // Present renderer
+    OSFramePacerWait(&pacer);
     SDL_GL_SwapWindow(app.window);
+    OSFramePacerMarkPresent(&pacer);
+    PlatformInputMarkPresent(&platformInput, &input, pacer.lastPresentNs);
+    RenderBackendUpdateScale(&g_renderer, pacer.workNs, pacer.targetNs);
+
+#if _DEBUG
+    if (pacer.intervalCount && (pacer.intervalCount % OS_FRAME_HISTORY) == 0) {
+      OSFrameStats stats = OSFramePacerStats(&pacer);
+      LogInfo("ms/frame: %.02fms avg, %.02f-%.02fms, %.03fms jitter, %llu missed (target %.02fms)",
+              stats.meanMs, stats.minMs, stats.maxMs, stats.jitterMs, stats.missed, stats.targetMs);
+      String8 latency = PlatformInputLatencyReport(&platformInput, app.frameArena);
+      if (latency.size) {
+        LogInfoLines(latency);
+      }
+      MixerStats mixerStats = MixerGetStats(&g_mixer);
+      LogInfo("mixer: %.03fms last, %.03fms max, %llu voices (%llu virtual), %llu dropped commands",
+              (f32)mixerStats.lastRenderNs / (f32)OS_NS_PER_MS, (f32)mixerStats.maxRenderNs / (f32)OS_NS_PER_MS,
+              mixerStats.activeVoices, mixerStats.virtualVoices, mixerStats.droppedCommands);
+      RenderStats renderStats = g_renderer.stats;
+      LogInfo("render: %llu commands (%llu dropped, %llu culled), sort %.03fms in %u passes, %llu state changes, %llu batches, "
+              "%llu merged into %llu draws, %llu sprites in %llu instanced draws, %llu tilemap chunks (%llu built)",
+              renderStats.commandCount, renderStats.droppedCommands, renderStats.culledCommands, (f32)renderStats.sortNs / (f32)OS_NS_PER_MS,
+              renderStats.sortPasses, renderStats.stateChanges, renderStats.batches, renderStats.mergedDraws,
+              renderStats.gpuDraws, renderStats.sprites, renderStats.spriteDraws, renderStats.chunksDrawn,
+              renderStats.chunksBuilt);
+      LogInfo("render stream: %llu vertices in %llu flushes over %llu buffers, %llu peak, %llu capacity",
+              renderStats.vertices, renderStats.flushes, renderStats.vertexBuffers, renderStats.peakVertices,
+              renderStats.vertexCapacity);
+      LogInfo("render layer cache: %llu composited, %llu redrawn, %llu evicted, %.01fMB",
+              renderStats.layersComposited, renderStats.layersRedrawn, renderStats.layerEvictions,
+              (f32)renderStats.layerCacheBytes / (f32)Megabytes(1));
+      LogInfo("render scale: %.02f, %llux%llu, %.02fms frame cost",
+              renderStats.scale, renderStats.renderWidth, renderStats.renderHeight,
+              (f32)pacer.workNs / (f32)OS_NS_PER_MS);
+      String8 memoryReport = ArenaTrackReport(app.frameArena);
+      if (memoryReport.size) {
+        LogInfoLines(memoryReport);
+      }
+    }
+#endif
 
-    Swap(GameInput*, newInput, oldInput);
     ArenaClear(app.frameArena);
+    ArenaTrackFrameEnd();
+  }
+  PlatformGamepadThreadStop(&gamepadThread);
+  if (app.audioDevice) {
+    SDL_CloseAudioDevice(app.audioDevice);
   }
+  AudioStreamerStop(&g_streamer);
+  RenderBackendShutdown(&g_renderer);
+  LoggerStop(&g_logger);
   SDL_Quit();
   return 0;
 }
\ No newline at end of file
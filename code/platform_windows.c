@@ -3,12 +3,32 @@
 #include <gl/gl.h>
 #include <wglext.h>
 #include "base/base_include.h"
+#include "os/os.h"
+#include "render/render.h"
 #include "game.h"
+#include "audio/audio_include.h"
+#include "log/logger.h"
+#include "render/render_sort.h"
+#include "render/render_sokol.h"
 
 // Source
+#define SOKOL_IMPL
+#define SOKOL_DEBUG
+#define SOKOL_GLCORE33
+#include <sokol/sokol_log.h>
+#include <sokol/sokol_gfx.h>
+#include <sokol/sokol_gp.h>
+
 #define STB_SPRINTF_IMPLEMENTATION
 #include <stb/stb_sprintf.h>
 #include "base/base_include.c"
+#include "os/os_include.c"
+#include "platform_input.c"
+#include "audio/audio_include.c"
+#include "log/logger.c"
+#include "render/render.c"
+#include "render/render_sort.c"
+#include "render/render_sokol.c"
 
 typedef struct Win32GameHandle Win32GameHandle;
 struct Win32GameHandle
@@ -28,18 +48,40 @@ struct Win32Window
   RECT dim;
 };
 
+// waveOut from winmm: a thread of its own keeps a few buffers queued, refilling each from
+// the mixer as the device hands it back
+#define WIN32_AUDIO_BUFFERS 3
+#define WIN32_AUDIO_FRAMES  512 // Per buffer
+
+typedef struct Win32Audio Win32Audio;
+struct Win32Audio
+{
+  HWAVEOUT device;
+  HANDLE bufferDone; // Signalled by the device whenever it's done with a buffer
+  WAVEHDR headers[WIN32_AUDIO_BUFFERS];
+  s16 *samples; // The buffers back to back, interleaved stereo
+  f32 *mix;     // One buffer as the mixer writes it
+  volatile u64 running;
+  OSThread thread;
+};
+
 typedef struct Win32State Win32State;
 struct Win32State
 {
   Win32Window window;
   HDC dc;
   HGLRC glContext;
-  u64 perfFrequency;
+  b32 hasVsync;
 };
 
 global Win32State globalState;
 global b32 globalGameRunning = true;
-global GameInput globalGameInput[2];
+global PlatformInput globalInput;
+global Mixer globalMixer;
+global Win32Audio globalAudio;
+global AudioStreamer globalStreamer;
+global Logger globalLogger;
+global RenderBackend globalRenderer;
 
 // Public API
 
@@ -49,58 +91,173 @@ DebugPrint(String8 msg)
   OutputDebugString((LPCSTR)msg.str);
 }
 
+extern u64
+AudioPlay(GameSound *sound, f32 volume, b32 isLooping)
+{
+  return MixerPlay(&globalMixer, sound, volume, isLooping);
+}
+
+extern u64
+AudioPlayStream(String8 path, f32 volume, b32 isLooping)
+{
+  AudioStream *stream = AudioStreamOpen(&globalStreamer, path, isLooping);
+  u64 result = MixerPlayStream(&globalMixer, stream, volume);
+  if (stream && !result) {
+    AudioStreamRelease(stream);
+  }
+
+  return result;
+}
+
+extern void
+AudioStop(u64 voice)
+{
+  MixerStop(&globalMixer, voice);
+}
+
+extern void
+AudioSetVolume(u64 voice, f32 volume)
+{
+  MixerSetVolume(&globalMixer, voice, volume);
+}
+
+extern RenderTexture
+RenderTextureCreate(u32 width, u32 height, void *pixels)
+{
+  return RenderBackendTextureCreate(&globalRenderer, width, height, pixels);
+}
+
 // Internal functions
 
 function void
-Win32CopyFile(char *src, char *dest)
+Win32AudioFill(Win32Audio *audio, WAVEHDR *header)
 {
-  CopyFile(src, dest, false);
+  MixerRender(&globalMixer, audio->mix, WIN32_AUDIO_FRAMES);
+  s16 *samples = (s16*)header->lpData;
+  for (u32 sampleIdx = 0; sampleIdx < WIN32_AUDIO_FRAMES * 2; ++sampleIdx) {
+    samples[sampleIdx] = (s16)(Clamp(audio->mix[sampleIdx], -1.f, 1.f) * 32767.f);
+  }
+  waveOutWrite(audio->device, header, sizeof(WAVEHDR));
 }
 
-function FILETIME
-Win32GetLastWriteTime(String8 path)
+function void
+Win32AudioThreadProc(void *param)
 {
-  FILETIME result = {0};
+  Win32Audio *audio = (Win32Audio*)param;
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+  while (AtomicLoadU64(&audio->running)) {
+    WaitForSingleObject(audio->bufferDone, 100);
+    for (u32 bufferIdx = 0; bufferIdx < WIN32_AUDIO_BUFFERS; ++bufferIdx) {
+      WAVEHDR *header = &audio->headers[bufferIdx];
+      if ((header->dwFlags & WHDR_DONE) && AtomicLoadU64(&audio->running)) {
+        Win32AudioFill(audio, header);
+      }
+    }
+  }
+}
 
-  WIN32_FIND_DATA fileData;
-  HANDLE fileHandle = FindFirstFile((LPCSTR)path.str, &fileData);
-  if (fileHandle != INVALID_HANDLE_VALUE) {
-    result = fileData.ftLastWriteTime;
-    FindClose(fileHandle);
+// No device leaves the mixer inactive, sounds then play silently
+function b32
+Win32AudioStart(Win32Audio *audio, Arena *arena)
+{
+  WAVEFORMATEX format = {0};
+  format.wFormatTag = WAVE_FORMAT_PCM;
+  format.nChannels = 2;
+  format.nSamplesPerSec = GAME_AUDIO_SAMPLE_RATE;
+  format.wBitsPerSample = 16;
+  format.nBlockAlign = format.nChannels * format.wBitsPerSample / 8;
+  format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+
+  u64 bufferBytes = WIN32_AUDIO_FRAMES * format.nBlockAlign;
+  audio->samples = ArenaPushN(arena, s16, WIN32_AUDIO_BUFFERS * WIN32_AUDIO_FRAMES * 2);
+  audio->mix = ArenaPushN(arena, f32, WIN32_AUDIO_FRAMES * 2);
+  audio->bufferDone = CreateEventA(0, FALSE, FALSE, 0);
+  b32 result = audio->samples && audio->mix && audio->bufferDone &&
+               waveOutOpen(&audio->device, WAVE_MAPPER, &format, (DWORD_PTR)audio->bufferDone, 0, CALLBACK_EVENT) == MMSYSERR_NOERROR;
+  if (result) {
+    globalMixer.isActive = true;
+    for (u32 bufferIdx = 0; bufferIdx < WIN32_AUDIO_BUFFERS; ++bufferIdx) {
+      WAVEHDR *header = &audio->headers[bufferIdx];
+      header->lpData = (LPSTR)(audio->samples + bufferIdx * WIN32_AUDIO_FRAMES * 2);
+      header->dwBufferLength = (DWORD)bufferBytes;
+      waveOutPrepareHeader(audio->device, header, sizeof(WAVEHDR));
+      Win32AudioFill(audio, header);
+    }
+    audio->running = 1;
+    audio->thread = OSThreadLaunch(Win32AudioThreadProc, audio);
+  } else {
+    audio->device = 0;
   }
 
   return result;
 }
 
-function void*
-Win32MemReserve(u64 size)
+function void
+Win32AudioStop(Win32Audio *audio)
 {
-  return VirtualAlloc(0, size, MEM_RESERVE, PAGE_READWRITE);
+  if (audio->device) {
+    AtomicStoreU64(&audio->running, 0);
+    SetEvent(audio->bufferDone);
+    OSThreadJoin(audio->thread);
+    waveOutReset(audio->device);
+    for (u32 bufferIdx = 0; bufferIdx < WIN32_AUDIO_BUFFERS; ++bufferIdx) {
+      waveOutUnprepareHeader(audio->device, &audio->headers[bufferIdx], sizeof(WAVEHDR));
+    }
+    waveOutClose(audio->device);
+    audio->device = 0;
+  }
+  if (audio->bufferDone) {
+    CloseHandle(audio->bufferDone);
+    audio->bufferDone = 0;
+  }
 }
 
-function void
-Win32MemCommit(void *ptr, u64 size)
+function void*
+Win32AllocMemory(u64 size, b32 useLargePages, char *name)
 {
-  VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE);
+  void *result = 0;
+  if (useLargePages) {
+    u64 pageSize;
+    result = OSMemAllocLarge(size, &pageSize);
+    char message[128];
+    stbsp_snprintf(message, sizeof(message), "%s: %lluMB on %lluKB pages\n", name, size >> 20, pageSize >> 10);
+    DebugPrint(Str8C(message));
+  } else {
+    result = OSMemReserve(size);
+    OSMemCommit(result, size);
+  }
+
+  return result;
 }
 
 function void
-Win32MemDecommit(void *ptr, u64 size)
+Win32CopyFile(char *src, char *dest)
 {
-  VirtualFree(ptr, size, MEM_DECOMMIT);
+  CopyFile(src, dest, false);
 }
 
-function void
-Win32MemRelease(void *ptr, u64 size)
+function FILETIME
+Win32GetLastWriteTime(String8 path)
 {
-  VirtualFree(ptr, size, MEM_RELEASE);
+  FILETIME result = {0};
+
+  WIN32_FIND_DATA fileData;
+  HANDLE fileHandle = FindFirstFile((LPCSTR)path.str, &fileData);
+  if (fileHandle != INVALID_HANDLE_VALUE) {
+    result = fileData.ftLastWriteTime;
+    FindClose(fileHandle);
+  }
+
+  return result;
 }
 
-function void
-Win32ProcessInput(GameButtonState *oldState, GameButtonState *newState, b32 isDown)
+function u32
+Win32GetWindowRefresh(HDC dc)
 {
-  newState->isDown = isDown;
-  newState->halfTransitionCount = (oldState->isDown != newState->isDown) ? 1 : 0;
+  int refreshRate = GetDeviceCaps(dc, VREFRESH);
+  u32 result = refreshRate > 1 ? refreshRate : 60; // 0 and 1 mean "hardware default"
+
+  return result;
 }
 
 function LRESULT CALLBACK
@@ -120,25 +277,25 @@ Win32WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
     case WM_KEYUP: fallthrough
     case WM_KEYDOWN: {
-      GameInput *newInput = &globalGameInput[0];
-      GameInput *oldInput = &globalGameInput[1];
-      GameInputSource *keyboard = &newInput->sources[0];
-      GameInputSource *oldKeyboard = &oldInput->sources[0];
-
+      // GetMessageTime only has GetTickCount resolution (~16ms), so stamp on dispatch instead
+      u64 timestampNs = OSNowNs();
       b32 isDown = ((lParam & (1 << 31)) == 0);
       b32 wasDown = ((lParam & (1 << 30)) != 0);
       if (isDown != wasDown) {
         switch (wParam) {
-          // TODO: I'm too stupid to add arrow key support without doubling the move speed if you press both @ same time
-          case 'W': if (isDown) keyboard->yAxis++; else keyboard->yAxis--; break;
-          case 'A': if (isDown) keyboard->xAxis--; else keyboard->xAxis++; break;
-          case 'S': if (isDown) keyboard->yAxis--; else keyboard->yAxis++; break;
-          case 'D': if (isDown) keyboard->xAxis++; else keyboard->xAxis--; break;
-
-          case 'Q': Win32ProcessInput(&oldKeyboard->primary, &oldKeyboard->primary, isDown); break;
-          case 'E': Win32ProcessInput(&oldKeyboard->secondary, &oldKeyboard->secondary, isDown); break;
-          case 'R': Win32ProcessInput(&oldKeyboard->tertiary, &oldKeyboard->tertiary, isDown); break;
-          case 'T': Win32ProcessInput(&oldKeyboard->quaternary, &oldKeyboard->quaternary, isDown); break;
+          case 'W':      PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Up, 1, isDown, timestampNs); break;
+          case 'A':      PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Left, 1, isDown, timestampNs); break;
+          case 'S':      PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Down, 1, isDown, timestampNs); break;
+          case 'D':      PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Right, 1, isDown, timestampNs); break;
+          case VK_UP:    PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Up, 2, isDown, timestampNs); break;
+          case VK_LEFT:  PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Left, 2, isDown, timestampNs); break;
+          case VK_DOWN:  PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Down, 2, isDown, timestampNs); break;
+          case VK_RIGHT: PlatformInputPushDirKey(&globalInput, PlatformKeyboardDir_Right, 2, isDown, timestampNs); break;
+
+          case 'Q': PlatformInputPushButton(&globalInput, 0, 0, isDown, timestampNs); break;
+          case 'E': PlatformInputPushButton(&globalInput, 0, 1, isDown, timestampNs); break;
+          case 'R': PlatformInputPushButton(&globalInput, 0, 2, isDown, timestampNs); break;
+          case 'T': PlatformInputPushButton(&globalInput, 0, 3, isDown, timestampNs); break;
         }
       }
 
@@ -208,11 +365,6 @@ Win32Init(Arena *arena, HINSTANCE hInstance, int nCmdShow)
   globalState.dc = GetDC(globalState.window.handle);
 
   if (globalState.window.handle) {
-    // Obtain performance frequency
-    LARGE_INTEGER perfFrequency;
-    QueryPerformanceFrequency(&perfFrequency);
-    globalState.perfFrequency = perfFrequency.QuadPart;
-
     // Create OpenGL context
     PIXELFORMATDESCRIPTOR pfd = {0};
     pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
@@ -246,10 +398,12 @@ Win32Init(Arena *arena, HINSTANCE hInstance, int nCmdShow)
     }
     if (hasVsync) {
       PFNWGLSWAPINTERVALEXTPROC wglSwapIntervalEXT = (PFNWGLSWAPINTERVALEXTPROC)wglGetProcAddress("wglSwapIntervalEXT");
-      wglSwapIntervalEXT(1);
-    } else {
-      DebugPrint(Str8Lit("This machine does not support vsync!\n"));
+      hasVsync = wglSwapIntervalEXT(1);
+    }
+    if (!hasVsync) {
+      DebugPrint(Str8Lit("This machine does not support vsync, falling back to the frame limiter!\n"));
     }
+    globalState.hasVsync = hasVsync;
   }
 
   ShowWindow(globalState.window.handle, nCmdShow);
@@ -275,37 +429,56 @@ ThreadProc(LPVOID lpParameter)
 int WINAPI
 WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR lpCmdLine, int nCmdShow)
 {
-  Unused(hPrevInstance && lpCmdLine);
+  Unused(hPrevInstance);
+  OSInit();
+
+  // -largepages backs the arenas with 2MB pages, the account needs the "Lock pages in memory" right
+  String8 cmdLine = Str8C(lpCmdLine);
+  b32 useLargePages = (Str8Find(cmdLine, Str8Lit("-largepages"), 0, 0) < cmdLine.size);
 
   u64 backingBufferSize = Gigabytes(1);
-  void *backingBuffer = Win32MemReserve(backingBufferSize);
-  Win32MemCommit(backingBuffer, backingBufferSize);
+  void *backingBuffer = Win32AllocMemory(backingBufferSize, useLargePages, "platform memory");
   Arena *platformArena = ArenaAlloc(backingBuffer, backingBufferSize);
+  ArenaTrackName(platformArena, "platform");
+  ArenaTrackSetOverflowFunc(DebugPrint);
+  PlatformInputInit(&globalInput, platformArena, OSNowNs());
+  MixerInit(&globalMixer, platformArena);
+  AudioStreamerStart(&globalStreamer, platformArena);
+  if (!Win32AudioStart(&globalAudio, platformArena)) {
+    DebugPrint(Str8Lit("Unable to open an audio device!\n"));
+  }
 
   if (!Win32Init(platformArena, hInstance, nCmdShow)) {
     DebugPrint(Str8Lit("Unable to initialize Win32 platform layer!\n"));
   }
 
+  // The GPU state outlives game reloads, the game only fills the command buffer
+  if (!RenderBackendInit(&globalRenderer, platformArena, RENDER_MAX_COMMANDS)) {
+    DebugPrint(Str8Lit("Unable to initialize the renderer!\n"));
+  }
+  RenderCommands *renderCommands = RenderCommandsAlloc(platformArena, RENDER_MAX_COMMANDS);
+
   String8 gameDllPath = {0};
   String8 gameTempDllPath = {0};
+  String8 logPath = {0};
   {
-    TempArena temp = ArenaTempBegin(platformArena);
+    // The paths live for the whole run, so they stay in the platform arena
     char filenameCStr[MAX_PATH];
     GetModuleFileName(0, filenameCStr, sizeof(filenameCStr)); // TODO: Apparently max path is unsafe, good thing this is debug code
     String8 filename = Str8C(filenameCStr);
 
     u8 splits[] = { '\\' };
-    String8List path = Str8Split(temp.arena, filename, 1, splits);
-    String8List tmpPath = Str8Split(temp.arena, filename, 1, splits);
-    path.last->string = Str8Lit("game.dll");
-    tmpPath.last->string = Str8Lit("game_temp.dll");
-
+    String8List path = Str8Split(platformArena, filename, 1, splits);
     String8Join joinOpts = {0};
     joinOpts.sep = Str8Lit("\\");
-    gameDllPath = Str8ListJoin(temp.arena, &path, &joinOpts);
-    gameTempDllPath = Str8ListJoin(temp.arena, &tmpPath, &joinOpts);
-    ArenaTempEnd(temp);
+    path.last->string = Str8Lit("game.dll");
+    gameDllPath = Str8ListJoin(platformArena, &path, &joinOpts);
+    path.last->string = Str8Lit("game_temp.dll");
+    gameTempDllPath = Str8ListJoin(platformArena, &path, &joinOpts);
+    path.last->string = Str8Lit("creep.log");
+    logPath = Str8ListJoin(platformArena, &path, &joinOpts);
   }
+  LoggerStart(&globalLogger, logPath, DebugPrint);
 
   PlatformAPI platformAPI = {0};
   #define X(ret, name, ...) platformAPI.name = name;
@@ -314,18 +487,19 @@ WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR lpCmdLine, int nCmdSh
 
   GameMemory gameMemory = {0};
   gameMemory.size = Gigabytes(4); // TODO: Change?
-  gameMemory.mem = Win32MemReserve(gameMemory.size);
-  Win32MemCommit(gameMemory.mem, gameMemory.size);
-
-  GameInput *newInput = &globalGameInput[0];
-  GameInput *oldInput = &globalGameInput[1];
+  gameMemory.mem = Win32AllocMemory(gameMemory.size, useLargePages, "game memory");
 
   Win32GameHandle game;
   Assert(Win32GetGameHandle(&game, gameDllPath, gameTempDllPath));
   game.Load(true, platformAPI, gameMemory);
 
-  LARGE_INTEGER lastCounter, endCounter;
-  QueryPerformanceCounter(&lastCounter);
+  PlatformGamepadThread gamepadThread;
+  PlatformGamepadThreadStart(&gamepadThread, platformArena);
+
+  // Vsync paces us when we have it, otherwise sleep/spin up to the display's refresh rate
+  OSFramePacer pacer;
+  OSFramePacerInit(&pacer, Win32GetWindowRefresh(globalState.dc));
+
   for (;globalGameRunning;) {
     TempArena frameArena = ArenaTempBegin(platformArena);
     // TODO: Reload game code
@@ -345,21 +519,64 @@ WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR lpCmdLine, int nCmdSh
       DispatchMessage(&msg);
     }
 
-    game.Update(gameMemory, *newInput);
-    game.Render(gameMemory, globalState.window.dim.right, globalState.window.dim.bottom);
+    PlatformInputLatchGamepads(&globalInput, &gamepadThread);
+    GameInput input = PlatformInputEnd(&globalInput, OSNowNs());
+    game.Update(gameMemory, input);
+    RenderCommandsBegin(renderCommands, globalState.window.dim.right, globalState.window.dim.bottom);
+    game.Render(gameMemory, renderCommands);
+    RenderBackendExecute(&globalRenderer, renderCommands);
 
+    if (!globalState.hasVsync) {
+      OSFramePacerWait(&pacer);
+    }
     SwapBuffers(globalState.dc);
-    Swap(GameInput*, newInput, oldInput);
-
-    QueryPerformanceCounter(&endCounter);
-#if 0
-    f32 elapsedMS = (f32)(endCounter.QuadPart - lastCounter.QuadPart) * 1000.f;
-    elapsedMS /= (f32)globalState.perfFrequency;
-    lastCounter = endCounter;
-    DebugPrint(PushStr8F(frameArena.arena, "ms/frame: %.02fms\n", elapsedMS)); // For some reason this value seems off...
+    OSFramePacerMarkPresent(&pacer);
+    PlatformInputMarkPresent(&globalInput, &input, pacer.lastPresentNs);
+
+    // With vsync the swap blocks, which hides how long the frame took, so the scale stays put
+    if (!globalState.hasVsync) {
+      RenderBackendUpdateScale(&globalRenderer, pacer.workNs, pacer.targetNs);
+    }
+
+#if _DEBUG
+    if (pacer.intervalCount && (pacer.intervalCount % OS_FRAME_HISTORY) == 0) {
+      OSFrameStats stats = OSFramePacerStats(&pacer);
+      LogInfo("ms/frame: %.02fms avg, %.02f-%.02fms, %.03fms jitter, %llu missed (target %.02fms)",
+              stats.meanMs, stats.minMs, stats.maxMs, stats.jitterMs, stats.missed, stats.targetMs);
+      String8 latency = PlatformInputLatencyReport(&globalInput, frameArena.arena);
+      if (latency.size) {
+        LogInfoLines(latency);
+      }
+      RenderStats renderStats = globalRenderer.stats;
+      LogInfo("render: %llu commands (%llu dropped, %llu culled), sort %.03fms in %u passes, %llu state changes, %llu batches, "
+              "%llu merged into %llu draws, %llu sprites in %llu instanced draws, %llu tilemap chunks (%llu built)",
+              renderStats.commandCount, renderStats.droppedCommands, renderStats.culledCommands, (f32)renderStats.sortNs / (f32)OS_NS_PER_MS,
+              renderStats.sortPasses, renderStats.stateChanges, renderStats.batches, renderStats.mergedDraws,
+              renderStats.gpuDraws, renderStats.sprites, renderStats.spriteDraws, renderStats.chunksDrawn,
+              renderStats.chunksBuilt);
+      LogInfo("render stream: %llu vertices in %llu flushes over %llu buffers, %llu peak, %llu capacity",
+              renderStats.vertices, renderStats.flushes, renderStats.vertexBuffers, renderStats.peakVertices,
+              renderStats.vertexCapacity);
+      LogInfo("render layer cache: %llu composited, %llu redrawn, %llu evicted, %.01fMB",
+              renderStats.layersComposited, renderStats.layersRedrawn, renderStats.layerEvictions,
+              (f32)renderStats.layerCacheBytes / (f32)Megabytes(1));
+      LogInfo("render scale: %.02f, %llux%llu, %.02fms frame cost",
+              renderStats.scale, renderStats.renderWidth, renderStats.renderHeight,
+              (f32)pacer.workNs / (f32)OS_NS_PER_MS);
+      String8 memoryReport = ArenaTrackReport(frameArena.arena);
+      if (memoryReport.size) {
+        LogInfoLines(memoryReport);
+      }
+    }
 #endif
     ArenaTempEnd(frameArena);
+    ArenaTrackFrameEnd();
   }
 
+  PlatformGamepadThreadStop(&gamepadThread);
+  Win32AudioStop(&globalAudio);
+  AudioStreamerStop(&globalStreamer);
+  RenderBackendShutdown(&globalRenderer);
+  LoggerStop(&globalLogger);
   return 0;
 }
\ No newline at end of file
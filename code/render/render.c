@@ -0,0 +1,271 @@
+// Platform
+
+function RenderCommands*
+RenderCommandsAlloc(Arena *arena, u64 capacity)
+{
+  Assert(capacity <= (1ull << RENDER_KEY_INDEX_BITS));
+  RenderCommands *result = ArenaPushN(arena, RenderCommands, 1);
+  result->keys = ArenaPush(arena, capacity * sizeof(u64), CACHE_LINE_SIZE);
+  result->commands = ArenaPush(arena, capacity * sizeof(RenderCommand), CACHE_LINE_SIZE);
+  result->capacity = capacity;
+  return result;
+}
+
+function void
+RenderCommandsBegin(RenderCommands *commands, u64 frameWidth, u64 frameHeight)
+{
+  if (commands->frameWidth != frameWidth || commands->frameHeight != frameHeight) {
+    MemoryZeroArray(commands->validLayers);
+  }
+  commands->frameWidth = frameWidth;
+  commands->frameHeight = frameHeight;
+  commands->clearColor = 0;
+  RenderSetCamera(commands, (f32)frameWidth * 0.5f, (f32)frameHeight * 0.5f, 1.f);
+  commands->layer = 0;
+  commands->depth = 0;
+  commands->blend = RenderBlend_Alpha;
+  MemoryZeroArray(commands->cachedLayers);
+  MemoryZeroArray(commands->redrawnLayers);
+  commands->count = 0;
+  commands->dropped = 0;
+  commands->culled = 0;
+}
+
+function u64
+RenderKey(u8 layer, u16 depth, RenderPipeline pipeline, RenderBlend blend, u32 texture, u64 index)
+{
+  u64 result = ((u64)layer << RENDER_KEY_LAYER_SHIFT) |
+               ((u64)depth << RENDER_KEY_DEPTH_SHIFT) |
+               (((u64)pipeline & RenderKeyMask(RENDER_KEY_PIPELINE_BITS)) << RENDER_KEY_PIPELINE_SHIFT) |
+               (((u64)blend & RenderKeyMask(RENDER_KEY_BLEND_BITS)) << RENDER_KEY_BLEND_SHIFT) |
+               (((u64)texture & RenderKeyMask(RENDER_KEY_TEXTURE_BITS)) << RENDER_KEY_TEXTURE_SHIFT) |
+               (index & RENDER_KEY_INDEX_MASK);
+  return result;
+}
+
+// Game
+
+function RenderColor
+RenderColorRGBA(f32 r, f32 g, f32 b, f32 a)
+{
+  RenderColor result = ((u32)(Clamp(r, 0.f, 1.f) * 255.f + 0.5f) << 0) |
+                       ((u32)(Clamp(g, 0.f, 1.f) * 255.f + 0.5f) << 8) |
+                       ((u32)(Clamp(b, 0.f, 1.f) * 255.f + 0.5f) << 16) |
+                       ((u32)(Clamp(a, 0.f, 1.f) * 255.f + 0.5f) << 24);
+  return result;
+}
+
+function void
+RenderSetCamera(RenderCommands *commands, f32 x, f32 y, f32 zoom)
+{
+  Assert(zoom > 0.f);
+  f32 halfWidth = (f32)commands->frameWidth * 0.5f / zoom;
+  f32 halfHeight = (f32)commands->frameHeight * 0.5f / zoom;
+  commands->cameraX = x;
+  commands->cameraY = y;
+  commands->zoom = zoom;
+  commands->viewX0 = x - halfWidth;
+  commands->viewY0 = y - halfHeight;
+  commands->viewX1 = x + halfWidth;
+  commands->viewY1 = y + halfHeight;
+}
+
+function b32
+RenderIsVisible(RenderCommands *commands, f32 x0, f32 y0, f32 x1, f32 y1)
+{
+  b32 result = Min(x0, x1) < commands->viewX1 && Max(x0, x1) > commands->viewX0 &&
+               Min(y0, y1) < commands->viewY1 && Max(y0, y1) > commands->viewY0;
+  if (!result) {
+    commands->culled++;
+  }
+
+  return result;
+}
+
+function void
+RenderSetLayer(RenderCommands *commands, u8 layer)
+{
+  commands->layer = layer;
+}
+
+function void
+RenderSetDepth(RenderCommands *commands, u16 depth)
+{
+  commands->depth = depth;
+}
+
+function void
+RenderSetBlend(RenderCommands *commands, RenderBlend blend)
+{
+  Assert(blend < RenderBlend_Count);
+  commands->blend = blend;
+}
+
+function b32
+RenderCacheLayer(RenderCommands *commands, u8 layer, b32 isDirty)
+{
+  u64 bit = 1ull << (layer & 63);
+  b32 result = isDirty || !(commands->validLayers[layer >> 6] & bit);
+  commands->cachedLayers[layer >> 6] |= bit;
+  if (result) {
+    commands->redrawnLayers[layer >> 6] |= bit;
+  }
+  commands->layer = layer;
+  return result;
+}
+
+function RenderCommand*
+RenderPush(RenderCommands *commands, RenderCommandKind kind, RenderTexture texture, RenderColor color)
+{
+  RenderCommand *result = 0;
+  if (commands->count < commands->capacity) {
+    u64 index = commands->count++;
+    RenderPipeline pipeline = kind == RenderCommand_Line ? RenderPipeline_Lines :
+                              kind == RenderCommand_Sprite ? RenderPipeline_Sprites :
+                              kind == RenderCommand_Tilemap ? RenderPipeline_Tilemap : RenderPipeline_Triangles;
+    commands->keys[index] = RenderKey(commands->layer, commands->depth, pipeline, commands->blend, texture, index);
+    result = &commands->commands[index];
+    result->kind = kind;
+    result->color = color;
+  } else {
+    commands->dropped++;
+  }
+
+  return result;
+}
+
+function void
+RenderClear(RenderCommands *commands, RenderColor color)
+{
+  commands->clearColor = color;
+}
+
+function void
+RenderRect(RenderCommands *commands, f32 x, f32 y, f32 w, f32 h, RenderColor color)
+{
+  RenderCommand *command = 0;
+  if (RenderIsVisible(commands, x, y, x + w, y + h)) {
+    command = RenderPush(commands, RenderCommand_Rect, 0, color);
+  }
+  if (command) {
+    command->rect.x = x;
+    command->rect.y = y;
+    command->rect.w = w;
+    command->rect.h = h;
+  }
+}
+
+function void
+RenderLine(RenderCommands *commands, f32 x0, f32 y0, f32 x1, f32 y1, RenderColor color)
+{
+  RenderCommand *command = 0;
+  if (RenderIsVisible(commands, x0, y0, x1, y1)) {
+    command = RenderPush(commands, RenderCommand_Line, 0, color);
+  }
+  if (command) {
+    command->line.x0 = x0;
+    command->line.y0 = y0;
+    command->line.x1 = x1;
+    command->line.y1 = y1;
+  }
+}
+
+function void
+RenderTriangle(RenderCommands *commands, f32 x0, f32 y0, f32 x1, f32 y1, f32 x2, f32 y2, RenderColor color)
+{
+  RenderCommand *command = 0;
+  if (RenderIsVisible(commands, Min(x0, Min(x1, x2)), Min(y0, Min(y1, y2)), Max(x0, Max(x1, x2)), Max(y0, Max(y1, y2)))) {
+    command = RenderPush(commands, RenderCommand_Triangle, 0, color);
+  }
+  if (command) {
+    command->triangle.x0 = x0;
+    command->triangle.y0 = y0;
+    command->triangle.x1 = x1;
+    command->triangle.y1 = y1;
+    command->triangle.x2 = x2;
+    command->triangle.y2 = y2;
+  }
+}
+
+function void
+RenderSprite(RenderCommands *commands, RenderTexture texture, f32 x, f32 y, f32 w, f32 h, f32 rotation, RenderColor color)
+{
+  RenderSpriteUV(commands, texture, x, y, w, h, rotation, 0.f, 0.f, 1.f, 1.f, color);
+}
+
+function void
+RenderSpriteUV(RenderCommands *commands, RenderTexture texture, f32 x, f32 y, f32 w, f32 h, f32 rotation,
+               f32 u0, f32 v0, f32 u1, f32 v1, RenderColor color)
+{
+  Assert(texture < RENDER_MAX_TEXTURES);
+
+  // Any rotation stays within the half diagonal, half width plus half height bounds it
+  f32 radius = (Abs(w) + Abs(h)) * 0.5f;
+  RenderCommand *command = 0;
+  if (RenderIsVisible(commands, x - radius, y - radius, x + radius, y + radius)) {
+    command = RenderPush(commands, RenderCommand_Sprite, texture, color);
+  }
+  if (command) {
+    command->sprite.x = x;
+    command->sprite.y = y;
+    command->sprite.w = w;
+    command->sprite.h = h;
+    command->sprite.rotation = rotation;
+    command->sprite.u0 = (u16)(Clamp(u0, 0.f, 1.f) * 65535.f + 0.5f);
+    command->sprite.v0 = (u16)(Clamp(v0, 0.f, 1.f) * 65535.f + 0.5f);
+    command->sprite.u1 = (u16)(Clamp(u1, 0.f, 1.f) * 65535.f + 0.5f);
+    command->sprite.v1 = (u16)(Clamp(v1, 0.f, 1.f) * 65535.f + 0.5f);
+  }
+}
+
+function RenderTilemap*
+RenderTilemapAlloc(Arena *arena, u32 width, u32 height, f32 tileSize, RenderTexture atlas, u32 atlasColumns, u32 atlasRows)
+{
+  RenderTilemap *result = ArenaPushN(arena, RenderTilemap, 1);
+  result->width = width;
+  result->height = height;
+  result->chunksX = (width + RENDER_TILEMAP_CHUNK_SIZE - 1) / RENDER_TILEMAP_CHUNK_SIZE;
+  result->chunksY = (height + RENDER_TILEMAP_CHUNK_SIZE - 1) / RENDER_TILEMAP_CHUNK_SIZE;
+  result->tileSize = tileSize;
+  result->atlas = atlas;
+  result->atlasColumns = Max(atlasColumns, 1);
+  result->atlasRows = Max(atlasRows, 1);
+  result->tiles = ArenaPushN(arena, RenderTile, (u64)width * height);
+  result->chunks = ArenaPushN(arena, RenderTilemapChunk, (u64)result->chunksX * result->chunksY);
+
+  // The platform may still have chunks cached for a map that used to live here
+  for (u32 chunkIdx = 0; chunkIdx < result->chunksX * result->chunksY; ++chunkIdx) {
+    result->chunks[chunkIdx].isDirty = true;
+  }
+
+  return result;
+}
+
+function void
+RenderTilemapSet(RenderTilemap *tilemap, u32 x, u32 y, RenderTile tile)
+{
+  Assert(x < tilemap->width && y < tilemap->height);
+  RenderTile *dest = &tilemap->tiles[(u64)y * tilemap->width + x];
+  if (*dest != tile) {
+    *dest = tile;
+    u32 chunkIdx = (y / RENDER_TILEMAP_CHUNK_SIZE) * tilemap->chunksX + x / RENDER_TILEMAP_CHUNK_SIZE;
+    tilemap->chunks[chunkIdx].isDirty = true;
+  }
+}
+
+function void
+RenderTilemapDraw(RenderCommands *commands, RenderTilemap *tilemap, f32 x, f32 y)
+{
+  // Whole map here, the backend culls its chunks
+  f32 mapWidth = (f32)tilemap->width * tilemap->tileSize;
+  f32 mapHeight = (f32)tilemap->height * tilemap->tileSize;
+  RenderCommand *command = 0;
+  if (RenderIsVisible(commands, x, y, x + mapWidth, y + mapHeight)) {
+    command = RenderPush(commands, RenderCommand_Tilemap, tilemap->atlas, 0xFFFFFFFF);
+  }
+  if (command) {
+    command->tilemap.map = tilemap;
+    command->tilemap.x = x;
+    command->tilemap.y = y;
+  }
+}
@@ -0,0 +1,182 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+/*
+  Game code doesn't talk to the GPU. Render fills a RenderCommands buffer with compact
+  commands, each tagged with a 64 bit sort key, and the platform's backend sorts and
+  executes them. The buffer is plain memory owned by the platform, so nothing GPU side
+  has to survive a reload of the game and commands can be generated on any thread.
+*/
+
+#define RENDER_MAX_COMMANDS (1 << 16)
+
+// Sort key, most significant field first:
+//   layer:8 | depth:16 | pipeline:4 | blend:3 | texture:13 | index:20
+// Layer and depth give the explicit draw order, within equal layer and depth commands get
+// grouped by GPU state. The command index is last, so equal state keeps submission order.
+#define RENDER_KEY_INDEX_BITS    20
+#define RENDER_KEY_TEXTURE_BITS  13
+#define RENDER_KEY_BLEND_BITS    3
+#define RENDER_KEY_PIPELINE_BITS 4
+#define RENDER_KEY_DEPTH_BITS    16
+#define RENDER_KEY_LAYER_BITS    8
+
+#define RENDER_KEY_TEXTURE_SHIFT  (RENDER_KEY_INDEX_BITS)
+#define RENDER_KEY_BLEND_SHIFT    (RENDER_KEY_TEXTURE_SHIFT + RENDER_KEY_TEXTURE_BITS)
+#define RENDER_KEY_PIPELINE_SHIFT (RENDER_KEY_BLEND_SHIFT + RENDER_KEY_BLEND_BITS)
+#define RENDER_KEY_DEPTH_SHIFT    (RENDER_KEY_PIPELINE_SHIFT + RENDER_KEY_PIPELINE_BITS)
+#define RENDER_KEY_LAYER_SHIFT    (RENDER_KEY_DEPTH_SHIFT + RENDER_KEY_DEPTH_BITS)
+
+#define RenderKeyMask(bits)           ((1ull << (bits)) - 1)
+#define RenderKeyField(key, name)     (((key) >> RENDER_KEY_##name##_SHIFT) & RenderKeyMask(RENDER_KEY_##name##_BITS))
+#define RENDER_KEY_INDEX_SHIFT        0
+#define RENDER_KEY_INDEX_MASK         RenderKeyMask(RENDER_KEY_INDEX_BITS)
+#define RENDER_KEY_STATE_MASK         (RenderKeyMask(RENDER_KEY_PIPELINE_BITS + RENDER_KEY_BLEND_BITS + RENDER_KEY_TEXTURE_BITS) << RENDER_KEY_TEXTURE_SHIFT)
+
+typedef u32 RenderColor; // RGBA8, red in the low byte
+
+#define RENDER_MAX_TEXTURES (1 << RENDER_KEY_TEXTURE_BITS)
+typedef u32 RenderTexture; // Made by the platform (PlatformAPI.RenderTextureCreate), 0 is plain white
+
+typedef u8 RenderBlend;
+enum
+{
+  RenderBlend_None,  // Same order as sgp_blend_mode
+  RenderBlend_Alpha,
+  RenderBlend_Add,
+  RenderBlend_Mod,
+  RenderBlend_Mul,
+  RenderBlend_Count,
+};
+
+typedef u8 RenderPipeline; // Set by the command kind
+enum
+{
+  RenderPipeline_Triangles,
+  RenderPipeline_Lines,
+  RenderPipeline_Sprites,
+  RenderPipeline_Tilemap,
+  RenderPipeline_Count,
+};
+
+typedef u8 RenderCommandKind;
+enum
+{
+  RenderCommand_Rect,
+  RenderCommand_Line,
+  RenderCommand_Triangle,
+  RenderCommand_Sprite, // Drawn instanced, the texture is in the key
+  RenderCommand_Tilemap,
+};
+
+// Tilemaps live in game memory. The platform turns each chunk into a GPU buffer the first
+// time it's visible and keeps it until the game marks the chunk dirty, so drawing a static
+// map is a draw call per visible chunk. Tile (0, 0) is the bottom left one
+#define RENDER_TILEMAP_CHUNK_SIZE 32 // Tiles per chunk side
+
+typedef u16 RenderTile; // 1 + index into the atlas, row by row from the top left. 0 is empty
+
+typedef struct RenderTilemapChunk RenderTilemapChunk;
+struct RenderTilemapChunk
+{
+  b32 isDirty;   // Set by the game, cleared by the platform once it rebuilt the chunk
+  u32 cacheSlot; // Platform's, where the chunk's buffer was last cached
+};
+
+typedef struct RenderTilemap RenderTilemap;
+struct RenderTilemap
+{
+  u32 width, height; // Tiles
+  u32 chunksX, chunksY;
+  f32 tileSize;
+  RenderTexture atlas;
+  u32 atlasColumns, atlasRows;
+  RenderTile *tiles;
+  RenderTilemapChunk *chunks;
+};
+
+// 40 bytes on x64, not 32: the sprite's 28 bytes don't fit next to kind and color in 32, and
+// the tilemap pointer pads the union to 8 byte alignment
+typedef struct RenderCommand RenderCommand;
+struct RenderCommand
+{
+  RenderCommandKind kind;
+  RenderColor color;
+
+  union
+  {
+    struct { f32 x, y, w, h; } rect;
+    struct { f32 x0, y0, x1, y1; } line;
+    struct { f32 x0, y0, x1, y1, x2, y2; } triangle;
+    struct { f32 x, y, w, h, rotation; u16 u0, v0, u1, v1; } sprite; // Centered on x, y, rotation in radians, UVs in 1/65535ths
+    struct { RenderTilemap *map; f32 x, y; } tilemap;
+  };
+};
+StaticAssert(sizeof(RenderCommand) <= 40, check_render_command_size);
+
+typedef struct RenderCommands RenderCommands;
+struct RenderCommands
+{
+  u64 frameWidth, frameHeight;
+  RenderColor clearColor;
+
+  // Camera, one per frame. Commands are culled against its view as they're pushed, so it
+  // has to be set first. Defaults to a view of the frame in pixels
+  f32 cameraX, cameraY; // Center of the view
+  f32 zoom;             // Frame pixels per unit
+  f32 viewX0, viewY0, viewX1, viewY1;
+
+  // Sort state for the commands pushed after it was set, reset every frame
+  u8 layer;
+  u16 depth;
+  RenderBlend blend;
+
+  // Layer caching, a bit per layer. The first two are reset every frame, valid layers are
+  // written by the platform and dropped when the frame size changes
+  u64 cachedLayers[4];
+  u64 redrawnLayers[4];
+  u64 validLayers[4];
+
+  u64 *keys;
+  RenderCommand *commands;
+  u64 count;
+  u64 capacity;
+  u64 dropped;
+  u64 culled;
+};
+
+// Platform
+function RenderCommands* RenderCommandsAlloc(Arena *arena, u64 capacity);
+function void            RenderCommandsBegin(RenderCommands *commands, u64 frameWidth, u64 frameHeight);
+
+function u64 RenderKey(u8 layer, u16 depth, RenderPipeline pipeline, RenderBlend blend, u32 texture, u64 index);
+
+// Game. Lower layers draw first, then lower depths within a layer. Commands that share
+// layer and depth may be reordered to batch state, give overlapping ones their own depth.
+function RenderColor    RenderColorRGBA(f32 r, f32 g, f32 b, f32 a);
+function void           RenderSetCamera(RenderCommands *commands, f32 x, f32 y, f32 zoom);
+function b32            RenderIsVisible(RenderCommands *commands, f32 x0, f32 y0, f32 x1, f32 y1); // Counts what's culled
+function void           RenderSetLayer(RenderCommands *commands, u8 layer);
+function void           RenderSetDepth(RenderCommands *commands, u16 depth);
+function void           RenderSetBlend(RenderCommands *commands, RenderBlend blend); // Alpha by default
+// Cached layers get drawn into a frame sized texture that's composited in their place until
+// the game redraws them, with the camera they were drawn with. Returns whether the layer needs
+// its commands this frame, that is when it's dirty or the platform dropped its copy. Otherwise
+// its commands are ignored. Also makes it the current layer.
+// The composite is premultiplied alpha over what's below, so only layers drawn entirely with
+// RenderBlend_Alpha get cached. Any other blend mode in a layer keeps it drawn in place.
+function b32            RenderCacheLayer(RenderCommands *commands, u8 layer, b32 isDirty);
+function RenderCommand* RenderPush(RenderCommands *commands, RenderCommandKind kind, RenderTexture texture, RenderColor color); // 0 when full
+function void           RenderClear(RenderCommands *commands, RenderColor color);
+function void           RenderRect(RenderCommands *commands, f32 x, f32 y, f32 w, f32 h, RenderColor color);
+function void           RenderLine(RenderCommands *commands, f32 x0, f32 y0, f32 x1, f32 y1, RenderColor color);
+function void           RenderTriangle(RenderCommands *commands, f32 x0, f32 y0, f32 x1, f32 y1, f32 x2, f32 y2, RenderColor color);
+function void           RenderSprite(RenderCommands *commands, RenderTexture texture, f32 x, f32 y, f32 w, f32 h, f32 rotation, RenderColor color);
+function void           RenderSpriteUV(RenderCommands *commands, RenderTexture texture, f32 x, f32 y, f32 w, f32 h, f32 rotation,
+                                       f32 u0, f32 v0, f32 u1, f32 v1, RenderColor color);
+
+function RenderTilemap* RenderTilemapAlloc(Arena *arena, u32 width, u32 height, f32 tileSize, RenderTexture atlas, u32 atlasColumns, u32 atlasRows);
+function void           RenderTilemapSet(RenderTilemap *tilemap, u32 x, u32 y, RenderTile tile); // Dirties the chunk if the tile changed
+function void           RenderTilemapDraw(RenderCommands *commands, RenderTilemap *tilemap, f32 x, f32 y); // Bottom left corner
+
+#endif // RENDER_H
@@ -0,0 +1,150 @@
+function b32
+RenderOffscreenInit(RenderOffscreen *offscreen, u64 width, u64 height)
+{
+  MemoryZeroStruct(offscreen);
+  offscreen->display = EGL_NO_DISPLAY;
+  offscreen->context = EGL_NO_CONTEXT;
+  offscreen->width = width;
+  offscreen->height = height;
+
+  // Client extensions are queried without a display
+  const char *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  String8 clientExtensions = extensions ? Str8C(extensions) : (String8){0};
+  PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+  if (GetPlatformDisplay && Str8Find(clientExtensions, Str8Lit("EGL_MESA_platform_surfaceless"), 0, 0) < clientExtensions.size) {
+    offscreen->display = GetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, 0);
+  }
+
+  EGLint major, minor;
+  if (offscreen->display != EGL_NO_DISPLAY && eglInitialize(offscreen->display, &major, &minor) && eglBindAPI(EGL_OPENGL_API)) {
+    // No config, there's no surface it has to match
+    EGLint contextAttribs[] = {
+      EGL_CONTEXT_MAJOR_VERSION, 3,
+      EGL_CONTEXT_MINOR_VERSION, 3,
+      EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+      EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE, EGL_TRUE,
+      EGL_NONE,
+    };
+    offscreen->context = eglCreateContext(offscreen->display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttribs);
+  }
+
+  if (offscreen->context != EGL_NO_CONTEXT &&
+      eglMakeCurrent(offscreen->display, EGL_NO_SURFACE, EGL_NO_SURFACE, offscreen->context)) {
+    // Same attachments a window's default framebuffer would have
+    glGenRenderbuffers(1, &offscreen->colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, offscreen->colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, (GLsizei)width, (GLsizei)height);
+    glGenRenderbuffers(1, &offscreen->depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, offscreen->depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, (GLsizei)width, (GLsizei)height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &offscreen->framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, offscreen->framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, offscreen->colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, offscreen->depthBuffer);
+    glViewport(0, 0, (GLsizei)width, (GLsizei)height);
+
+    for (u32 readbackIdx = 0; readbackIdx < RENDER_OFFSCREEN_READBACKS; ++readbackIdx) {
+      glGenBuffers(1, &offscreen->readbacks[readbackIdx].buffer);
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, offscreen->readbacks[readbackIdx].buffer);
+      glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)(width * height * sizeof(u32)), 0, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    offscreen->isValid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE && glGetError() == GL_NO_ERROR;
+  }
+
+  return offscreen->isValid;
+}
+
+function void
+RenderOffscreenShutdown(RenderOffscreen *offscreen)
+{
+  if (offscreen->context != EGL_NO_CONTEXT) {
+    for (u32 readbackIdx = 0; readbackIdx < RENDER_OFFSCREEN_READBACKS; ++readbackIdx) {
+      RenderOffscreenReadback *readback = &offscreen->readbacks[readbackIdx];
+      if (readback->fence) {
+        glDeleteSync(readback->fence);
+      }
+      glDeleteBuffers(1, &readback->buffer);
+    }
+    glDeleteFramebuffers(1, &offscreen->framebuffer);
+    glDeleteRenderbuffers(1, &offscreen->colorBuffer);
+    glDeleteRenderbuffers(1, &offscreen->depthBuffer);
+    eglMakeCurrent(offscreen->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(offscreen->display, offscreen->context);
+  }
+  if (offscreen->display != EGL_NO_DISPLAY) {
+    eglTerminate(offscreen->display);
+  }
+  offscreen->isValid = false;
+  offscreen->context = EGL_NO_CONTEXT;
+  offscreen->display = EGL_NO_DISPLAY;
+}
+
+function b32
+RenderOffscreenReadbackBegin(RenderOffscreen *offscreen, u64 frameIndex)
+{
+  b32 result = offscreen->isValid && offscreen->readbackCount < RENDER_OFFSCREEN_READBACKS;
+  if (result) {
+    u32 readbackIdx = (offscreen->readbackFirst + offscreen->readbackCount) % RENDER_OFFSCREEN_READBACKS;
+    RenderOffscreenReadback *readback = &offscreen->readbacks[readbackIdx];
+
+    // Into the buffer, returns right away. sokol_gfx doesn't track the pack buffer binding
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, offscreen->framebuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+    glReadPixels(0, 0, (GLsizei)offscreen->width, (GLsizei)offscreen->height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback->frameIndex = frameIndex;
+
+    offscreen->readbackCount++;
+    offscreen->stats.readbacks++;
+  }
+
+  return result;
+}
+
+function b32
+RenderOffscreenReadbackEnd(RenderOffscreen *offscreen, u32 *pixels, u64 *frameIndex, b32 wait)
+{
+  b32 result = false;
+  if (offscreen->readbackCount) {
+    RenderOffscreenReadback *readback = &offscreen->readbacks[offscreen->readbackFirst];
+    GLenum status = glClientWaitSync(readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (wait && status == GL_TIMEOUT_EXPIRED) {
+      u64 waitStartNs = OSNowNs();
+      while (status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT, OS_NS_PER_SEC);
+      }
+      offscreen->stats.stalls++;
+      offscreen->stats.waitNs += OSNowNs() - waitStartNs;
+    }
+
+    if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+      u64 mapStartNs = OSNowNs();
+      u64 size = offscreen->width * offscreen->height * sizeof(u32);
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+      void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+      if (mapped) {
+        MemoryCopy(pixels, mapped, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        *frameIndex = readback->frameIndex;
+        result = true;
+      }
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+      offscreen->stats.mapNs += OSNowNs() - mapStartNs;
+    }
+
+    // A failed wait or map loses the frame, the buffer goes back to the ring either way
+    if (status != GL_TIMEOUT_EXPIRED) {
+      glDeleteSync(readback->fence);
+      readback->fence = 0;
+      offscreen->readbackFirst = (offscreen->readbackFirst + 1) % RENDER_OFFSCREEN_READBACKS;
+      offscreen->readbackCount--;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,70 @@
+#ifndef RENDER_OFFSCREEN_H
+#define RENDER_OFFSCREEN_H
+
+/*
+  GL without a display, for headless runs of the real sokol backend on Linux servers. A GL
+  3.3 core context is made through EGL's surfaceless platform (EGL_MESA_platform_surfaceless,
+  llvmpipe when there's no GPU) and frames go into a framebuffer object of a fixed size.
+  The framebuffer is bound when sokol_gfx is set up, so sokol takes it as its default one and
+  the backend runs exactly as it does on a window. Needs -lEGL next to -lGL.
+
+  Readbacks are asynchronous: a frame is copied into a pixel buffer with a fence behind it,
+  and only mapped once the fence passed, so the frames in between keep rendering. A ring of
+  buffers keeps a few in flight, starting one more than that waits for the oldest.
+
+  Pixels are RGBA8 like RenderColor, bottom row first, same as the software renderer's.
+*/
+
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#define RENDER_OFFSCREEN_READBACKS 3 // Readbacks in flight
+
+typedef struct RenderOffscreenReadback RenderOffscreenReadback;
+struct RenderOffscreenReadback
+{
+  GLuint buffer;
+  GLsync fence;
+  u64 frameIndex;
+};
+
+typedef struct RenderOffscreenStats RenderOffscreenStats;
+struct RenderOffscreenStats
+{
+  u64 readbacks;
+  u64 stalls;   // Readbacks that had to wait on their fence
+  u64 waitNs;   // Spent waiting on fences
+  u64 mapNs;    // Spent mapping and copying
+};
+
+typedef struct RenderOffscreen RenderOffscreen;
+struct RenderOffscreen
+{
+  b32 isValid;
+  EGLDisplay display;
+  EGLContext context;
+  GLuint framebuffer;
+  GLuint colorBuffer, depthBuffer;
+  u64 width, height;
+
+  // Oldest first from readbackFirst
+  RenderOffscreenReadback readbacks[RENDER_OFFSCREEN_READBACKS];
+  u32 readbackFirst, readbackCount;
+
+  RenderOffscreenStats stats; // Whole run
+};
+
+// Makes the context current and binds the framebuffer, call before RenderBackendInit
+function b32  RenderOffscreenInit(RenderOffscreen *offscreen, u64 width, u64 height);
+function void RenderOffscreenShutdown(RenderOffscreen *offscreen);
+
+// Queues a copy of the framebuffer as it is after the commands so far. False when all the
+// buffers are in flight, end one first
+function b32 RenderOffscreenReadbackBegin(RenderOffscreen *offscreen, u64 frameIndex);
+// Copies the oldest readback into pixels (width * height). Without wait it's false while
+// the GPU is still behind it, with wait only when nothing is in flight
+function b32 RenderOffscreenReadbackEnd(RenderOffscreen *offscreen, u32 *pixels, u64 *frameIndex, b32 wait);
+
+#endif // RENDER_OFFSCREEN_H
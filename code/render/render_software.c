@@ -0,0 +1,849 @@
+// Pixels
+
+// x / 255 rounded to nearest. Exact up to 255 * 255 and a bit, larger sums always clamp to 255
+function inline u32
+RenderSoftwareDiv255(u32 x)
+{
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+// Same factors as sokol_gp's blend modes, rounded like an 8 bit target would
+function u32
+RenderSoftwareBlend(u32 dst, u32 src, RenderBlend blend)
+{
+  u32 result = src;
+  if (blend != RenderBlend_None) {
+    u32 alpha = src >> 24;
+    u32 dstAlpha = dst >> 24;
+    result = 0;
+    for (u32 shift = 0; shift < 24; shift += 8) {
+      u32 s = (src >> shift) & 0xFF;
+      u32 d = (dst >> shift) & 0xFF;
+      u32 channel = 0;
+      switch (blend) {
+        case RenderBlend_Alpha: channel = RenderSoftwareDiv255(s * alpha + d * (255 - alpha)); break;
+        case RenderBlend_Add:   channel = RenderSoftwareDiv255(s * alpha + d * 255); break;
+        case RenderBlend_Mod:   channel = RenderSoftwareDiv255(s * d); break;
+        case RenderBlend_Mul:   channel = RenderSoftwareDiv255(s * d + d * (255 - alpha)); break;
+      }
+      result |= Min(channel, 255) << shift;
+    }
+    u32 outAlpha = blend == RenderBlend_Alpha ? RenderSoftwareDiv255(alpha * 255 + dstAlpha * (255 - alpha)) : dstAlpha;
+    result |= outAlpha << 24;
+  }
+
+  return result;
+}
+
+function inline u32
+RenderSoftwareModulate(u32 texel, RenderColor color)
+{
+  u32 result = texel;
+  if (color != 0xFFFFFFFF) {
+    result = 0;
+    for (u32 shift = 0; shift < 32; shift += 8) {
+      result |= RenderSoftwareDiv255(((texel >> shift) & 0xFF) * ((color >> shift) & 0xFF)) << shift;
+    }
+  }
+
+  return result;
+}
+
+#if ARCH_X64
+// x / 255 rounded in 16 bit lanes, same as RenderSoftwareDiv255
+function inline __m128i
+RenderSoftwareDiv255x8(__m128i x)
+{
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+#endif
+
+// Solid color, the opaque and alpha blended cases 4 pixels at a time
+function void
+RenderSoftwareFillSpan(u32 *row, s32 count, RenderColor color, RenderBlend blend)
+{
+  u32 alpha = color >> 24;
+  if (blend == RenderBlend_Alpha && alpha == 255) {
+    blend = RenderBlend_None;
+  }
+
+  s32 i = 0;
+#if ARCH_X64
+  if (blend == RenderBlend_None) {
+    __m128i color4 = _mm_set1_epi32((int)color);
+    for (; i + 4 <= count; i += 4) {
+      _mm_storeu_si128((__m128i*)(row + i), color4);
+    }
+  } else if (blend == RenderBlend_Alpha) {
+    // The source term and the destination factor are the same for every pixel and channel
+    u32 r = color & 0xFF, g = (color >> 8) & 0xFF, b = (color >> 16) & 0xFF;
+    __m128i source = _mm_setr_epi16((short)(r * alpha), (short)(g * alpha), (short)(b * alpha), (short)(255 * alpha),
+                                    (short)(r * alpha), (short)(g * alpha), (short)(b * alpha), (short)(255 * alpha));
+    __m128i factor = _mm_set1_epi16((short)(255 - alpha));
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+      __m128i dst = _mm_loadu_si128((__m128i*)(row + i));
+      __m128i lo = RenderSoftwareDiv255x8(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), factor), source));
+      __m128i hi = RenderSoftwareDiv255x8(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), factor), source));
+      _mm_storeu_si128((__m128i*)(row + i), _mm_packus_epi16(lo, hi));
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    row[i] = RenderSoftwareBlend(row[i], color, blend);
+  }
+}
+
+// Texels tinted by color, the opaque and alpha blended cases 4 pixels at a time
+function void
+RenderSoftwareBlendSpan(u32 *row, u32 *texels, s32 count, RenderColor color, RenderBlend blend)
+{
+  s32 i = 0;
+#if ARCH_X64
+  if (blend == RenderBlend_None || blend == RenderBlend_Alpha) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i tint = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+    __m128i rgbMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    __m128i alphaOne = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    __m128i full = _mm_set1_epi16(255);
+    b32 isTinted = color != 0xFFFFFFFF;
+    for (; i + 4 <= count; i += 4) {
+      __m128i src = _mm_loadu_si128((__m128i*)(texels + i));
+      __m128i lo = _mm_unpacklo_epi8(src, zero);
+      __m128i hi = _mm_unpackhi_epi8(src, zero);
+      if (isTinted) {
+        lo = RenderSoftwareDiv255x8(_mm_mullo_epi16(lo, tint));
+        hi = RenderSoftwareDiv255x8(_mm_mullo_epi16(hi, tint));
+      }
+
+      if (blend == RenderBlend_Alpha) {
+        // Each pixel's alpha in all of its lanes, the source alpha lane blends as 255 * alpha
+        __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i dst = _mm_loadu_si128((__m128i*)(row + i));
+        __m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+        __m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+        lo = _mm_or_si128(_mm_and_si128(lo, rgbMask), alphaOne);
+        hi = _mm_or_si128(_mm_and_si128(hi, rgbMask), alphaOne);
+        lo = _mm_add_epi16(_mm_mullo_epi16(lo, alphaLo), _mm_mullo_epi16(dstLo, _mm_sub_epi16(full, alphaLo)));
+        hi = _mm_add_epi16(_mm_mullo_epi16(hi, alphaHi), _mm_mullo_epi16(dstHi, _mm_sub_epi16(full, alphaHi)));
+        lo = RenderSoftwareDiv255x8(lo);
+        hi = RenderSoftwareDiv255x8(hi);
+      }
+      _mm_storeu_si128((__m128i*)(row + i), _mm_packus_epi16(lo, hi));
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    row[i] = RenderSoftwareBlend(row[i], RenderSoftwareModulate(texels[i], color), blend);
+  }
+}
+
+// Primitives, each drawn within the clip rect of one tile
+
+function void
+RenderSoftwareDrawRect(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, s32 x0, s32 y0, s32 x1, s32 y1)
+{
+  for (s32 y = y0; y < y1; ++y) {
+    RenderSoftwareFillSpan(renderer->pixels + (u64)y * renderer->width + x0, x1 - x0, primitive->color, primitive->blend);
+  }
+}
+
+function void
+RenderSoftwareDrawTriangle(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, s32 x0, s32 y0, s32 x1, s32 y1)
+{
+  s64 *vx = primitive->triangle.x;
+  s64 *vy = primitive->triangle.y;
+  s64 one = 1 << RENDER_SOFTWARE_SUBPIXEL_BITS;
+  s64 half = one / 2;
+
+  // Pixels exactly on an edge belong to one side only: E + bias > 0 is E >= 0 on the edges
+  // that include them, and an edge shared by two triangles runs the other way in the other one
+  s64 dx[3], dy[3], bias[3];
+  for (u32 edge = 0; edge < 3; ++edge) {
+    u32 next = (edge + 1) % 3;
+    dx[edge] = vx[next] - vx[edge];
+    dy[edge] = vy[next] - vy[edge];
+    bias[edge] = (dy[edge] < 0 || (dy[edge] == 0 && dx[edge] > 0)) ? 1 : 0;
+  }
+
+  for (s32 y = y0; y < y1; ++y) {
+    s64 centerX = (s64)x0 * one + half;
+    s64 centerY = (s64)y * one + half;
+    s64 e[3];
+    for (u32 edge = 0; edge < 3; ++edge) {
+      e[edge] = dx[edge] * (centerY - vy[edge]) - dy[edge] * (centerX - vx[edge]) + bias[edge];
+    }
+
+    // Convex, so the row's coverage is one span
+    s32 x = x0;
+    for (; x < x1 && (e[0] <= 0 || e[1] <= 0 || e[2] <= 0); ++x) {
+      e[0] -= dy[0] * one;
+      e[1] -= dy[1] * one;
+      e[2] -= dy[2] * one;
+    }
+    s32 spanStart = x;
+    for (; x < x1 && e[0] > 0 && e[1] > 0 && e[2] > 0; ++x) {
+      e[0] -= dy[0] * one;
+      e[1] -= dy[1] * one;
+      e[2] -= dy[2] * one;
+    }
+    if (x > spanStart) {
+      RenderSoftwareFillSpan(renderer->pixels + (u64)y * renderer->width + spanStart, x - spanStart, primitive->color, primitive->blend);
+    }
+  }
+}
+
+// One pixel wide, a pixel per column (or row) whose center the line passes, end excluded like GL's
+function void
+RenderSoftwareDrawLine(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, s32 x0, s32 y0, s32 x1, s32 y1)
+{
+  f32 ax = primitive->line.x0, ay = primitive->line.y0;
+  f32 bx = primitive->line.x1, by = primitive->line.y1;
+  b32 isXMajor = Abs(bx - ax) >= Abs(by - ay);
+  f32 major0 = isXMajor ? ax : ay;
+  f32 major1 = isXMajor ? bx : by;
+  f32 minor0 = isXMajor ? ay : ax;
+  f32 slope = major1 != major0 ? ((isXMajor ? by : bx) - minor0) / (major1 - major0) : 0.f;
+
+  // Pixel centers in [start, end) going from the first point
+  f32 lo = Min(major0, major1);
+  f32 hi = Max(major0, major1);
+  s32 start = (s32)ceilf(lo - 0.5f);
+  s32 end = (s32)ceilf(hi - 0.5f);
+  if (major1 < major0) {
+    start = (s32)floorf(lo - 0.5f) + 1;
+    end = (s32)floorf(hi - 0.5f) + 1;
+  }
+  s32 clipStart = isXMajor ? x0 : y0;
+  s32 clipEnd = isXMajor ? x1 : y1;
+  start = Max(start, clipStart);
+  end = Min(end, clipEnd);
+
+  for (s32 major = start; major < end; ++major) {
+    f32 minor = minor0 + ((f32)major + 0.5f - major0) * slope;
+    s32 pixelMinor = (s32)floorf(minor);
+    s32 x = isXMajor ? major : pixelMinor;
+    s32 y = isXMajor ? pixelMinor : major;
+    if (x >= x0 && x < x1 && y >= y0 && y < y1) {
+      u32 *pixel = renderer->pixels + (u64)y * renderer->width + x;
+      *pixel = RenderSoftwareBlend(*pixel, primitive->color, primitive->blend);
+    }
+  }
+}
+
+// Texel coordinate to index, truncating is flooring for what survives the clamp
+function inline u32
+RenderSoftwareTexelIndex(f32 coord, u32 size)
+{
+  s32 index = (s32)(coord * (f32)size);
+  u32 result = (u32)Clamp(index, 0, (s32)size - 1);
+  return result;
+}
+
+function void
+RenderSoftwareDrawImage(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, s32 x0, s32 y0, s32 x1, s32 y1)
+{
+  RenderSoftwareTexture *texture = primitive->texture;
+  f32 width = primitive->image.x1 - primitive->image.x0;
+  f32 height = primitive->image.y1 - primitive->image.y0;
+  f32 du = (primitive->image.u1 - primitive->image.u0) / width;
+  f32 dv = (primitive->image.v1 - primitive->image.v0) / height;
+  f32 u0 = primitive->image.u0 + ((f32)x0 + 0.5f - primitive->image.x0) * du;
+
+  // Columns map to the same texels on every row
+  u32 columns[RENDER_SOFTWARE_TILE_SIZE];
+  u32 span[RENDER_SOFTWARE_TILE_SIZE];
+  s32 count = x1 - x0;
+  f32 u = u0;
+  for (s32 x = 0; x < count; ++x) {
+    columns[x] = RenderSoftwareTexelIndex(u, texture->width);
+    u += du;
+  }
+
+  for (s32 y = y0; y < y1; ++y) {
+    f32 v = primitive->image.v0 + ((f32)y + 0.5f - primitive->image.y0) * dv;
+    u32 *texels = texture->pixels + (u64)RenderSoftwareTexelIndex(v, texture->height) * texture->width;
+    for (s32 x = 0; x < count; ++x) {
+      span[x] = texels[columns[x]];
+    }
+    RenderSoftwareBlendSpan(renderer->pixels + (u64)y * renderer->width + x0, span, count, primitive->color, primitive->blend);
+  }
+}
+
+function void
+RenderSoftwareDrawSprite(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, s32 x0, s32 y0, s32 x1, s32 y1)
+{
+  RenderSoftwareTexture *texture = primitive->texture;
+  f32 dsdx = primitive->sprite.dsdx;
+  f32 dtdx = primitive->sprite.dtdx;
+  f32 du = primitive->sprite.u1 - primitive->sprite.u0;
+  f32 dv = primitive->sprite.v1 - primitive->sprite.v0;
+  u32 span[RENDER_SOFTWARE_TILE_SIZE];
+
+  for (s32 y = y0; y < y1; ++y) {
+    f32 offsetY = (f32)y + 0.5f - primitive->sprite.originY;
+    f32 offsetX = (f32)x0 + 0.5f - primitive->sprite.originX;
+    f32 s = offsetX * dsdx + offsetY * primitive->sprite.dsdy;
+    f32 t = offsetX * dtdx + offsetY * primitive->sprite.dtdy;
+
+    // Convex, so the row's coverage is one span
+    s32 x = x0;
+    for (; x < x1 && !(s >= 0.f && s < 1.f && t >= 0.f && t < 1.f); ++x) {
+      s += dsdx;
+      t += dtdx;
+    }
+    s32 spanStart = x;
+    for (; x < x1 && s >= 0.f && s < 1.f && t >= 0.f && t < 1.f; ++x) {
+      // v runs from the top of the image, t from the bottom of the sprite
+      u32 texelX = RenderSoftwareTexelIndex(primitive->sprite.u0 + du * s, texture->width);
+      u32 texelY = RenderSoftwareTexelIndex(primitive->sprite.v0 + dv * (1.f - t), texture->height);
+      span[x - spanStart] = texture->pixels[(u64)texelY * texture->width + texelX];
+      s += dsdx;
+      t += dtdx;
+    }
+    if (x > spanStart) {
+      RenderSoftwareBlendSpan(renderer->pixels + (u64)y * renderer->width + spanStart, span, x - spanStart, primitive->color, primitive->blend);
+    }
+  }
+}
+
+// Map tiles are images of their atlas cell, only the ones overlapping the clip rect get visited
+function void
+RenderSoftwareDrawTilemap(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, s32 x0, s32 y0, s32 x1, s32 y1)
+{
+  RenderTilemap *map = primitive->tilemap.map;
+  f32 originX = primitive->tilemap.originX;
+  f32 originY = primitive->tilemap.originY;
+  f32 tileWidth = primitive->tilemap.tileWidth;
+  f32 tileHeight = primitive->tilemap.tileHeight;
+  s32 startX = (s32)Clamp(floorf(((f32)x0 - originX) / tileWidth), 0.f, (f32)map->width);
+  s32 startY = (s32)Clamp(floorf(((f32)y0 - originY) / tileHeight), 0.f, (f32)map->height);
+  s32 endX = (s32)Clamp(floorf(((f32)x1 - originX) / tileWidth) + 1.f, 0.f, (f32)map->width);
+  s32 endY = (s32)Clamp(floorf(((f32)y1 - originY) / tileHeight) + 1.f, 0.f, (f32)map->height);
+
+  RenderSoftwarePrimitive image = {0};
+  image.kind = RenderSoftwarePrimitive_Image;
+  image.blend = primitive->blend;
+  image.color = primitive->color;
+  image.texture = primitive->texture;
+  for (s32 tileY = startY; tileY < endY; ++tileY) {
+    for (s32 tileX = startX; tileX < endX; ++tileX) {
+      RenderTile tile = map->tiles[(u64)tileY * map->width + tileX];
+      if (tile) {
+        // Neighbours compute their shared edge the same way, so no pixel is drawn twice or missed
+        image.image.x0 = originX + (f32)tileX * tileWidth;
+        image.image.y0 = originY + (f32)tileY * tileHeight;
+        image.image.x1 = originX + (f32)(tileX + 1) * tileWidth;
+        image.image.y1 = originY + (f32)(tileY + 1) * tileHeight;
+        u32 atlasX = (tile - 1) % map->atlasColumns;
+        u32 atlasY = ((tile - 1) / map->atlasColumns) % map->atlasRows;
+        // In 1/65535ths like the GPU's chunks. Atlas rows go down, the bottom edge is the cell's last
+        image.image.u0 = (f32)(atlasX * 65535 / map->atlasColumns) / 65535.f;
+        image.image.u1 = (f32)((atlasX + 1) * 65535 / map->atlasColumns) / 65535.f;
+        image.image.v0 = (f32)((atlasY + 1) * 65535 / map->atlasRows) / 65535.f;
+        image.image.v1 = (f32)(atlasY * 65535 / map->atlasRows) / 65535.f;
+
+        s32 imageX0 = Max((s32)ceilf(image.image.x0 - 0.5f), x0);
+        s32 imageY0 = Max((s32)ceilf(image.image.y0 - 0.5f), y0);
+        s32 imageX1 = Min((s32)ceilf(image.image.x1 - 0.5f), x1);
+        s32 imageY1 = Min((s32)ceilf(image.image.y1 - 0.5f), y1);
+        if (imageX0 < imageX1 && imageY0 < imageY1) {
+          RenderSoftwareDrawImage(renderer, &image, imageX0, imageY0, imageX1, imageY1);
+        }
+      }
+    }
+  }
+}
+
+// Setup, commands to screen space primitives
+
+// Float bounds to the pixels they may touch, false when that's none
+function b32
+RenderSoftwareSetBounds(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, f32 x0, f32 y0, f32 x1, f32 y1, b32 isCenterRule)
+{
+  f32 width = (f32)renderer->width;
+  f32 height = (f32)renderer->height;
+  if (isCenterRule) {
+    // Pixels whose center is inside, min inclusive
+    x0 = ceilf(x0 - 0.5f);
+    y0 = ceilf(y0 - 0.5f);
+    x1 = ceilf(x1 - 0.5f);
+    y1 = ceilf(y1 - 0.5f);
+  } else {
+    x0 = floorf(x0);
+    y0 = floorf(y0);
+    x1 = ceilf(x1);
+    y1 = ceilf(y1);
+  }
+  primitive->x0 = (s32)Clamp(x0, 0.f, width);
+  primitive->y0 = (s32)Clamp(y0, 0.f, height);
+  primitive->x1 = (s32)Clamp(x1, 0.f, width);
+  primitive->y1 = (s32)Clamp(y1, 0.f, height);
+
+  b32 result = primitive->x0 < primitive->x1 && primitive->y0 < primitive->y1;
+  return result;
+}
+
+function RenderSoftwareTexture*
+RenderSoftwareFindTexture(RenderSoftware *renderer, RenderTexture texture)
+{
+  RenderSoftwareTexture *result = &renderer->textures[texture < renderer->textureCount ? texture : 0];
+  return result;
+}
+
+function b32
+RenderSoftwareSetup(RenderSoftware *renderer, RenderSoftwarePrimitive *primitive, RenderCommands *commands, RenderCommand *command, u64 key)
+{
+  // The camera's view to frame pixels, y up like the GPU's
+  f32 scaleX = (f32)renderer->width / (commands->viewX1 - commands->viewX0);
+  f32 scaleY = (f32)renderer->height / (commands->viewY1 - commands->viewY0);
+  f32 offsetX = -commands->viewX0 * scaleX;
+  f32 offsetY = -commands->viewY0 * scaleY;
+  f32 maxCoord = (f32)RENDER_SOFTWARE_MAX_COORD;
+  #define RenderSoftwareScreenX(x) Clamp((x) * scaleX + offsetX, -maxCoord, maxCoord)
+  #define RenderSoftwareScreenY(y) Clamp((y) * scaleY + offsetY, -maxCoord, maxCoord)
+
+  primitive->blend = (RenderBlend)RenderKeyField(key, BLEND);
+  primitive->color = command->color;
+  primitive->texture = 0;
+
+  b32 result = false;
+  switch (command->kind) {
+    case RenderCommand_Rect: {
+      f32 x0 = RenderSoftwareScreenX(command->rect.x);
+      f32 y0 = RenderSoftwareScreenY(command->rect.y);
+      f32 x1 = RenderSoftwareScreenX(command->rect.x + command->rect.w);
+      f32 y1 = RenderSoftwareScreenY(command->rect.y + command->rect.h);
+      primitive->kind = RenderSoftwarePrimitive_Rect;
+      result = RenderSoftwareSetBounds(renderer, primitive, Min(x0, x1), Min(y0, y1), Max(x0, x1), Max(y0, y1), true);
+    } break;
+
+    case RenderCommand_Line: {
+      primitive->kind = RenderSoftwarePrimitive_Line;
+      primitive->line.x0 = RenderSoftwareScreenX(command->line.x0);
+      primitive->line.y0 = RenderSoftwareScreenY(command->line.y0);
+      primitive->line.x1 = RenderSoftwareScreenX(command->line.x1);
+      primitive->line.y1 = RenderSoftwareScreenY(command->line.y1);
+      result = RenderSoftwareSetBounds(renderer, primitive,
+                                       Min(primitive->line.x0, primitive->line.x1) - 1.f, Min(primitive->line.y0, primitive->line.y1) - 1.f,
+                                       Max(primitive->line.x0, primitive->line.x1) + 1.f, Max(primitive->line.y0, primitive->line.y1) + 1.f, false);
+    } break;
+
+    case RenderCommand_Triangle: {
+      f32 x[3] = {RenderSoftwareScreenX(command->triangle.x0), RenderSoftwareScreenX(command->triangle.x1), RenderSoftwareScreenX(command->triangle.x2)};
+      f32 y[3] = {RenderSoftwareScreenY(command->triangle.y0), RenderSoftwareScreenY(command->triangle.y1), RenderSoftwareScreenY(command->triangle.y2)};
+      f32 one = (f32)(1 << RENDER_SOFTWARE_SUBPIXEL_BITS);
+      s64 *fixedX = primitive->triangle.x;
+      s64 *fixedY = primitive->triangle.y;
+      for (u32 vertex = 0; vertex < 3; ++vertex) {
+        fixedX[vertex] = (s64)floorf(x[vertex] * one + 0.5f);
+        fixedY[vertex] = (s64)floorf(y[vertex] * one + 0.5f);
+      }
+
+      // Counter-clockwise, degenerate ones cover nothing
+      s64 area = (fixedX[1] - fixedX[0]) * (fixedY[2] - fixedY[0]) - (fixedY[1] - fixedY[0]) * (fixedX[2] - fixedX[0]);
+      if (area < 0) {
+        Swap(s64, fixedX[1], fixedX[2]);
+        Swap(s64, fixedY[1], fixedY[2]);
+      }
+      primitive->kind = RenderSoftwarePrimitive_Triangle;
+      result = area != 0 &&
+               RenderSoftwareSetBounds(renderer, primitive, Min(x[0], Min(x[1], x[2])), Min(y[0], Min(y[1], y[2])),
+                                       Max(x[0], Max(x[1], x[2])), Max(y[0], Max(y[1], y[2])), false);
+    } break;
+
+    case RenderCommand_Sprite: {
+      RenderTexture texture = (RenderTexture)RenderKeyField(key, TEXTURE);
+      f32 u0 = (f32)command->sprite.u0 / 65535.f;
+      f32 v0 = (f32)command->sprite.v0 / 65535.f;
+      f32 u1 = (f32)command->sprite.u1 / 65535.f;
+      f32 v1 = (f32)command->sprite.v1 / 65535.f;
+      primitive->texture = RenderSoftwareFindTexture(renderer, texture);
+
+      if (command->sprite.rotation == 0.f) {
+        // Corner (0, 0) to (1, 1), a negative size mirrors
+        f32 x0 = RenderSoftwareScreenX(command->sprite.x - command->sprite.w * 0.5f);
+        f32 y0 = RenderSoftwareScreenY(command->sprite.y - command->sprite.h * 0.5f);
+        f32 x1 = RenderSoftwareScreenX(command->sprite.x + command->sprite.w * 0.5f);
+        f32 y1 = RenderSoftwareScreenY(command->sprite.y + command->sprite.h * 0.5f);
+        b32 isMirroredX = x1 < x0;
+        b32 isMirroredY = y1 < y0;
+        primitive->kind = texture ? RenderSoftwarePrimitive_Image : RenderSoftwarePrimitive_Rect;
+        primitive->image.x0 = Min(x0, x1);
+        primitive->image.y0 = Min(y0, y1);
+        primitive->image.x1 = Max(x0, x1);
+        primitive->image.y1 = Max(y0, y1);
+        primitive->image.u0 = isMirroredX ? u1 : u0;
+        primitive->image.u1 = isMirroredX ? u0 : u1;
+        primitive->image.v0 = isMirroredY ? v0 : v1; // v1 is at the sprite's bottom
+        primitive->image.v1 = isMirroredY ? v1 : v0;
+        result = RenderSoftwareSetBounds(renderer, primitive, primitive->image.x0, primitive->image.y0,
+                                         primitive->image.x1, primitive->image.y1, true);
+      } else {
+        // Screen position of corner (0, 0) plus one step along each side, inverted
+        f32 c = cosf(command->sprite.rotation);
+        f32 s = sinf(command->sprite.rotation);
+        f32 axisXx = command->sprite.w * c * scaleX, axisXy = command->sprite.w * s * scaleY;
+        f32 axisYx = -command->sprite.h * s * scaleX, axisYy = command->sprite.h * c * scaleY;
+        f32 originX = RenderSoftwareScreenX(command->sprite.x) - 0.5f * (axisXx + axisYx);
+        f32 originY = RenderSoftwareScreenY(command->sprite.y) - 0.5f * (axisXy + axisYy);
+        f32 det = axisXx * axisYy - axisYx * axisXy;
+        if (det != 0.f) {
+          primitive->kind = RenderSoftwarePrimitive_Sprite;
+          primitive->sprite.originX = originX;
+          primitive->sprite.originY = originY;
+          primitive->sprite.dsdx = axisYy / det;
+          primitive->sprite.dsdy = -axisYx / det;
+          primitive->sprite.dtdx = -axisXy / det;
+          primitive->sprite.dtdy = axisXx / det;
+          primitive->sprite.u0 = u0;
+          primitive->sprite.v0 = v0;
+          primitive->sprite.u1 = u1;
+          primitive->sprite.v1 = v1;
+
+          f32 cornersX[4] = {originX, originX + axisXx, originX + axisYx, originX + axisXx + axisYx};
+          f32 cornersY[4] = {originY, originY + axisXy, originY + axisYy, originY + axisXy + axisYy};
+          result = RenderSoftwareSetBounds(renderer, primitive,
+                                           Min(Min(cornersX[0], cornersX[1]), Min(cornersX[2], cornersX[3])),
+                                           Min(Min(cornersY[0], cornersY[1]), Min(cornersY[2], cornersY[3])),
+                                           Max(Max(cornersX[0], cornersX[1]), Max(cornersX[2], cornersX[3])),
+                                           Max(Max(cornersY[0], cornersY[1]), Max(cornersY[2], cornersY[3])), false);
+        }
+      }
+    } break;
+
+    case RenderCommand_Tilemap: {
+      RenderTilemap *map = command->tilemap.map;
+      f32 x0 = RenderSoftwareScreenX(command->tilemap.x);
+      f32 y0 = RenderSoftwareScreenY(command->tilemap.y);
+      f32 x1 = RenderSoftwareScreenX(command->tilemap.x + (f32)map->width * map->tileSize);
+      f32 y1 = RenderSoftwareScreenY(command->tilemap.y + (f32)map->height * map->tileSize);
+      primitive->kind = RenderSoftwarePrimitive_Tilemap;
+      primitive->texture = RenderSoftwareFindTexture(renderer, map->atlas);
+      primitive->tilemap.map = map;
+      primitive->tilemap.originX = x0;
+      primitive->tilemap.originY = y0;
+      primitive->tilemap.tileWidth = map->tileSize * scaleX;
+      primitive->tilemap.tileHeight = map->tileSize * scaleY;
+      result = map->tileSize > 0.f && RenderSoftwareSetBounds(renderer, primitive, x0, y0, x1, y1, true);
+    } break;
+  }
+  #undef RenderSoftwareScreenX
+  #undef RenderSoftwareScreenY
+
+  return result;
+}
+
+// Tiles
+
+function void
+RenderSoftwareDrawTile(RenderSoftware *renderer, u32 tileIdx)
+{
+  s32 tileX0 = (s32)(tileIdx % renderer->tilesX) * RENDER_SOFTWARE_TILE_SIZE;
+  s32 tileY0 = (s32)(tileIdx / renderer->tilesX) * RENDER_SOFTWARE_TILE_SIZE;
+  s32 tileX1 = Min(tileX0 + RENDER_SOFTWARE_TILE_SIZE, (s32)renderer->width);
+  s32 tileY1 = Min(tileY0 + RENDER_SOFTWARE_TILE_SIZE, (s32)renderer->height);
+
+  if (renderer->isFirstRun) {
+    for (s32 y = tileY0; y < tileY1; ++y) {
+      RenderSoftwareFillSpan(renderer->pixels + (u64)y * renderer->width + tileX0, tileX1 - tileX0, renderer->clearColor, RenderBlend_None);
+    }
+  }
+
+  u32 *entries = renderer->binEntries + renderer->binOffsets[tileIdx];
+  for (u32 entryIdx = 0; entryIdx < renderer->binCounts[tileIdx]; ++entryIdx) {
+    RenderSoftwarePrimitive *primitive = &renderer->primitives[entries[entryIdx]];
+    s32 x0 = Max(primitive->x0, tileX0);
+    s32 y0 = Max(primitive->y0, tileY0);
+    s32 x1 = Min(primitive->x1, tileX1);
+    s32 y1 = Min(primitive->y1, tileY1);
+    switch (primitive->kind) {
+      case RenderSoftwarePrimitive_Rect:     RenderSoftwareDrawRect(renderer, primitive, x0, y0, x1, y1); break;
+      case RenderSoftwarePrimitive_Triangle: RenderSoftwareDrawTriangle(renderer, primitive, x0, y0, x1, y1); break;
+      case RenderSoftwarePrimitive_Line:     RenderSoftwareDrawLine(renderer, primitive, x0, y0, x1, y1); break;
+      case RenderSoftwarePrimitive_Image:    RenderSoftwareDrawImage(renderer, primitive, x0, y0, x1, y1); break;
+      case RenderSoftwarePrimitive_Sprite:   RenderSoftwareDrawSprite(renderer, primitive, x0, y0, x1, y1); break;
+      case RenderSoftwarePrimitive_Tilemap:  RenderSoftwareDrawTilemap(renderer, primitive, x0, y0, x1, y1); break;
+    }
+  }
+}
+
+function void
+RenderSoftwareTileJob(void *param, u32 jobIdx, u32 jobCount)
+{
+  Unused(jobIdx);
+  Unused(jobCount);
+
+  // Tiles cost very different amounts, so they're handed out one at a time
+  RenderSoftware *renderer = (RenderSoftware*)param;
+  u64 tileCount = (u64)renderer->tilesX * renderer->tilesY;
+  for (u64 tileIdx = AtomicAddU64(&renderer->nextTile, 1) - 1; tileIdx < tileCount; tileIdx = AtomicAddU64(&renderer->nextTile, 1) - 1) {
+    RenderSoftwareDrawTile(renderer, (u32)tileIdx);
+  }
+}
+
+// Bins primitives from begin on until the bins are full, returns where it stopped
+function u64
+RenderSoftwareBin(RenderSoftware *renderer, u64 begin)
+{
+  u32 tileCount = renderer->tilesX * renderer->tilesY;
+  MemoryZero(renderer->binCounts, tileCount * sizeof(u32));
+
+  // Count, then lay the bins out and fill them in primitive order
+  u64 entryCount = 0;
+  u64 end = begin;
+  for (; end < renderer->primitiveCount; ++end) {
+    RenderSoftwarePrimitive *primitive = &renderer->primitives[end];
+    u32 tileX0 = (u32)primitive->x0 / RENDER_SOFTWARE_TILE_SIZE;
+    u32 tileY0 = (u32)primitive->y0 / RENDER_SOFTWARE_TILE_SIZE;
+    u32 tileX1 = ((u32)primitive->x1 + RENDER_SOFTWARE_TILE_SIZE - 1) / RENDER_SOFTWARE_TILE_SIZE;
+    u32 tileY1 = ((u32)primitive->y1 + RENDER_SOFTWARE_TILE_SIZE - 1) / RENDER_SOFTWARE_TILE_SIZE;
+    u64 tiles = (u64)(tileX1 - tileX0) * (tileY1 - tileY0);
+    if (entryCount + tiles > renderer->binCapacity) {
+      break;
+    }
+    entryCount += tiles;
+    for (u32 tileY = tileY0; tileY < tileY1; ++tileY) {
+      for (u32 tileX = tileX0; tileX < tileX1; ++tileX) {
+        renderer->binCounts[tileY * renderer->tilesX + tileX]++;
+      }
+    }
+  }
+
+  u32 offset = 0;
+  for (u32 tileIdx = 0; tileIdx < tileCount; ++tileIdx) {
+    renderer->binOffsets[tileIdx] = offset;
+    offset += renderer->binCounts[tileIdx];
+    renderer->binCounts[tileIdx] = 0;
+  }
+
+  for (u64 primitiveIdx = begin; primitiveIdx < end; ++primitiveIdx) {
+    RenderSoftwarePrimitive *primitive = &renderer->primitives[primitiveIdx];
+    u32 tileX0 = (u32)primitive->x0 / RENDER_SOFTWARE_TILE_SIZE;
+    u32 tileY0 = (u32)primitive->y0 / RENDER_SOFTWARE_TILE_SIZE;
+    u32 tileX1 = ((u32)primitive->x1 + RENDER_SOFTWARE_TILE_SIZE - 1) / RENDER_SOFTWARE_TILE_SIZE;
+    u32 tileY1 = ((u32)primitive->y1 + RENDER_SOFTWARE_TILE_SIZE - 1) / RENDER_SOFTWARE_TILE_SIZE;
+    for (u32 tileY = tileY0; tileY < tileY1; ++tileY) {
+      for (u32 tileX = tileX0; tileX < tileX1; ++tileX) {
+        u32 tileIdx = tileY * renderer->tilesX + tileX;
+        renderer->binEntries[renderer->binOffsets[tileIdx] + renderer->binCounts[tileIdx]++] = (u32)primitiveIdx;
+      }
+    }
+  }
+  renderer->stats.binEntries += entryCount;
+
+  return end;
+}
+
+// The new framebuffer is made before the old one goes, false keeps the old one and its size
+function b32
+RenderSoftwareResize(RenderSoftware *renderer, u64 width, u64 height)
+{
+  b32 result = true;
+  if (renderer->width != width || renderer->height != height) {
+    u64 pixelBytes = AlignUpPow2(Max(width * height, 1) * sizeof(u32), Kilobytes(4));
+    u32 *pixels = (u32*)OSMemReserve(pixelBytes);
+    result = pixels && OSMemCommit(pixels, pixelBytes);
+    if (result) {
+      if (renderer->pixels) {
+        OSMemRelease(renderer->pixels, renderer->pixelBytes);
+      }
+      renderer->pixels = pixels;
+      renderer->pixelBytes = pixelBytes;
+      renderer->width = width;
+      renderer->height = height;
+      renderer->tilesX = (u32)((width + RENDER_SOFTWARE_TILE_SIZE - 1) / RENDER_SOFTWARE_TILE_SIZE);
+      renderer->tilesY = (u32)((height + RENDER_SOFTWARE_TILE_SIZE - 1) / RENDER_SOFTWARE_TILE_SIZE);
+    } else if (pixels) {
+      OSMemRelease(pixels, pixelBytes);
+    }
+  }
+
+  return result;
+}
+
+// Renderer
+
+function b32
+RenderSoftwareInit(RenderSoftware *renderer, Arena *arena, u64 maxCommands)
+{
+  MemoryZeroStruct(renderer);
+  OSJobPoolStart(&renderer->pool, OSProcessorCount() - 1);
+  RenderSorterInit(&renderer->sorter, arena, maxCommands, &renderer->pool);
+
+  // Enough for any one primitive, it covers at most every tile of the largest frame
+  renderer->binCapacity = Max(maxCommands * RENDER_SOFTWARE_BIN_FACTOR, RENDER_SOFTWARE_MAX_TILES);
+  renderer->primitives = ArenaPushN(arena, RenderSoftwarePrimitive, maxCommands);
+  renderer->binCounts = ArenaPushN(arena, u32, RENDER_SOFTWARE_MAX_TILES);
+  renderer->binOffsets = ArenaPushN(arena, u32, RENDER_SOFTWARE_MAX_TILES);
+  renderer->binEntries = ArenaPushN(arena, u32, renderer->binCapacity);
+  renderer->textureArena = arena;
+  renderer->isValid = renderer->primitives && renderer->binCounts && renderer->binOffsets && renderer->binEntries;
+
+  if (renderer->isValid) {
+    // Texture 0, so untextured sprites and bad handles draw in their plain color
+    u32 white = 0xFFFFFFFF;
+    renderer->isValid = RenderSoftwareTextureCreate(renderer, 1, 1, &white) == 0 && renderer->textureCount == 1;
+  }
+
+  return renderer->isValid;
+}
+
+function void
+RenderSoftwareShutdown(RenderSoftware *renderer)
+{
+  if (renderer->pixels) {
+    OSMemRelease(renderer->pixels, renderer->pixelBytes);
+    renderer->pixels = 0;
+  }
+  renderer->isValid = false;
+  OSJobPoolStop(&renderer->pool);
+}
+
+function void
+RenderSoftwareExecute(RenderSoftware *renderer, RenderCommands *commands)
+{
+  // A frame the framebuffer can't be resized for is skipped, the last one stays
+  Assert(commands->frameWidth <= RENDER_SOFTWARE_MAX_FRAME && commands->frameHeight <= RENDER_SOFTWARE_MAX_FRAME);
+  if (renderer->isValid && RenderSoftwareResize(renderer, commands->frameWidth, commands->frameHeight)) {
+    u64 startNs = OSNowNs();
+    u64 *keys = RenderSortKeys(&renderer->sorter, commands->keys, commands->count);
+    RenderSoftwareStats *stats = &renderer->stats;
+    MemoryZeroStruct(stats);
+    stats->commandCount = commands->count;
+    stats->droppedCommands = commands->dropped;
+    stats->culledCommands = commands->culled;
+    stats->sortNs = renderer->sorter.sortNs;
+    stats->sortPasses = renderer->sorter.passCount;
+
+    renderer->clearColor = commands->clearColor;
+    stats->tiles = (u64)renderer->tilesX * renderer->tilesY;
+
+    u64 setupStartNs = OSNowNs();
+    renderer->primitiveCount = 0;
+    for (u64 keyIdx = 0; keyIdx < commands->count; ++keyIdx) {
+      u64 key = keys[keyIdx];
+      RenderCommand *command = &commands->commands[key & RENDER_KEY_INDEX_MASK];
+      if (RenderSoftwareSetup(renderer, &renderer->primitives[renderer->primitiveCount], commands, command, key)) {
+        renderer->primitiveCount++;
+      }
+    }
+    stats->primitives = renderer->primitiveCount;
+    stats->setupNs = OSNowNs() - setupStartNs;
+
+    // Every run covers all tiles, the first one also clears them
+    u64 rasterStartNs = OSNowNs();
+    u64 begin = 0;
+    renderer->isFirstRun = true;
+    do {
+      begin = RenderSoftwareBin(renderer, begin);
+      renderer->nextTile = 0;
+      OSJobPoolRun(&renderer->pool, RenderSoftwareTileJob, renderer);
+      renderer->isFirstRun = false;
+      stats->binRuns++;
+    } while (begin < renderer->primitiveCount);
+    stats->rasterNs = OSNowNs() - rasterStartNs;
+
+    // Nothing is cached here, every cached layer gets drawn again
+    MemoryZeroArray(commands->validLayers);
+    stats->totalNs = OSNowNs() - startNs;
+  }
+}
+
+function RenderTexture
+RenderSoftwareTextureCreate(RenderSoftware *renderer, u32 width, u32 height, void *pixels)
+{
+  RenderTexture result = 0;
+  if (renderer->textureCount < RENDER_MAX_TEXTURES && width && height) {
+    u32 *copy = ArenaPushN(renderer->textureArena, u32, (u64)width * height);
+    if (copy) {
+      MemoryCopy(copy, pixels, (u64)width * height * sizeof(u32));
+      result = renderer->textureCount++;
+      renderer->textures[result].width = width;
+      renderer->textures[result].height = height;
+      renderer->textures[result].pixels = copy;
+    }
+  }
+
+  return result;
+}
+
+// Golden images
+
+#define RENDER_TGA_HEADER_SIZE 18
+
+// RGBA and BGRA into each other, red and blue swap places
+function inline u32
+RenderSoftwareSwapRB(u32 pixel)
+{
+  u32 result = (pixel & 0xFF00FF00) | ((pixel & 0xFF) << 16) | ((pixel >> 16) & 0xFF);
+  return result;
+}
+
+function b32
+RenderSoftwareSaveImage(String8 path, u32 *pixels, u64 width, u64 height)
+{
+  b32 result = false;
+  OSFile file = OSFileOpenWrite(path);
+  if (file.handle && width <= 0xFFFF && height <= 0xFFFF) {
+    // Uncompressed true color, 8 bits of alpha, origin at the bottom left like the framebuffer
+    u8 header[RENDER_TGA_HEADER_SIZE] = {0};
+    header[2] = 2;
+    header[12] = (u8)width;
+    header[13] = (u8)(width >> 8);
+    header[14] = (u8)height;
+    header[15] = (u8)(height >> 8);
+    header[16] = 32;
+    header[17] = 8;
+    u64 offset = OSFileWrite(file, 0, header, sizeof(header));
+
+    u32 buffer[1024];
+    u64 pixelCount = width * height;
+    for (u64 pixelIdx = 0; pixelIdx < pixelCount; pixelIdx += ArrayCount(buffer)) {
+      u64 count = Min(pixelCount - pixelIdx, ArrayCount(buffer));
+      for (u64 bufferIdx = 0; bufferIdx < count; ++bufferIdx) {
+        buffer[bufferIdx] = RenderSoftwareSwapRB(pixels[pixelIdx + bufferIdx]);
+      }
+      offset += OSFileWrite(file, offset, buffer, count * sizeof(u32));
+    }
+    result = offset == sizeof(header) + pixelCount * sizeof(u32);
+  }
+  if (file.handle) {
+    OSFileClose(file);
+  }
+
+  return result;
+}
+
+function u32*
+RenderSoftwareLoadImage(Arena *arena, String8 path, u64 *width, u64 *height)
+{
+  u32 *result = 0;
+  OSFile file = OSFileOpen(path);
+  if (file.handle) {
+    u8 header[RENDER_TGA_HEADER_SIZE] = {0};
+    if (OSFileRead(file, 0, header, sizeof(header)) == sizeof(header) &&
+        header[0] == 0 && header[1] == 0 && header[2] == 2 && header[16] == 32 && (header[17] & 0x30) == 0) {
+      u64 imageWidth = header[12] | ((u64)header[13] << 8);
+      u64 imageHeight = header[14] | ((u64)header[15] << 8);
+      u64 size = imageWidth * imageHeight * sizeof(u32);
+      u32 *pixels = (u32*)ArenaPushNoZero(arena, size, _Alignof(u32));
+      if (pixels && OSFileRead(file, sizeof(header), pixels, size) == size) {
+        for (u64 pixelIdx = 0; pixelIdx < imageWidth * imageHeight; ++pixelIdx) {
+          pixels[pixelIdx] = RenderSoftwareSwapRB(pixels[pixelIdx]);
+        }
+        *width = imageWidth;
+        *height = imageHeight;
+        result = pixels;
+      }
+    }
+    OSFileClose(file);
+  }
+
+  return result;
+}
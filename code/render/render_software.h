@@ -0,0 +1,129 @@
+#ifndef RENDER_SOFTWARE_H
+#define RENDER_SOFTWARE_H
+
+/*
+  CPU side renderer, executes RenderCommands into a framebuffer in memory without a GPU or
+  a display. For headless runs: frames get hashed and compared to golden images, and the
+  renderer's CPU cost can be measured on machines that have no GPU at all.
+
+  Draws what the sokol backend draws: rects, lines, triangles, sprites and tilemaps through
+  the camera's view, every blend mode with sokol_gp's factors, nearest sampled textures.
+  Cached layers are drawn every frame like any other, the game is never told they're valid.
+
+  Commands are sorted like the GPU backend's, turned into screen space primitives in order
+  and binned into square tiles. Each tile walks its bin in order, so tiles are independent
+  and the job pool rasterizes them in parallel, with the same result whatever the thread
+  count. When the bins would overflow the frame is done in several runs of primitives.
+  Solid spans are filled and blended 4 pixels at a time. Triangle edges are tested in fixed
+  point with a tie rule, so triangles sharing an edge cover every pixel on it exactly once.
+
+  Pixels are RGBA8 like RenderColor, bottom row first like a GL readback.
+*/
+
+#define RENDER_SOFTWARE_TILE_SIZE     64 // Pixels per tile side
+#define RENDER_SOFTWARE_MAX_FRAME     16384 // Pixels per frame side
+#define RENDER_SOFTWARE_MAX_TILES     ((RENDER_SOFTWARE_MAX_FRAME / RENDER_SOFTWARE_TILE_SIZE) * (RENDER_SOFTWARE_MAX_FRAME / RENDER_SOFTWARE_TILE_SIZE))
+#define RENDER_SOFTWARE_BIN_FACTOR    16 // Bin entries per command of capacity
+#define RENDER_SOFTWARE_SUBPIXEL_BITS 8
+#define RENDER_SOFTWARE_MAX_COORD     (1 << 22) // Screen space clamp, keeps edge functions within s64
+
+typedef u8 RenderSoftwarePrimitiveKind;
+enum
+{
+  RenderSoftwarePrimitive_Rect,     // Solid, axis aligned
+  RenderSoftwarePrimitive_Triangle,
+  RenderSoftwarePrimitive_Line,
+  RenderSoftwarePrimitive_Image,    // Textured, axis aligned
+  RenderSoftwarePrimitive_Sprite,   // Textured, rotated
+  RenderSoftwarePrimitive_Tilemap,  // Drawn as images, only the tiles a pixel tile overlaps
+};
+
+typedef struct RenderSoftwareTexture RenderSoftwareTexture;
+struct RenderSoftwareTexture
+{
+  u32 width, height;
+  u32 *pixels; // Top row first
+};
+
+typedef struct RenderSoftwarePrimitive RenderSoftwarePrimitive;
+struct RenderSoftwarePrimitive
+{
+  RenderSoftwarePrimitiveKind kind;
+  RenderBlend blend;
+  RenderColor color;
+  RenderSoftwareTexture *texture;
+  s32 x0, y0, x1, y1; // Pixels it may touch, clipped to the frame, max exclusive
+
+  union
+  {
+    struct { s64 x[3], y[3]; } triangle; // Fixed point, counter-clockwise
+    struct { f32 x0, y0, x1, y1; } line;
+    struct { f32 x0, y0, x1, y1; f32 u0, v0, u1, v1; } image; // Screen rect, UVs of its bottom left and top right
+    struct { f32 originX, originY, dsdx, dsdy, dtdx, dtdy; f32 u0, v0, u1, v1; } sprite; // Screen position of corner (0, 0), screen to corner space
+    struct { RenderTilemap *map; f32 originX, originY, tileWidth, tileHeight; } tilemap; // Screen space
+  };
+};
+
+typedef struct RenderSoftwareStats RenderSoftwareStats;
+struct RenderSoftwareStats
+{
+  u64 commandCount;
+  u64 droppedCommands;
+  u64 culledCommands;
+  u64 sortNs;
+  u32 sortPasses;
+  u64 primitives;
+  u64 binEntries; // Primitive and tile pairs
+  u64 binRuns;    // Over 1 when the bins overflowed
+  u64 tiles;
+  u64 setupNs;
+  u64 rasterNs;
+  u64 totalNs;
+};
+
+typedef struct RenderSoftware RenderSoftware;
+struct RenderSoftware
+{
+  b32 isValid;
+  OSJobPool pool; // Sorts and rasterizes
+  RenderSorter sorter;
+
+  RenderSoftwareTexture textures[RENDER_MAX_TEXTURES]; // Indexed by RenderTexture
+  u32 textureCount;
+  Arena *textureArena;
+
+  RenderSoftwarePrimitive *primitives;
+  u64 primitiveCount;
+
+  // Bins for the current run, tile by tile
+  u32 *binCounts;
+  u32 *binOffsets;
+  u32 *binEntries;
+  u64 binCapacity;
+
+  // Framebuffer, remade when the frame size changes
+  u32 *pixels;
+  u64 width, height;
+  u64 pixelBytes;
+  u32 tilesX, tilesY;
+  RenderColor clearColor;
+
+  // Current run, tiles are claimed by the jobs one at a time
+  b32 isFirstRun;
+  volatile u64 nextTile;
+
+  RenderSoftwareStats stats; // Last frame
+};
+
+function b32  RenderSoftwareInit(RenderSoftware *renderer, Arena *arena, u64 maxCommands);
+function void RenderSoftwareShutdown(RenderSoftware *renderer);
+function void RenderSoftwareExecute(RenderSoftware *renderer, RenderCommands *commands);
+
+// RGBA8 pixels, top row first, copied into the arena given to init. 0 when out of textures
+function RenderTexture RenderSoftwareTextureCreate(RenderSoftware *renderer, u32 width, u32 height, void *pixels);
+
+// Golden images, uncompressed 32 bit TGA in framebuffer order. Paths must be null terminated
+function b32  RenderSoftwareSaveImage(String8 path, u32 *pixels, u64 width, u64 height);
+function u32* RenderSoftwareLoadImage(Arena *arena, String8 path, u64 *width, u64 *height); // 0 if missing or not ours
+
+#endif // RENDER_SOFTWARE_H
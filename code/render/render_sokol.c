@@ -0,0 +1,1009 @@
+// Submission
+
+function void
+RenderSokolSetColor(RenderColor color)
+{
+  sgp_set_color((f32)((color >> 0) & 0xFF) / 255.f,
+                (f32)((color >> 8) & 0xFF) / 255.f,
+                (f32)((color >> 16) & 0xFF) / 255.f,
+                (f32)((color >> 24) & 0xFF) / 255.f);
+}
+
+// Streaming
+
+function u32
+RenderStreamSize(u32 needed, u32 minSize, u32 maxSize)
+{
+  u32 result = minSize;
+  while (result < needed && result < maxSize) {
+    result *= 2;
+  }
+
+  return result;
+}
+
+function b32
+RenderStreamSetup(RenderStream *stream, u32 maxVertices, u32 maxCommands)
+{
+  if (sgp_is_valid()) {
+    sgp_shutdown();
+  }
+
+  sgp_desc sgpDesc = {0};
+  sgpDesc.max_vertices = maxVertices;
+  sgpDesc.max_commands = maxCommands;
+  sgp_setup(&sgpDesc);
+
+  b32 result = sgp_is_valid();
+  if (result) {
+    stream->maxVertices = maxVertices;
+    stream->maxCommands = maxCommands;
+  }
+
+  return result;
+}
+
+// Between frames only, sokol_gp gets rebuilt
+function void
+RenderStreamResize(RenderStream *stream)
+{
+  b32 isWindowOver = ++stream->windowFrames >= RENDER_STREAM_WINDOW;
+  u32 maxVertices = stream->maxVertices;
+  u32 maxCommands = stream->maxCommands;
+  u32 neededVertices = RenderStreamSize(stream->peakVertices, RENDER_STREAM_MIN_VERTICES, RENDER_STREAM_MAX_VERTICES);
+  u32 neededCommands = RenderStreamSize(stream->peakCommands, RENDER_STREAM_MIN_VERTICES / 4, RENDER_STREAM_MAX_VERTICES / 4);
+
+  // Grow as soon as a frame had to split, shrink with hysteresis once the window is over
+  if (neededVertices > maxVertices || (isWindowOver && neededVertices * 4 <= maxVertices)) {
+    maxVertices = neededVertices;
+  }
+  if (neededCommands > maxCommands || (isWindowOver && neededCommands * 4 <= maxCommands)) {
+    maxCommands = neededCommands;
+  }
+
+  if (maxVertices != stream->maxVertices || maxCommands != stream->maxCommands) {
+    u32 oldVertices = stream->maxVertices;
+    u32 oldCommands = stream->maxCommands;
+    if (!RenderStreamSetup(stream, maxVertices, maxCommands)) {
+      RenderStreamSetup(stream, oldVertices, oldCommands);
+    }
+  }
+
+  if (isWindowOver) {
+    stream->windowFrames = 0;
+    stream->peakVertices = stream->frameVertices;
+    stream->peakCommands = stream->frameCommands;
+  }
+}
+
+function void
+RenderStreamFlush(RenderStream *stream, RenderStats *stats)
+{
+  sgp_usage usage = sgp_query_usage();
+  stream->frameVertices += usage.vertices;
+  stream->frameCommands += usage.commands;
+  sgp_flush();
+  stats->flushes++;
+}
+
+// Draws that don't go through sokol_gp call this first, so what's queued stays in order
+function void
+RenderStreamFlushPending(RenderStream *stream, RenderStats *stats)
+{
+  if (sgp_query_usage().commands) {
+    RenderStreamFlush(stream, stats);
+  }
+}
+
+// Inside the pass, flushes what's queued when the next batch might not fit. sokol_gp may
+// copy the previous batch's vertices to merge with it, so that needs room too
+function void
+RenderStreamReserve(RenderStream *stream, RenderStats *stats)
+{
+  sgp_usage usage = sgp_query_usage();
+  if (usage.vertices + 2 * RENDER_BATCH_MAX_VERTICES > usage.max_vertices ||
+      usage.commands + 1 > usage.max_commands ||
+      usage.uniforms + 1 > usage.max_uniforms) {
+    RenderStreamFlush(stream, stats);
+  }
+}
+
+// Batching
+
+function void
+RenderBatchFlush(RenderBackend *backend)
+{
+  RenderBatch *batch = &backend->batch;
+  if (batch->count) {
+    RenderStreamReserve(&backend->stream, &backend->stats);
+    switch (batch->kind) {
+      case RenderCommand_Rect: {
+        sgp_draw_filled_rects(batch->rects, batch->count);
+      } break;
+
+      case RenderCommand_Line: {
+        sgp_draw_lines(batch->lines, batch->count);
+      } break;
+
+      case RenderCommand_Triangle: {
+        sgp_draw_filled_triangles(batch->triangles, batch->count);
+      } break;
+    }
+    backend->stats.batches++;
+    batch->count = 0;
+  }
+}
+
+function void
+RenderBatchPush(RenderBackend *backend, RenderCommand *command)
+{
+  RenderBatch *batch = &backend->batch;
+  if (batch->kind != command->kind || batch->count == RENDER_BATCH_MAX) {
+    RenderBatchFlush(backend);
+    batch->kind = command->kind;
+  }
+
+  u32 idx = batch->count++;
+  switch (command->kind) {
+    case RenderCommand_Rect: {
+      batch->rects[idx] = (sgp_rect){command->rect.x, command->rect.y, command->rect.w, command->rect.h};
+    } break;
+
+    case RenderCommand_Line: {
+      batch->lines[idx] = (sgp_line){{command->line.x0, command->line.y0}, {command->line.x1, command->line.y1}};
+    } break;
+
+    case RenderCommand_Triangle: {
+      batch->triangles[idx] = (sgp_triangle){{command->triangle.x0, command->triangle.y0},
+                                             {command->triangle.x1, command->triangle.y1},
+                                             {command->triangle.x2, command->triangle.y2}};
+    } break;
+  }
+}
+
+// Sprites
+
+// Six corners per instance from gl_VertexID, GL 3.3 only like the rest of the backend.
+// y is up while images are stored top row first, so v gets flipped
+global char *g_spriteVertexSource =
+  "#version 330\n"
+  "uniform vec4 projection;\n"
+  "in vec4 rect;\n"
+  "in float rotation;\n"
+  "in vec4 uvRect;\n"
+  "in vec4 color;\n"
+  "out vec2 uv;\n"
+  "out vec4 tint;\n"
+  "const vec2 corners[6] = vec2[6](vec2(0, 0), vec2(1, 0), vec2(0, 1), vec2(1, 0), vec2(1, 1), vec2(0, 1));\n"
+  "void main() {\n"
+  "  vec2 corner = corners[gl_VertexID];\n"
+  "  vec2 local = (corner - 0.5) * rect.zw;\n"
+  "  float c = cos(rotation);\n"
+  "  float s = sin(rotation);\n"
+  "  vec2 position = rect.xy + vec2(local.x * c - local.y * s, local.x * s + local.y * c);\n"
+  "  gl_Position = vec4(position * projection.xy + projection.zw, 0.0, 1.0);\n"
+  "  uv = mix(uvRect.xy, uvRect.zw, vec2(corner.x, 1.0 - corner.y));\n"
+  "  tint = color;\n"
+  "}\n";
+
+global char *g_spriteFragmentSource =
+  "#version 330\n"
+  "uniform sampler2D tex;\n"
+  "in vec2 uv;\n"
+  "in vec4 tint;\n"
+  "out vec4 fragColor;\n"
+  "void main() {\n"
+  "  fragColor = texture(tex, uv) * tint;\n"
+  "}\n";
+
+function sg_pipeline
+RenderSpritesPipeline(sg_shader shader, sg_blend_state blend)
+{
+  sg_pipeline_desc pipelineDesc = {0};
+  pipelineDesc.shader = shader;
+  pipelineDesc.layout.buffers[0].stride = sizeof(RenderSpriteInstance);
+  pipelineDesc.layout.buffers[0].step_func = SG_VERTEXSTEP_PER_INSTANCE;
+  pipelineDesc.layout.attrs[0].offset = OffsetOf(RenderSpriteInstance, x);
+  pipelineDesc.layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT4;
+  pipelineDesc.layout.attrs[1].offset = OffsetOf(RenderSpriteInstance, rotation);
+  pipelineDesc.layout.attrs[1].format = SG_VERTEXFORMAT_FLOAT;
+  pipelineDesc.layout.attrs[2].offset = OffsetOf(RenderSpriteInstance, u0);
+  pipelineDesc.layout.attrs[2].format = SG_VERTEXFORMAT_USHORT4N;
+  pipelineDesc.layout.attrs[3].offset = OffsetOf(RenderSpriteInstance, color);
+  pipelineDesc.layout.attrs[3].format = SG_VERTEXFORMAT_UBYTE4N;
+  pipelineDesc.colors[0].blend = blend;
+  pipelineDesc.primitive_type = SG_PRIMITIVETYPE_TRIANGLES;
+  sg_pipeline result = sg_make_pipeline(&pipelineDesc);
+  return result;
+}
+
+function b32
+RenderSpritesSetup(RenderSprites *sprites, Arena *arena, u64 maxCommands)
+{
+  sg_shader_desc shaderDesc = {0};
+  shaderDesc.attrs[0].name = "rect";
+  shaderDesc.attrs[1].name = "rotation";
+  shaderDesc.attrs[2].name = "uvRect";
+  shaderDesc.attrs[3].name = "color";
+  shaderDesc.vs.source = g_spriteVertexSource;
+  shaderDesc.vs.uniform_blocks[0].size = sizeof(sprites->projection);
+  shaderDesc.vs.uniform_blocks[0].uniforms[0].name = "projection";
+  shaderDesc.vs.uniform_blocks[0].uniforms[0].type = SG_UNIFORMTYPE_FLOAT4;
+  shaderDesc.fs.source = g_spriteFragmentSource;
+  shaderDesc.fs.images[0].used = true;
+  shaderDesc.fs.images[0].image_type = SG_IMAGETYPE_2D;
+  shaderDesc.fs.images[0].sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+  shaderDesc.fs.samplers[0].used = true;
+  shaderDesc.fs.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+  shaderDesc.fs.image_sampler_pairs[0].used = true;
+  shaderDesc.fs.image_sampler_pairs[0].image_slot = 0;
+  shaderDesc.fs.image_sampler_pairs[0].sampler_slot = 0;
+  shaderDesc.fs.image_sampler_pairs[0].glsl_name = "tex";
+  sprites->shader = sg_make_shader(&shaderDesc);
+  b32 result = sg_query_shader_state(sprites->shader) == SG_RESOURCESTATE_VALID;
+
+  // One pipeline per blend mode, blending like sokol_gp's so both paths look the same
+  for (RenderBlend blend = 0; result && blend < RenderBlend_Count; ++blend) {
+    sprites->pipelines[blend] = RenderSpritesPipeline(sprites->shader, sgp_query_blend_state((sgp_blend_mode)blend));
+    result = sg_query_pipeline_state(sprites->pipelines[blend]) == SG_RESOURCESTATE_VALID;
+  }
+
+  if (result) {
+    sg_buffer_desc bufferDesc = {0};
+    bufferDesc.size = (maxCommands + RENDER_MAX_LAYER_TARGETS + 1) * sizeof(RenderSpriteInstance); // Plus composites and the stretch
+    bufferDesc.usage = SG_USAGE_STREAM;
+    sprites->instanceBuffer = sg_make_buffer(&bufferDesc);
+
+    sg_sampler_desc samplerDesc = {0};
+    samplerDesc.min_filter = SG_FILTER_NEAREST;
+    samplerDesc.mag_filter = SG_FILTER_NEAREST;
+    samplerDesc.wrap_u = SG_WRAP_CLAMP_TO_EDGE;
+    samplerDesc.wrap_v = SG_WRAP_CLAMP_TO_EDGE;
+    sprites->sampler = sg_make_sampler(&samplerDesc);
+
+    sprites->instances = ArenaPushN(arena, RenderSpriteInstance, maxCommands);
+    result = sg_query_buffer_state(sprites->instanceBuffer) == SG_RESOURCESTATE_VALID &&
+             sg_query_sampler_state(sprites->sampler) == SG_RESOURCESTATE_VALID;
+  }
+
+  return result;
+}
+
+function sg_image
+RenderSpritesTexture(RenderSprites *sprites, RenderTexture texture)
+{
+  sg_image result = sprites->textures[texture < sprites->textureCount ? texture : 0];
+  return result;
+}
+
+function void
+RenderSpritesFlush(RenderBackend *backend)
+{
+  RenderSprites *sprites = &backend->sprites;
+  if (sprites->count) {
+    RenderStreamFlushPending(&backend->stream, &backend->stats);
+
+    sg_range instances = {sprites->instances, sprites->count * sizeof(RenderSpriteInstance)};
+    sg_bindings bindings = {0};
+    bindings.vertex_buffers[0] = sprites->instanceBuffer;
+    bindings.vertex_buffer_offsets[0] = sg_append_buffer(sprites->instanceBuffer, &instances);
+    bindings.fs.images[0] = RenderSpritesTexture(sprites, sprites->texture);
+    bindings.fs.samplers[0] = sprites->sampler;
+    sg_apply_pipeline(sprites->pipelines[sprites->blend]);
+    sg_apply_bindings(&bindings);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(sprites->projection));
+    sg_draw(0, 6, (int)sprites->count);
+
+    backend->stats.sprites += sprites->count;
+    backend->stats.spriteDraws++;
+    sprites->count = 0;
+  }
+}
+
+// Only called within a run, the sort keeps sprites of one texture and blend mode together
+function void
+RenderSpritesPush(RenderSprites *sprites, RenderCommand *command, u64 key)
+{
+  if (!sprites->count) {
+    sprites->texture = (RenderTexture)RenderKeyField(key, TEXTURE);
+    sprites->blend = (RenderBlend)RenderKeyField(key, BLEND);
+  }
+
+  RenderSpriteInstance *instance = &sprites->instances[sprites->count++];
+  instance->x = command->sprite.x;
+  instance->y = command->sprite.y;
+  instance->w = command->sprite.w;
+  instance->h = command->sprite.h;
+  instance->rotation = command->sprite.rotation;
+  instance->u0 = command->sprite.u0;
+  instance->v0 = command->sprite.v0;
+  instance->u1 = command->sprite.u1;
+  instance->v1 = command->sprite.v1;
+  instance->color = command->color;
+}
+
+// Tilemaps
+
+function void
+RenderChunkBuild(RenderChunkCache *cache, RenderChunkSlot *slot, RenderTilemap *tilemap, u32 chunkIdx)
+{
+  u32 chunkX = (chunkIdx % tilemap->chunksX) * RENDER_TILEMAP_CHUNK_SIZE;
+  u32 chunkY = (chunkIdx / tilemap->chunksX) * RENDER_TILEMAP_CHUNK_SIZE;
+  u32 endX = Min(chunkX + RENDER_TILEMAP_CHUNK_SIZE, tilemap->width);
+  u32 endY = Min(chunkY + RENDER_TILEMAP_CHUNK_SIZE, tilemap->height);
+  f32 tileSize = tilemap->tileSize;
+  u32 tileCount = 0;
+  for (u32 y = chunkY; y < endY; ++y) {
+    for (u32 x = chunkX; x < endX; ++x) {
+      RenderTile tile = tilemap->tiles[(u64)y * tilemap->width + x];
+      if (tile) {
+        u32 atlasX = (tile - 1) % tilemap->atlasColumns;
+        u32 atlasY = ((tile - 1) / tilemap->atlasColumns) % tilemap->atlasRows;
+        RenderSpriteInstance *instance = &cache->scratch[tileCount++];
+        instance->x = ((f32)x + 0.5f) * tileSize;
+        instance->y = ((f32)y + 0.5f) * tileSize;
+        instance->w = tileSize;
+        instance->h = tileSize;
+        instance->rotation = 0.f;
+        instance->u0 = (u16)(atlasX * 65535 / tilemap->atlasColumns);
+        instance->v0 = (u16)(atlasY * 65535 / tilemap->atlasRows);
+        instance->u1 = (u16)((atlasX + 1) * 65535 / tilemap->atlasColumns);
+        instance->v1 = (u16)((atlasY + 1) * 65535 / tilemap->atlasRows);
+        instance->color = 0xFFFFFFFF;
+      }
+    }
+  }
+
+  if (slot->buffer.id != SG_INVALID_ID) {
+    sg_destroy_buffer(slot->buffer);
+    slot->buffer.id = SG_INVALID_ID;
+  }
+  if (tileCount) {
+    sg_buffer_desc bufferDesc = {0};
+    bufferDesc.data.ptr = cache->scratch;
+    bufferDesc.data.size = tileCount * sizeof(RenderSpriteInstance);
+    slot->buffer = sg_make_buffer(&bufferDesc);
+  }
+
+  slot->tilemap = tilemap;
+  slot->chunkIdx = chunkIdx;
+  slot->tileCount = sg_query_buffer_state(slot->buffer) == SG_RESOURCESTATE_VALID ? tileCount : 0;
+  tilemap->chunks[chunkIdx].isDirty = false;
+  tilemap->chunks[chunkIdx].cacheSlot = (u32)(slot - cache->slots);
+}
+
+// 0 when every slot is already in use this frame
+function RenderChunkSlot*
+RenderChunkCacheGet(RenderChunkCache *cache, RenderTilemap *tilemap, u32 chunkIdx, RenderStats *stats)
+{
+  RenderTilemapChunk *chunk = &tilemap->chunks[chunkIdx];
+  RenderChunkSlot *result = &cache->slots[chunk->cacheSlot % RENDER_MAX_CACHED_CHUNKS];
+  if (result->tilemap != tilemap || result->chunkIdx != chunkIdx) {
+    // Evicted or never built, take a free slot or the least recently used one
+    result = 0;
+    for (u32 slotIdx = 0; slotIdx < RENDER_MAX_CACHED_CHUNKS; ++slotIdx) {
+      RenderChunkSlot *slot = &cache->slots[slotIdx];
+      if (!slot->tilemap) {
+        result = slot;
+        break;
+      }
+      if (slot->lastUsedFrame < cache->frameIndex && (!result || slot->lastUsedFrame < result->lastUsedFrame)) {
+        result = slot;
+      }
+    }
+    chunk->isDirty = true;
+  }
+
+  if (result) {
+    if (chunk->isDirty) {
+      RenderChunkBuild(cache, result, tilemap, chunkIdx);
+      stats->chunksBuilt++;
+    }
+    result->lastUsedFrame = cache->frameIndex;
+  }
+
+  return result;
+}
+
+function void
+RenderTilemapExecute(RenderBackend *backend, RenderCommand *command, u64 key)
+{
+  RenderTilemap *tilemap = command->tilemap.map;
+  RenderSprites *sprites = &backend->sprites;
+  RenderStats *stats = &backend->stats;
+  f32 mapX = command->tilemap.x;
+  f32 mapY = command->tilemap.y;
+  f32 chunkSize = tilemap->tileSize * RENDER_TILEMAP_CHUNK_SIZE;
+
+  // Visible chunk range, offsets are positive once the view's past the map's start
+  f32 viewX0 = (backend->viewX0 - mapX) / chunkSize;
+  f32 viewY0 = (backend->viewY0 - mapY) / chunkSize;
+  f32 viewX1 = (backend->viewX1 - mapX) / chunkSize;
+  f32 viewY1 = (backend->viewY1 - mapY) / chunkSize;
+  u32 startX = viewX0 > 0.f ? (u32)Min(viewX0, (f32)tilemap->chunksX) : 0;
+  u32 startY = viewY0 > 0.f ? (u32)Min(viewY0, (f32)tilemap->chunksY) : 0;
+  u32 endX = viewX1 > 0.f ? (u32)Min(viewX1 + 1.f, (f32)tilemap->chunksX) : 0;
+  u32 endY = viewY1 > 0.f ? (u32)Min(viewY1 + 1.f, (f32)tilemap->chunksY) : 0;
+
+  if (startX < endX && startY < endY) {
+    RenderStreamFlushPending(&backend->stream, stats);
+
+    // Chunks are built in map space, the map's position goes into the projection
+    f32 projection[4] = {
+      sprites->projection[0],
+      sprites->projection[1],
+      sprites->projection[2] + mapX * sprites->projection[0],
+      sprites->projection[3] + mapY * sprites->projection[1],
+    };
+    sg_apply_pipeline(sprites->pipelines[RenderKeyField(key, BLEND)]);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(projection));
+
+    sg_bindings bindings = {0};
+    bindings.fs.images[0] = RenderSpritesTexture(sprites, tilemap->atlas);
+    bindings.fs.samplers[0] = sprites->sampler;
+    for (u32 chunkY = startY; chunkY < endY; ++chunkY) {
+      for (u32 chunkX = startX; chunkX < endX; ++chunkX) {
+        RenderChunkSlot *slot = RenderChunkCacheGet(&backend->chunkCache, tilemap, chunkY * tilemap->chunksX + chunkX, stats);
+        if (slot && slot->tileCount) {
+          bindings.vertex_buffers[0] = slot->buffer;
+          sg_apply_bindings(&bindings);
+          sg_draw(0, 6, (int)slot->tileCount);
+          stats->chunksDrawn++;
+        }
+      }
+    }
+  }
+}
+
+// Layer caching
+
+function void
+RenderLayerTargetRelease(RenderLayerCache *cache, RenderLayerTarget *target)
+{
+  sg_destroy_pass(target->pass);
+  sg_destroy_image(target->depth);
+  sg_destroy_image(target->color);
+  cache->usedBytes -= cache->width * cache->height * 8;
+  MemoryZeroStruct(target);
+}
+
+// The composite is premultiplied alpha, which only gives the same result as drawing the
+// layer in place when everything in it is alpha blended
+function b32
+RenderRangeIsAlphaBlended(u64 *keys, u64 begin, u64 opl)
+{
+  b32 result = true;
+  for (u64 keyIdx = begin; keyIdx < opl && result; ++keyIdx) {
+    result = RenderKeyField(keys[keyIdx], BLEND) == RenderBlend_Alpha;
+  }
+
+  return result;
+}
+
+function b32
+RenderLayerCacheSetup(RenderLayerCache *cache, RenderSprites *sprites)
+{
+  sg_blend_state blend = {0};
+  blend.enabled = true;
+  blend.src_factor_rgb = SG_BLENDFACTOR_ONE;
+  blend.dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+  blend.src_factor_alpha = SG_BLENDFACTOR_ONE;
+  blend.dst_factor_alpha = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+  cache->compositePipeline = RenderSpritesPipeline(sprites->shader, blend);
+
+  b32 result = sg_query_pipeline_state(cache->compositePipeline) == SG_RESOURCESTATE_VALID;
+  return result;
+}
+
+// Targets are as big as the frame, a resize drops them all (the game already knows)
+function void
+RenderLayerCacheResize(RenderLayerCache *cache, u64 width, u64 height)
+{
+  if (cache->width != width || cache->height != height) {
+    for (u32 targetIdx = 0; targetIdx < RENDER_MAX_LAYER_TARGETS; ++targetIdx) {
+      if (cache->targets[targetIdx].isUsed) {
+        RenderLayerTargetRelease(cache, &cache->targets[targetIdx]);
+      }
+    }
+    cache->width = width;
+    cache->height = height;
+  }
+}
+
+function RenderLayerTarget*
+RenderLayerCacheFind(RenderLayerCache *cache, u8 layer)
+{
+  RenderLayerTarget *result = 0;
+  for (u32 targetIdx = 0; targetIdx < RENDER_MAX_LAYER_TARGETS; ++targetIdx) {
+    RenderLayerTarget *target = &cache->targets[targetIdx];
+    if (target->isUsed && target->layer == layer) {
+      result = target;
+      break;
+    }
+  }
+
+  return result;
+}
+
+// The layer's target, or a new one that evicted whatever wasn't used for the longest.
+// Targets used this frame are never evicted, 0 when the rest don't make enough room
+function RenderLayerTarget*
+RenderLayerCacheAcquire(RenderLayerCache *cache, u8 layer, RenderStats *stats)
+{
+  RenderLayerTarget *result = RenderLayerCacheFind(cache, layer);
+  u64 targetBytes = cache->width * cache->height * 8;
+  while (!result && targetBytes <= RENDER_LAYER_CACHE_BUDGET) {
+    RenderLayerTarget *freeTarget = 0;
+    RenderLayerTarget *oldest = 0;
+    for (u32 targetIdx = 0; targetIdx < RENDER_MAX_LAYER_TARGETS; ++targetIdx) {
+      RenderLayerTarget *target = &cache->targets[targetIdx];
+      if (!target->isUsed) {
+        freeTarget = freeTarget ? freeTarget : target;
+      } else if (target->lastUsedFrame < cache->frameIndex && (!oldest || target->lastUsedFrame < oldest->lastUsedFrame)) {
+        oldest = target;
+      }
+    }
+
+    if (freeTarget && cache->usedBytes + targetBytes <= RENDER_LAYER_CACHE_BUDGET) {
+      sg_image_desc imageDesc = {0};
+      imageDesc.render_target = true;
+      imageDesc.width = (int)cache->width;
+      imageDesc.height = (int)cache->height;
+      freeTarget->color = sg_make_image(&imageDesc);
+      imageDesc.pixel_format = SG_PIXELFORMAT_DEPTH_STENCIL;
+      freeTarget->depth = sg_make_image(&imageDesc);
+
+      sg_pass_desc passDesc = {0};
+      passDesc.color_attachments[0].image = freeTarget->color;
+      passDesc.depth_stencil_attachment.image = freeTarget->depth;
+      freeTarget->pass = sg_make_pass(&passDesc);
+
+      freeTarget->isUsed = true;
+      freeTarget->layer = layer;
+      cache->usedBytes += targetBytes;
+      if (sg_query_pass_state(freeTarget->pass) == SG_RESOURCESTATE_VALID) {
+        result = freeTarget;
+      } else {
+        RenderLayerTargetRelease(cache, freeTarget);
+        break;
+      }
+    } else if (oldest) {
+      RenderLayerTargetRelease(cache, oldest);
+      stats->layerEvictions++;
+    } else {
+      break;
+    }
+  }
+
+  return result;
+}
+
+function void
+RenderLayerComposite(RenderBackend *backend, RenderLayerTarget *target)
+{
+  RenderSprites *sprites = &backend->sprites;
+  RenderStreamFlushPending(&backend->stream, &backend->stats);
+
+  // Targets are stored bottom row first, unlike images
+  f32 width = (f32)backend->layerCache.width;
+  f32 height = (f32)backend->layerCache.height;
+  RenderSpriteInstance instance = {width * 0.5f, height * 0.5f, width, height, 0.f, 0, 65535, 65535, 0, 0xFFFFFFFF};
+  sg_bindings bindings = {0};
+  bindings.vertex_buffers[0] = sprites->instanceBuffer;
+  bindings.vertex_buffer_offsets[0] = sg_append_buffer(sprites->instanceBuffer, &SG_RANGE(instance));
+  bindings.fs.images[0] = target->color;
+  bindings.fs.samplers[0] = sprites->sampler;
+  sg_apply_pipeline(backend->layerCache.compositePipeline);
+  sg_apply_bindings(&bindings);
+  sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(backend->screenProjection));
+  sg_draw(0, 6, 1);
+  backend->stats.layersComposited++;
+}
+
+// Resolution scaling
+
+function void
+RenderScalerRelease(RenderScaler *scaler)
+{
+  if (scaler->pass.id != SG_INVALID_ID) {
+    sg_destroy_pass(scaler->pass);
+    sg_destroy_image(scaler->depth);
+    sg_destroy_image(scaler->color);
+    scaler->pass.id = SG_INVALID_ID;
+    scaler->width = 0;
+    scaler->height = 0;
+  }
+}
+
+// Whether this frame goes through the offscreen target, which is (re)made as needed
+function b32
+RenderScalerPrepare(RenderScaler *scaler, u64 frameWidth, u64 frameHeight)
+{
+  if (scaler->scale < 1.f && (scaler->frameWidth != frameWidth || scaler->frameHeight != frameHeight || !scaler->width)) {
+    RenderScalerRelease(scaler);
+
+    sg_image_desc imageDesc = {0};
+    imageDesc.render_target = true;
+    imageDesc.width = Max((int)((f32)frameWidth * scaler->maxScale + 0.5f), 1);
+    imageDesc.height = Max((int)((f32)frameHeight * scaler->maxScale + 0.5f), 1);
+    scaler->color = sg_make_image(&imageDesc);
+    imageDesc.pixel_format = SG_PIXELFORMAT_DEPTH_STENCIL;
+    scaler->depth = sg_make_image(&imageDesc);
+
+    sg_pass_desc passDesc = {0};
+    passDesc.color_attachments[0].image = scaler->color;
+    passDesc.depth_stencil_attachment.image = scaler->depth;
+    scaler->pass = sg_make_pass(&passDesc);
+
+    scaler->frameWidth = frameWidth;
+    scaler->frameHeight = frameHeight;
+    if (sg_query_pass_state(scaler->pass) == SG_RESOURCESTATE_VALID) {
+      scaler->width = (u64)imageDesc.width;
+      scaler->height = (u64)imageDesc.height;
+    } else {
+      RenderScalerRelease(scaler);
+    }
+  }
+
+  b32 result = scaler->scale < 1.f && scaler->width;
+  return result;
+}
+
+// Stretches the bottom left width x height of the target over the frame
+function void
+RenderScalerBlit(RenderBackend *backend, u64 width, u64 height)
+{
+  RenderScaler *scaler = &backend->scaler;
+  RenderSprites *sprites = &backend->sprites;
+  f32 frameWidth = (f32)scaler->frameWidth;
+  f32 frameHeight = (f32)scaler->frameHeight;
+  RenderSpriteInstance instance = {frameWidth * 0.5f, frameHeight * 0.5f, frameWidth, frameHeight, 0.f,
+                                   0, (u16)(height * 65535 / scaler->height), (u16)(width * 65535 / scaler->width), 0, 0xFFFFFFFF};
+  sg_bindings bindings = {0};
+  bindings.vertex_buffers[0] = sprites->instanceBuffer;
+  bindings.vertex_buffer_offsets[0] = sg_append_buffer(sprites->instanceBuffer, &SG_RANGE(instance));
+  bindings.fs.images[0] = scaler->color;
+  bindings.fs.samplers[0] = scaler->sampler;
+  sg_apply_pipeline(sprites->pipelines[RenderBlend_None]);
+  sg_apply_bindings(&bindings);
+  sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(backend->screenProjection));
+  sg_draw(0, 6, 1);
+}
+
+// Execution
+
+// Sorted keys [begin, end) into whatever pass is open
+function void
+RenderExecuteRange(RenderBackend *backend, RenderCommands *commands, u64 *keys, u64 begin, u64 end)
+{
+  RenderStats *stats = &backend->stats;
+  RenderColor color = 0;
+  RenderSokolSetColor(color);
+
+  u64 state = ~0ull;
+  for (u64 keyIdx = begin; keyIdx < end; ++keyIdx) {
+    u64 key = keys[keyIdx];
+    RenderCommand *command = &commands->commands[key & RENDER_KEY_INDEX_MASK];
+    if ((key & RENDER_KEY_STATE_MASK) != state || (command->color != color && command->kind != RenderCommand_Sprite)) {
+      RenderBatchFlush(backend);
+    }
+
+    if ((key & RENDER_KEY_STATE_MASK) != state) {
+      RenderSpritesFlush(backend);
+
+      // sokol_gp picks the pipeline from the primitive, only the blend mode is ours to set
+      if (RenderKeyField(key, BLEND) != RenderKeyField(state, BLEND)) {
+        sgp_set_blend_mode((sgp_blend_mode)RenderKeyField(key, BLEND));
+      }
+      state = key & RENDER_KEY_STATE_MASK;
+      stats->stateChanges++;
+    }
+
+    // Sprites carry their color per instance
+    if (command->kind == RenderCommand_Sprite) {
+      RenderSpritesPush(&backend->sprites, command, key);
+    } else if (command->kind == RenderCommand_Tilemap) {
+      RenderTilemapExecute(backend, command, key);
+    } else {
+      if (command->color != color) {
+        color = command->color;
+        RenderSokolSetColor(color);
+      }
+      RenderBatchPush(backend, command);
+    }
+  }
+  RenderBatchFlush(backend);
+  RenderSpritesFlush(backend);
+}
+
+function u64
+RenderSkipLayersBelow(u64 *keys, u64 keyIdx, u64 count, u32 layer)
+{
+  while (keyIdx < count && RenderKeyField(keys[keyIdx], LAYER) < layer) {
+    ++keyIdx;
+  }
+
+  return keyIdx;
+}
+
+// Backend
+
+function b32
+RenderBackendInit(RenderBackend *backend, Arena *arena, u64 maxCommands)
+{
+  MemoryZeroStruct(backend);
+  OSJobPoolStart(&backend->sortPool, Min(OSProcessorCount() - 1, RENDER_MAX_SORT_WORKERS));
+  RenderSorterInit(&backend->sorter, arena, maxCommands, &backend->sortPool);
+
+  sg_desc sgDesc = {0};
+  sgDesc.logger.func = slog_func;
+  sgDesc.buffer_pool_size = RENDER_MAX_CACHED_CHUNKS + 64; // A zoomed out camera can see every cached chunk
+  // A pass with a color and a depth image per layer target and for the scaler, one pass to spare
+  sgDesc.image_pool_size = RENDER_MAX_TEXTURES + 2 * RENDER_MAX_LAYER_TARGETS + 2;
+  sgDesc.pass_pool_size = RENDER_MAX_LAYER_TARGETS + 2;
+  sg_setup(&sgDesc);
+
+  backend->isValid = sg_isvalid() &&
+                     RenderStreamSetup(&backend->stream, RENDER_STREAM_MIN_VERTICES, RENDER_STREAM_MIN_VERTICES / 4) &&
+                     RenderSpritesSetup(&backend->sprites, arena, maxCommands) &&
+                     RenderLayerCacheSetup(&backend->layerCache, &backend->sprites);
+  backend->chunkCache.scratch = ArenaPushN(arena, RenderSpriteInstance, RENDER_TILEMAP_CHUNK_SIZE * RENDER_TILEMAP_CHUNK_SIZE);
+
+  RenderScaler *scaler = &backend->scaler;
+  scaler->minScale = RENDER_SCALE_MIN;
+  scaler->maxScale = RENDER_SCALE_MAX;
+  scaler->scale = RENDER_SCALE_MAX;
+
+  if (backend->isValid) {
+    sg_sampler_desc samplerDesc = {0};
+    samplerDesc.min_filter = SG_FILTER_LINEAR;
+    samplerDesc.mag_filter = SG_FILTER_LINEAR;
+    samplerDesc.wrap_u = SG_WRAP_CLAMP_TO_EDGE;
+    samplerDesc.wrap_v = SG_WRAP_CLAMP_TO_EDGE;
+    scaler->sampler = sg_make_sampler(&samplerDesc);
+
+    // Texture 0, so untextured sprites and bad handles draw in their plain color
+    u32 white = 0xFFFFFFFF;
+    RenderBackendTextureCreate(backend, 1, 1, &white);
+  }
+
+  return backend->isValid;
+}
+
+function void
+RenderBackendShutdown(RenderBackend *backend)
+{
+  if (backend->isValid) {
+    sgp_shutdown();
+    sg_shutdown();
+    backend->isValid = false;
+  }
+  OSJobPoolStop(&backend->sortPool);
+}
+
+function void
+RenderBackendExecute(RenderBackend *backend, RenderCommands *commands)
+{
+  if (backend->isValid) {
+    int width = (int)commands->frameWidth;
+    int height = (int)commands->frameHeight;
+    u64 *keys = RenderSortKeys(&backend->sorter, commands->keys, commands->count);
+    RenderStats *stats = &backend->stats;
+    MemoryZeroStruct(stats);
+    stats->commandCount = commands->count;
+    stats->droppedCommands = commands->dropped;
+    stats->culledCommands = commands->culled;
+    stats->sortNs = backend->sorter.sortNs;
+    stats->sortPasses = backend->sorter.passCount;
+
+    RenderStream *stream = &backend->stream;
+    RenderStreamResize(stream);
+    stream->frameVertices = 0;
+    stream->frameCommands = 0;
+    sgp_usage startUsage = sgp_query_usage();
+
+    // The camera's view, y up. Same projection as sokol_gp's
+    f32 viewWidth = commands->viewX1 - commands->viewX0;
+    f32 viewHeight = commands->viewY1 - commands->viewY0;
+    RenderSprites *sprites = &backend->sprites;
+    sprites->projection[0] = 2.f / viewWidth;
+    sprites->projection[1] = 2.f / viewHeight;
+    sprites->projection[2] = -1.f - commands->viewX0 * sprites->projection[0];
+    sprites->projection[3] = -1.f - commands->viewY0 * sprites->projection[1];
+    backend->screenProjection[0] = 2.f / (f32)width;
+    backend->screenProjection[1] = 2.f / (f32)height;
+    backend->screenProjection[2] = -1.f;
+    backend->screenProjection[3] = -1.f;
+    backend->viewX0 = commands->viewX0;
+    backend->viewY0 = commands->viewY0;
+    backend->viewX1 = commands->viewX1;
+    backend->viewY1 = commands->viewY1;
+    backend->chunkCache.frameIndex++;
+
+    // Cached layers the game redrew go into their targets first, sokol_gfx can't nest passes.
+    // Keys are sorted by layer, so each layer's commands are one range
+    RenderLayerCache *layerCache = &backend->layerCache;
+    RenderLayerCacheResize(layerCache, commands->frameWidth, commands->frameHeight);
+    layerCache->frameIndex++;
+    for (u32 targetIdx = 0; targetIdx < RENDER_MAX_LAYER_TARGETS; ++targetIdx) {
+      // Keep what this frame composites from being evicted for a layer that's redrawn before it
+      RenderLayerTarget *target = &layerCache->targets[targetIdx];
+      if (target->isUsed && (commands->cachedLayers[target->layer >> 6] & (1ull << (target->layer & 63)))) {
+        target->lastUsedFrame = layerCache->frameIndex;
+      }
+    }
+    RenderLayerTarget *composites[RENDER_MAX_LAYER_TARGETS];
+    u32 compositeCount = 0;
+    u64 keyIdx = 0;
+    for (u32 layer = 0; layer < 256; ++layer) {
+      u64 bit = 1ull << (layer & 63);
+      if (commands->cachedLayers[layer >> 6] & bit) {
+        u64 begin = RenderSkipLayersBelow(keys, keyIdx, commands->count, layer);
+        keyIdx = RenderSkipLayersBelow(keys, begin, commands->count, layer + 1);
+
+        RenderLayerTarget *target = 0;
+        b32 isRedrawn = (commands->redrawnLayers[layer >> 6] & bit) != 0;
+        if (isRedrawn && !RenderRangeIsAlphaBlended(keys, begin, keyIdx)) {
+          // Drawn in place with the uncached layers, and without a copy the game keeps sending it
+          RenderLayerTarget *stale = RenderLayerCacheFind(layerCache, (u8)layer);
+          if (stale) {
+            RenderLayerTargetRelease(layerCache, stale);
+          }
+        } else if (isRedrawn) {
+          target = RenderLayerCacheAcquire(layerCache, (u8)layer, stats);
+          if (target) {
+            sg_pass_action pass = {0};
+            pass.colors[0].load_action = SG_LOADACTION_CLEAR;
+            sg_begin_pass(target->pass, &pass);
+            sgp_begin(width, height);
+            sgp_viewport(0, 0, width, height);
+            sgp_project(commands->viewX0, commands->viewX1, commands->viewY1, commands->viewY0);
+            RenderExecuteRange(backend, commands, keys, begin, keyIdx);
+            RenderStreamFlush(stream, stats);
+            sgp_end();
+            sg_end_pass();
+            stats->layersRedrawn++;
+          }
+        } else {
+          target = RenderLayerCacheFind(layerCache, (u8)layer);
+        }
+
+        if (target) {
+          target->lastUsedFrame = layerCache->frameIndex;
+          composites[compositeCount++] = target;
+        }
+      }
+    }
+
+    MemoryZeroArray(commands->validLayers);
+    for (u32 targetIdx = 0; targetIdx < RENDER_MAX_LAYER_TARGETS; ++targetIdx) {
+      RenderLayerTarget *target = &layerCache->targets[targetIdx];
+      if (target->isUsed) {
+        commands->validLayers[target->layer >> 6] |= 1ull << (target->layer & 63);
+      }
+    }
+    stats->layerCacheBytes = layerCache->usedBytes;
+
+    // The pass is open the whole time, so a full queue can be flushed mid frame
+    RenderScaler *scaler = &backend->scaler;
+    b32 isScaled = RenderScalerPrepare(scaler, commands->frameWidth, commands->frameHeight);
+    int renderWidth = width;
+    int renderHeight = height;
+    sg_pass_action pass = {0};
+    if (isScaled) {
+      renderWidth = Clamp((int)((f32)width * scaler->scale + 0.5f), 1, (int)scaler->width);
+      renderHeight = Clamp((int)((f32)height * scaler->scale + 0.5f), 1, (int)scaler->height);
+      sg_begin_pass(scaler->pass, &pass);
+      sg_apply_viewport(0, 0, renderWidth, renderHeight, true);
+    } else {
+      sg_begin_default_pass(&pass, width, height);
+    }
+    stats->scale = isScaled ? scaler->scale : 1.f;
+    stats->renderWidth = (u64)renderWidth;
+    stats->renderHeight = (u64)renderHeight;
+
+    // The view stays the same whatever the scale
+    sgp_begin(renderWidth, renderHeight);
+    sgp_viewport(0, 0, renderWidth, renderHeight);
+    sgp_project(commands->viewX0, commands->viewX1, commands->viewY1, commands->viewY0);
+
+    RenderSokolSetColor(commands->clearColor);
+    sgp_clear();
+
+    // Everything in between composites as usual, a composited layer's own commands are skipped
+    keyIdx = 0;
+    for (u32 compositeIdx = 0; compositeIdx < compositeCount; ++compositeIdx) {
+      u32 layer = composites[compositeIdx]->layer;
+      u64 begin = RenderSkipLayersBelow(keys, keyIdx, commands->count, layer);
+      RenderExecuteRange(backend, commands, keys, keyIdx, begin);
+      RenderLayerComposite(backend, composites[compositeIdx]);
+      keyIdx = RenderSkipLayersBelow(keys, begin, commands->count, layer + 1);
+    }
+    RenderExecuteRange(backend, commands, keys, keyIdx, commands->count);
+
+    // Present
+    RenderStreamFlush(stream, stats);
+    sgp_usage endUsage = sgp_query_usage();
+    stats->vertexBuffers = endUsage.vertex_buffers;
+    stats->mergedDraws = endUsage.merged_draws - startUsage.merged_draws;
+    stats->gpuDraws = endUsage.issued_draws - startUsage.issued_draws;
+    sgp_end();
+    sg_end_pass();
+    if (isScaled) {
+      sg_begin_default_pass(&pass, width, height);
+      RenderScalerBlit(backend, (u64)renderWidth, (u64)renderHeight);
+      sg_end_pass();
+    }
+    sg_commit();
+
+    stream->peakVertices = Max(stream->peakVertices, stream->frameVertices);
+    stream->peakCommands = Max(stream->peakCommands, stream->frameCommands);
+    stats->vertices = stream->frameVertices;
+    stats->vertexCapacity = stream->maxVertices;
+    stats->peakVertices = stream->peakVertices;
+  }
+}
+
+function RenderTexture
+RenderBackendTextureCreate(RenderBackend *backend, u32 width, u32 height, void *pixels)
+{
+  RenderTexture result = 0;
+  RenderSprites *sprites = &backend->sprites;
+  if (backend->isValid && sprites->textureCount < RENDER_MAX_TEXTURES) {
+    sg_image_desc imageDesc = {0};
+    imageDesc.width = (int)width;
+    imageDesc.height = (int)height;
+    imageDesc.pixel_format = SG_PIXELFORMAT_RGBA8;
+    imageDesc.data.subimage[0][0].ptr = pixels;
+    imageDesc.data.subimage[0][0].size = (u64)width * height * 4;
+    sg_image image = sg_make_image(&imageDesc);
+    if (sg_query_image_state(image) == SG_RESOURCESTATE_VALID) {
+      result = sprites->textureCount++;
+      sprites->textures[result] = image;
+    } else {
+      sg_destroy_image(image);
+    }
+  }
+
+  return result;
+}
+
+function void
+RenderBackendUpdateScale(RenderBackend *backend, u64 frameNs, u64 budgetNs)
+{
+  RenderScaler *scaler = &backend->scaler;
+  scaler->smoothedNs = scaler->smoothedNs ? scaler->smoothedNs - scaler->smoothedNs / 8 + frameNs / 8 : frameNs;
+
+  // Down as soon as the cost gets close to the budget, up only after a stretch well under it
+  if (scaler->settleFrames) {
+    scaler->settleFrames--;
+  } else if (scaler->smoothedNs > budgetNs - budgetNs / 16) {
+    scaler->underFrames = 0;
+    if (scaler->scale > scaler->minScale) {
+      scaler->scale = Max(scaler->scale - RENDER_SCALE_STEP, scaler->minScale);
+      scaler->settleFrames = RENDER_SCALE_SETTLE;
+    }
+  } else if (scaler->smoothedNs < budgetNs - budgetNs / 4) {
+    if (++scaler->underFrames >= RENDER_SCALE_HOLD && scaler->scale < scaler->maxScale) {
+      scaler->scale = Min(scaler->scale + RENDER_SCALE_STEP, scaler->maxScale);
+      scaler->settleFrames = RENDER_SCALE_SETTLE;
+      scaler->underFrames = 0;
+    }
+  } else {
+    scaler->underFrames = 0;
+  }
+}
+
+function void
+RenderBackendSetScaleBounds(RenderBackend *backend, f32 minScale, f32 maxScale)
+{
+  RenderScaler *scaler = &backend->scaler;
+  scaler->maxScale = Clamp(maxScale, RENDER_SCALE_STEP, 1.f);
+  scaler->minScale = Clamp(minScale, RENDER_SCALE_STEP, scaler->maxScale);
+  scaler->scale = Clamp(scaler->scale, scaler->minScale, scaler->maxScale);
+
+  // The target is sized for the largest scale
+  if (backend->isValid) {
+    RenderScalerRelease(scaler);
+  }
+}
@@ -0,0 +1,230 @@
+#ifndef RENDER_SOKOL_H
+#define RENDER_SOKOL_H
+
+/*
+  Platform side of the renderer, executes RenderCommands through sokol_gfx/sokol_gp.
+  Needs a current GL context, the GPU state lives here for the whole run.
+
+  sokol_gp's draw queue (vertices, uniforms, commands) is sized to what frames actually
+  use: a frame that fills it gets flushed in parts instead of dropping draws, and between
+  frames the queue grows to the peak it saw, or shrinks once a window of frames stayed
+  well under it. sokol_gfx already rotates stream buffers over the frames in flight.
+
+  Runs of sorted commands with the same state, kind and color go to sokol_gp as one batch
+  call, so its (SIMD) vertex generation works on whole runs instead of single shapes.
+  sokol_gp then merges whatever shares state and doesn't overlap into as few draws as it can.
+
+  Sprites skip sokol_gp. Each one is a 32 byte instance in a stream buffer and the vertex
+  shader expands it into its two triangles, so the CPU writes and uploads one instance where
+  sokol_gp would transform six vertices. A run of sprites flushes what sokol_gp queued before
+  it, so the sorted order holds across the two.
+
+  Tilemap chunks are sprite instances too, built once into an immutable buffer and cached
+  until the game dirties the chunk or the cache needs the slot for something more recent.
+  Chunks outside the view are skipped without looking at their tiles.
+
+  Cached layers are drawn into their own frame sized target in a pass before the frame's,
+  only in frames the game redraws them, and composited as one quad in their place. Targets
+  are kept within a memory budget, the least recently used one makes room for a new one.
+  When there's no room the layer is drawn like any other and stays invalid.
+
+  The camera is just the projection, commands were already culled against its view when
+  the game pushed them.
+
+  Frames render at a scale of the frame size that follows the measured frame cost: over
+  budget it steps down right away, well under budget for a while it steps back up. Below
+  full scale the frame goes into an offscreen target sized for the largest scale, using
+  its bottom left part, and gets stretched onto the backbuffer. The view doesn't change.
+*/
+
+#include <sokol/sokol_gfx.h>
+#include <sokol/sokol_gp.h>
+
+#define RENDER_MAX_SORT_WORKERS    3
+#define RENDER_STREAM_MIN_VERTICES Kilobytes(4)
+#define RENDER_STREAM_MAX_VERTICES Megabytes(1)
+#define RENDER_STREAM_WINDOW       256 // Frames the peak is kept for before the queue may shrink
+#define RENDER_BATCH_MAX           256 // Commands per sokol_gp draw call
+#define RENDER_BATCH_MAX_VERTICES  (RENDER_BATCH_MAX * 6)
+#define RENDER_MAX_CACHED_CHUNKS   1024 // Tilemap chunk buffers kept on the GPU
+#define RENDER_MAX_LAYER_TARGETS   16
+#define RENDER_LAYER_CACHE_BUDGET  Megabytes(64) // Color and depth of every cached layer
+#define RENDER_SCALE_MIN           0.5f
+#define RENDER_SCALE_MAX           1.f
+#define RENDER_SCALE_STEP          0.05f
+#define RENDER_SCALE_SETTLE        8  // Frames after a change before the next, the cost has to catch up
+#define RENDER_SCALE_HOLD          60 // Frames well under budget before stepping up
+
+typedef struct RenderSpriteInstance RenderSpriteInstance;
+struct RenderSpriteInstance
+{
+  f32 x, y, w, h;
+  f32 rotation;
+  u16 u0, v0, u1, v1;
+  RenderColor color;
+};
+StaticAssert(sizeof(RenderSpriteInstance) == 32, check_sprite_instance_size);
+
+typedef struct RenderStats RenderStats;
+struct RenderStats
+{
+  u64 commandCount;
+  u64 droppedCommands;
+  u64 culledCommands; // Outside the camera's view, never pushed
+  u64 sortNs;
+  u32 sortPasses;
+  u64 stateChanges; // Blend mode and pipeline switches
+  u64 batches;      // sokol_gp draw calls
+  u64 mergedDraws;  // Folded into another draw by sokol_gp's batch optimizers
+  u64 gpuDraws;     // sg_draw calls that were left
+  u64 sprites;
+  u64 spriteDraws;  // Instanced sg_draw calls, one per run of sprites with the same state
+  u64 chunksDrawn;
+  u64 chunksBuilt;  // Dirty or not cached
+  u64 layersComposited;
+  u64 layersRedrawn;
+  u64 layerEvictions;
+  u64 layerCacheBytes;
+  f32 scale;
+  u64 renderWidth, renderHeight;
+
+  u64 flushes;        // One per frame, plus one per full queue and per sprite run after sokol_gp draws
+  u64 vertices;       // Queued over all flushes
+  u64 vertexCapacity; // Queue size this frame
+  u64 peakVertices;   // Most vertices a frame queued in the current window
+  u64 vertexBuffers;  // Stream buffers sokol_gp appended to
+};
+
+typedef struct RenderStream RenderStream;
+struct RenderStream
+{
+  u32 maxVertices;
+  u32 maxCommands;
+
+  // Current window
+  u64 windowFrames;
+  u32 peakVertices;
+  u32 peakCommands;
+
+  // Current frame, flushed parts included
+  u32 frameVertices;
+  u32 frameCommands;
+};
+
+typedef struct RenderBatch RenderBatch;
+struct RenderBatch
+{
+  RenderCommandKind kind;
+  u32 count;
+  union
+  {
+    sgp_rect rects[RENDER_BATCH_MAX];
+    sgp_line lines[RENDER_BATCH_MAX];
+    sgp_triangle triangles[RENDER_BATCH_MAX];
+  };
+};
+
+typedef struct RenderSprites RenderSprites;
+struct RenderSprites
+{
+  sg_shader shader;
+  sg_pipeline pipelines[RenderBlend_Count];
+  sg_buffer instanceBuffer; // Stream, room for every command of a frame
+  sg_sampler sampler;
+  sg_image textures[RENDER_MAX_TEXTURES]; // Indexed by RenderTexture
+  u32 textureCount;
+  f32 projection[4]; // Scale and offset from the camera's view to clip space
+
+  // Current run
+  RenderSpriteInstance *instances;
+  u32 count;
+  RenderTexture texture;
+  RenderBlend blend;
+};
+
+typedef struct RenderChunkSlot RenderChunkSlot;
+struct RenderChunkSlot
+{
+  RenderTilemap *tilemap; // 0 when free
+  u32 chunkIdx;
+  u32 tileCount;
+  u64 lastUsedFrame;
+  sg_buffer buffer; // Immutable sprite instances, none for an empty chunk
+};
+
+typedef struct RenderChunkCache RenderChunkCache;
+struct RenderChunkCache
+{
+  RenderChunkSlot slots[RENDER_MAX_CACHED_CHUNKS];
+  RenderSpriteInstance *scratch; // One chunk's instances while building it
+  u64 frameIndex;
+};
+
+typedef struct RenderLayerTarget RenderLayerTarget;
+struct RenderLayerTarget
+{
+  b32 isUsed;
+  u8 layer;
+  u64 lastUsedFrame;
+  sg_image color;
+  sg_image depth; // sokol_gp's pipelines expect a depth stencil attachment
+  sg_pass pass;
+};
+
+typedef struct RenderLayerCache RenderLayerCache;
+struct RenderLayerCache
+{
+  RenderLayerTarget targets[RENDER_MAX_LAYER_TARGETS];
+  u64 width, height; // Of every target, the frame's
+  u64 usedBytes;
+  u64 frameIndex;
+  sg_pipeline compositePipeline; // Premultiplied alpha, targets start out transparent
+};
+
+typedef struct RenderScaler RenderScaler;
+struct RenderScaler
+{
+  f32 minScale, maxScale;
+  f32 scale;
+  u64 smoothedNs; // Frame cost, exponential moving average
+  u32 settleFrames;
+  u32 underFrames;
+
+  // Offscreen target for the largest scale below 1, remade when the frame size changes
+  u64 frameWidth, frameHeight;
+  u64 width, height;
+  sg_image color;
+  sg_image depth;
+  sg_pass pass;
+  sg_sampler sampler; // Linear, for the stretch
+};
+
+typedef struct RenderBackend RenderBackend;
+struct RenderBackend
+{
+  b32 isValid;
+  OSJobPool sortPool;
+  RenderSorter sorter;
+  RenderStream stream;
+  RenderBatch batch;
+  RenderSprites sprites;
+  RenderChunkCache chunkCache;
+  RenderLayerCache layerCache;
+  RenderScaler scaler;
+  f32 viewX0, viewY0, viewX1, viewY1; // The camera's view this frame, tilemap chunks outside it get culled
+  f32 screenProjection[4]; // Frame pixels to clip space, for composites and the stretch
+  RenderStats stats; // Last frame
+};
+
+function b32  RenderBackendInit(RenderBackend *backend, Arena *arena, u64 maxCommands);
+function void RenderBackendShutdown(RenderBackend *backend);
+function void RenderBackendExecute(RenderBackend *backend, RenderCommands *commands);
+
+// Feed it every frame's cost (OSFramePacer.workNs) and budget. Bounds within (0, 1]
+function void RenderBackendUpdateScale(RenderBackend *backend, u64 frameNs, u64 budgetNs);
+function void RenderBackendSetScaleBounds(RenderBackend *backend, f32 minScale, f32 maxScale);
+
+// RGBA8 pixels, top row first. 0 when out of textures or the image couldn't be made
+function RenderTexture RenderBackendTextureCreate(RenderBackend *backend, u32 width, u32 height, void *pixels);
+
+#endif // RENDER_SOKOL_H
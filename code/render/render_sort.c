@@ -0,0 +1,113 @@
+function void
+RenderSorterInit(RenderSorter *sorter, Arena *arena, u64 capacity, OSJobPool *pool)
+{
+  Assert(capacity <= (1ull << RENDER_KEY_INDEX_BITS));
+  MemoryZeroStruct(sorter);
+  sorter->pool = pool;
+  sorter->scratch = ArenaPush(arena, capacity * sizeof(u64), CACHE_LINE_SIZE);
+  sorter->capacity = capacity;
+  sorter->offsets = ArenaPush(arena, RENDER_SORT_MAX_JOBS * sizeof(*sorter->offsets), CACHE_LINE_SIZE);
+}
+
+#define RenderSortDigit(key, shift) (u32)(((key) >> (shift)) & (RENDER_SORT_BUCKETS - 1))
+
+function void
+RenderSortCountJob(void *param, u32 jobIdx, u32 jobCount)
+{
+  RenderSorter *sorter = (RenderSorter*)param;
+  u64 first = sorter->count * jobIdx / jobCount;
+  u64 last = sorter->count * (jobIdx + 1) / jobCount;
+  u32 *counts = sorter->offsets[jobIdx];
+  MemoryZero(counts, sizeof(*sorter->offsets));
+
+  u64 *src = sorter->src;
+  u32 shift = sorter->shift;
+  for (u64 i = first; i < last; ++i) {
+    counts[RenderSortDigit(src[i], shift)]++;
+  }
+}
+
+function void
+RenderSortScatterJob(void *param, u32 jobIdx, u32 jobCount)
+{
+  RenderSorter *sorter = (RenderSorter*)param;
+  u64 first = sorter->count * jobIdx / jobCount;
+  u64 last = sorter->count * (jobIdx + 1) / jobCount;
+  u32 *offsets = sorter->offsets[jobIdx];
+
+  u64 *src = sorter->src;
+  u64 *dst = sorter->dst;
+  u32 shift = sorter->shift;
+  for (u64 i = first; i < last; ++i) {
+    u64 key = src[i];
+    dst[offsets[RenderSortDigit(key, shift)]++] = key;
+  }
+}
+
+function u64*
+RenderSortKeys(RenderSorter *sorter, u64 *keys, u64 count)
+{
+  u64 startNs = OSNowNs();
+  Assert(count <= sorter->capacity);
+  sorter->passCount = 0;
+
+  // Digits where no key differs from the others don't need a pass, finding them is cheaper
+  // than counting them. Sorted input only needs the one read
+  b32 isSorted = true;
+  u64 allAnd = ~0ull;
+  u64 allOr = 0;
+  for (u64 i = 0; i < count; ++i) {
+    isSorted &= i == 0 || keys[i - 1] <= keys[i];
+    allAnd &= keys[i];
+    allOr |= keys[i];
+  }
+  u64 varyingBits = allAnd ^ allOr;
+
+  u64 *result = keys;
+  if (!isSorted) {
+    b32 isParallel = sorter->pool && count >= RENDER_SORT_PARALLEL_MIN;
+    u32 jobCount = isParallel ? OSJobPoolJobCount(sorter->pool) : 1;
+    sorter->src = keys;
+    sorter->dst = sorter->scratch;
+    sorter->count = count;
+
+    for (u32 shift = RENDER_KEY_INDEX_BITS; shift < 64; shift += RENDER_SORT_RADIX_BITS) {
+      if (RenderSortDigit(varyingBits, shift) == 0) {
+        continue;
+      }
+
+      sorter->shift = shift;
+      if (isParallel) {
+        OSJobPoolRun(sorter->pool, RenderSortCountJob, sorter);
+      } else {
+        RenderSortCountJob(sorter, 0, 1);
+      }
+
+      // Bucket major, job minor, so every job's slice lands after the slices before it
+      u32 offset = 0;
+      for (u32 bucket = 0; bucket < RENDER_SORT_BUCKETS; ++bucket) {
+        for (u32 jobIdx = 0; jobIdx < jobCount; ++jobIdx) {
+          u32 bucketCount = sorter->offsets[jobIdx][bucket];
+          sorter->offsets[jobIdx][bucket] = offset;
+          offset += bucketCount;
+        }
+      }
+
+      if (isParallel) {
+        OSJobPoolRun(sorter->pool, RenderSortScatterJob, sorter);
+      } else {
+        RenderSortScatterJob(sorter, 0, 1);
+      }
+
+      u64 *swap = sorter->src;
+      sorter->src = sorter->dst;
+      sorter->dst = swap;
+      sorter->passCount++;
+    }
+
+    result = sorter->src;
+  }
+
+  sorter->sortNs = OSNowNs() - startNs;
+  return result;
+}
@@ -0,0 +1,40 @@
+#ifndef RENDER_SORT_H
+#define RENDER_SORT_H
+
+/*
+  LSD radix sort for render keys. Keys arrive in submission order and the command index
+  in their low bits already is that order, so only the bits above it get sorted: up to
+  four stable 11 bit passes, skipping digits all keys share (found by and/or-ing the keys).
+  Already sorted input (one layer, one state) returns after that single read. Large counts
+  split every pass over a job pool: each job counts its slice, the per job offsets are laid
+  out slice by slice and each job scatters its own slice, which keeps the sort stable.
+*/
+
+#define RENDER_SORT_RADIX_BITS   11
+#define RENDER_SORT_BUCKETS      (1 << RENDER_SORT_RADIX_BITS)
+#define RENDER_SORT_MAX_JOBS     (OS_JOB_MAX_WORKERS + 1)
+#define RENDER_SORT_PARALLEL_MIN 16384 // Below this, waking the workers costs more than it saves
+
+typedef struct RenderSorter RenderSorter;
+struct RenderSorter
+{
+  OSJobPool *pool; // 0 sorts on the calling thread only
+  u64 *scratch;
+  u64 capacity;
+  u32 (*offsets)[RENDER_SORT_BUCKETS]; // Per job
+
+  // Current pass
+  u64 *src, *dst;
+  u64 count;
+  u32 shift;
+
+  // Last sort
+  u64 sortNs;
+  u32 passCount;
+};
+
+function void RenderSorterInit(RenderSorter *sorter, Arena *arena, u64 capacity, OSJobPool *pool);
+// Keys must be in submission order, returns either keys or the sorter's scratch
+function u64* RenderSortKeys(RenderSorter *sorter, u64 *keys, u64 count);
+
+#endif // RENDER_SORT_H
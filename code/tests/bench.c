@@ -0,0 +1,320 @@
+/*
+  Page size benchmark for -largepages: an entity-heavy update over arena memory, once on
+  regular pages and once on OSMemAllocLarge's. The game has no entities of its own yet, so
+  the update is a stand-in for one: every entity steers towards a random other entity, which
+  is the scattered access that misses the TLB on 4KB pages.
+
+  String benchmark: Str8Find, Str8Match and Str8Split against the byte at a time versions
+  they replaced, on a WGL extension string repeated to a few megabytes.
+
+  bench [entity count in millions, default 16] [updates, default 8]
+  bench strings [size in MB, default 4] [runs, default 16]
+  Build optimized, see build.bat.
+*/
+
+// Headers
+#define _GNU_SOURCE // Before any system header, see platform_sdl.c
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "base/base_include.h"
+#include "os/os.h"
+
+// Source
+#define STB_SPRINTF_IMPLEMENTATION
+#include <stb/stb_sprintf.h>
+#include "base/base_include.c"
+#include "os/os_include.c"
+
+typedef struct BenchEntity BenchEntity;
+struct BenchEntity
+{
+  f32 x, y;
+  f32 vx, vy;
+  u32 target;
+  u32 health;
+  u64 flags;
+  u8 padding[32]; // One cache line each, like an entity with a few more components
+};
+StaticAssert(sizeof(BenchEntity) == 64, bench_entity_is_a_cache_line);
+
+typedef struct BenchResult BenchResult;
+struct BenchResult
+{
+  u64 pageSize;
+  f64 minMs;
+  f64 meanMs;
+};
+
+function void
+BenchUpdate(BenchEntity *entities, u64 count, f32 dt)
+{
+  for (u64 entityIdx = 0; entityIdx < count; ++entityIdx) {
+    BenchEntity *entity = &entities[entityIdx];
+    BenchEntity *target = &entities[entity->target];
+    entity->vx += (target->x - entity->x) * dt;
+    entity->vy += (target->y - entity->y) * dt;
+    entity->x += entity->vx * dt;
+    entity->y += entity->vy * dt;
+    entity->health -= (target->flags & 1);
+  }
+}
+
+function BenchResult
+BenchRun(u64 count, u64 updates, b32 useLargePages)
+{
+  BenchResult result = {0};
+  u64 size = count * sizeof(BenchEntity) + Megabytes(1);
+  void *memory = 0;
+  if (useLargePages) {
+    memory = OSMemAllocLarge(size, &result.pageSize);
+  } else {
+    memory = OSMemReserve(size);
+    OSMemCommit(memory, size);
+    result.pageSize = Kilobytes(4);
+  }
+
+  if (memory) {
+    Arena *arena = ArenaAlloc(memory, size);
+    BenchEntity *entities = ArenaPushN(arena, BenchEntity, count);
+
+    // Same entities for both runs, and every page is touched before the clock starts
+    u64 rng = 0x5eed;
+    for (u64 entityIdx = 0; entityIdx < count; ++entityIdx) {
+      rng ^= rng << 13;
+      rng ^= rng >> 7;
+      rng ^= rng << 17;
+      entities[entityIdx].x = (f32)(rng & 0xFFFF);
+      entities[entityIdx].y = (f32)((rng >> 16) & 0xFFFF);
+      entities[entityIdx].target = (u32)((rng >> 32) % count);
+      entities[entityIdx].health = 100;
+      entities[entityIdx].flags = rng >> 63;
+    }
+
+    result.minMs = 1e30;
+    for (u64 updateIdx = 0; updateIdx < updates; ++updateIdx) {
+      u64 startNs = OSNowNs();
+      BenchUpdate(entities, count, 1.0f / 60.0f);
+      f64 ms = (f64)(OSNowNs() - startNs) / OS_NS_PER_MS;
+      result.minMs = Min(result.minMs, ms);
+      result.meanMs += ms / updates;
+    }
+
+    if (useLargePages) {
+      OSMemReleaseLarge(memory, size);
+    } else {
+      OSMemRelease(memory, size);
+    }
+  }
+
+  return result;
+}
+
+// The String8 versions before they were vectorized, Find didn't exist and was a Match per position
+
+function b32
+BenchStr8MatchBytes(String8 a, String8 b, StringMatchFlags matchFlags)
+{
+  b32 result = 0;
+  if (a.size == b.size) {
+    result = 1;
+    b32 noCase = ((matchFlags & StringMatch_CaseInsensitive) != 0);
+    for (u64 i = 0; i < a.size; ++i) {
+      u8 ac = a.str[i];
+      u8 bc = b.str[i];
+      if (noCase) {
+        ac = CharToLower(ac);
+        bc = CharToLower(bc);
+      }
+      if (ac != bc) {
+        result = 0;
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+function u64
+BenchStr8FindBytes(String8 string, String8 needle, StringMatchFlags matchFlags)
+{
+  u64 result = string.size;
+  for (u64 pos = 0; pos + needle.size <= string.size; ++pos) {
+    if (BenchStr8MatchBytes(Str8(string.str + pos, needle.size), needle, matchFlags)) {
+      result = pos;
+      break;
+    }
+  }
+
+  return result;
+}
+
+function String8List
+BenchStr8SplitBytes(Arena *arena, String8 string, u64 numSplits, u8 *splits)
+{
+  String8List result = {0};
+
+  u8 *ptr = string.str;
+  u8 *first = ptr;
+  u8 *opl = ptr + string.size;
+  for (;ptr < opl; ++ptr) {
+    u8 byte = *ptr;
+    b32 split = 0;
+    for (u64 i = 0; i < numSplits; ++i) {
+      if (byte == splits[i]) {
+        split = 1;
+        break;
+      }
+    }
+
+    if (split) {
+      if (first < ptr)
+        Str8ListPush(arena, &result, Str8Range(first, ptr));
+      first = ptr + 1;
+    }
+  }
+
+  if (first < ptr) {
+    Str8ListPush(arena, &result, Str8Range(first, ptr));
+  }
+
+  return result;
+}
+
+typedef enum BenchStringOp
+{
+  BenchStringOp_Find,
+  BenchStringOp_FindNoCase,
+  BenchStringOp_Match,
+  BenchStringOp_MatchNoCase,
+  BenchStringOp_Split,
+  BenchStringOp_Count,
+} BenchStringOp;
+
+read_only char *g_benchStringOpNames[BenchStringOp_Count] = {
+  "find", "find nocase", "match", "match nocase", "split",
+};
+
+// Returns something of the op's result so the old and new versions can be checked against each other
+function u64
+BenchStringOpRun(BenchStringOp op, b32 useBytes, Arena *arena, String8 string, String8 copy, String8 upper,
+                 String8 needle)
+{
+  u64 result = 0;
+  u8 splits[] = {' ', '\n'};
+  switch (op) {
+    case BenchStringOp_Find: {
+      result = useBytes ? BenchStr8FindBytes(string, needle, 0) : Str8Find(string, needle, 0, 0);
+    } break;
+    case BenchStringOp_FindNoCase: {
+      result = (useBytes ? BenchStr8FindBytes(upper, needle, StringMatch_CaseInsensitive) :
+                           Str8Find(upper, needle, 0, StringMatch_CaseInsensitive));
+    } break;
+    case BenchStringOp_Match: {
+      result = useBytes ? BenchStr8MatchBytes(string, copy, 0) : Str8Match(string, copy, 0);
+    } break;
+    case BenchStringOp_MatchNoCase: {
+      result = (useBytes ? BenchStr8MatchBytes(string, upper, StringMatch_CaseInsensitive) :
+                           Str8Match(string, upper, StringMatch_CaseInsensitive));
+    } break;
+    case BenchStringOp_Split: {
+      TempArena temp = ArenaTempBegin(arena);
+      String8List list = (useBytes ? BenchStr8SplitBytes(arena, string, ArrayCount(splits), splits) :
+                                     Str8Split(arena, string, ArrayCount(splits), splits));
+      result = list.count ^ (list.totalSize << 32);
+      ArenaTempEnd(temp);
+    } break;
+    default: break;
+  }
+
+  return result;
+}
+
+function int
+BenchStrings(u64 size, u64 runs)
+{
+  int result = 1;
+  u64 memorySize = 16 * size + Megabytes(1);
+  void *memory = OSMemReserve(memorySize);
+  if (memory && OSMemCommit(memory, memorySize)) {
+    Arena *arena = ArenaAlloc(memory, memorySize);
+
+    // A real driver's list, repeated, with the extension looked for only at the very end
+    String8 extensions = Str8Lit(
+      "WGL_ARB_buffer_region WGL_ARB_create_context WGL_ARB_create_context_no_error "
+      "WGL_ARB_create_context_profile WGL_ARB_create_context_robustness WGL_ARB_context_flush_control "
+      "WGL_ARB_extensions_string WGL_ARB_make_current_read WGL_ARB_multisample WGL_ARB_pbuffer "
+      "WGL_ARB_pixel_format WGL_ARB_pixel_format_float WGL_ARB_render_texture "
+      "WGL_ATI_pixel_format_float WGL_EXT_colorspace WGL_EXT_create_context_es_profile "
+      "WGL_EXT_create_context_es2_profile WGL_EXT_extensions_string WGL_EXT_framebuffer_sRGB "
+      "WGL_EXT_pixel_format_packed_float WGL_EXT_swap_control WGL_NVX_DX_interop "
+      "WGL_NV_DX_interop WGL_NV_DX_interop2 WGL_NV_copy_image WGL_NV_delay_before_swap "
+      "WGL_NV_float_buffer WGL_NV_multisample_coverage WGL_NV_multigpu_context "
+      "WGL_NV_render_depth_texture WGL_NV_render_texture_rectangle\n");
+    String8 needle = Str8Lit("WGL_EXT_swap_control_tear");
+    u64 repeats = Max(size / extensions.size, 1);
+    String8 string = {ArenaPushN(arena, u8, repeats * extensions.size + needle.size), 0};
+    for (u64 repeatIdx = 0; repeatIdx < repeats; ++repeatIdx) {
+      MemoryCopy(string.str + string.size, extensions.str, extensions.size);
+      string.size += extensions.size;
+    }
+    MemoryCopy(string.str + string.size, needle.str, needle.size);
+    string.size += needle.size;
+    String8 copy = {ArenaPushN(arena, u8, string.size), string.size};
+    String8 upper = {ArenaPushN(arena, u8, string.size), string.size};
+    for (u64 byteIdx = 0; byteIdx < string.size; ++byteIdx) {
+      copy.str[byteIdx] = string.str[byteIdx];
+      upper.str[byteIdx] = CharToUpper(string.str[byteIdx]);
+    }
+
+    printf("%lluKB extension string, %llu runs\n", (unsigned long long)(string.size >> 10), (unsigned long long)runs);
+    result = 0;
+    for (BenchStringOp op = 0; op < BenchStringOp_Count; ++op) {
+      f64 minMs[2] = {1e30, 1e30};
+      u64 checks[2] = {0};
+      for (u32 versionIdx = 0; versionIdx < 2; ++versionIdx) {
+        for (u64 runIdx = 0; runIdx < runs; ++runIdx) {
+          u64 startNs = OSNowNs();
+          checks[versionIdx] = BenchStringOpRun(op, versionIdx == 0, arena, string, copy, upper, needle);
+          f64 ms = (f64)(OSNowNs() - startNs) / OS_NS_PER_MS;
+          minMs[versionIdx] = Min(minMs[versionIdx], ms);
+        }
+      }
+      printf("%-12s bytes %8.3f ms, now %8.3f ms, %5.1fx%s\n", g_benchStringOpNames[op], minMs[0], minMs[1],
+             minMs[0] / Max(minMs[1], 1e-6), checks[0] == checks[1] ? "" : " MISMATCH");
+      result |= (checks[0] != checks[1]);
+    }
+    OSMemRelease(memory, memorySize);
+  }
+
+  return result;
+}
+
+int
+main(int argc, char **argv)
+{
+  OSInit();
+  int result = 1;
+  if (argc > 1 && Str8Match(Str8C(argv[1]), Str8Lit("strings"), 0)) {
+    u64 size = (argc > 2 ? strtoull(argv[2], 0, 10) : 4) * Megabytes(1);
+    u64 runs = argc > 3 ? strtoull(argv[3], 0, 10) : 16;
+    if (size && runs) {
+      result = BenchStrings(size, runs);
+    }
+  } else {
+    u64 count = (argc > 1 ? strtoull(argv[1], 0, 10) : 16) * 1000000;
+    u64 updates = argc > 2 ? strtoull(argv[2], 0, 10) : 8;
+    if (count && count <= 0xFFFFFFFFull && updates) {
+      printf("%llu entities (%lluMB), %llu updates\n", (unsigned long long)count, (unsigned long long)((count * sizeof(BenchEntity)) >> 20), (unsigned long long)updates);
+      for (u32 runIdx = 0; runIdx < 2; ++runIdx) {
+        BenchResult run = BenchRun(count, updates, runIdx == 1);
+        printf("%-12s %6lluKB pages: min %8.2f ms, mean %8.2f ms\n", runIdx ? "large pages" : "regular",
+               (unsigned long long)(run.pageSize >> 10), run.minMs, run.meanMs);
+      }
+      result = 0;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,31 @@
+#ifndef TEST_H
+#define TEST_H
+
+/*
+  Checks for the tests executable (tests/tests.c). A failed check prints where it failed and
+  the test carries on, the run exits non-zero if any check failed. Each test gets a cleared
+  scratch arena and writes its files, if any, to the working directory.
+*/
+
+typedef void TestFunc(Arena *arena);
+
+global u64 g_testChecks;
+global u64 g_testFailures;
+
+#define TestCheck(c) Stmnt( g_testChecks++; if (!(c)) { TestReportFailure(__FILE__, __LINE__, #c); } )
+
+function void TestReportFailure(char *file, int line, char *expr);
+
+// xorshift64, seeded per test so a failure reproduces
+function inline u64
+TestRandom(u64 *state)
+{
+  u64 x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+#endif // TEST_H
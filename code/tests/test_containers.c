@@ -0,0 +1,128 @@
+// ChunkArray and HashMap against plain arrays
+
+function void
+TestChunkArray(Arena *arena)
+{
+  u64 count = 10000;
+  ChunkArray *array = ChunkArrayAllocT(arena, u64, 6); // Rounds up to 8
+  u64 **pointers = ArenaPushN(arena, u64*, count);
+  for (u64 itemIdx = 0; itemIdx < count; ++itemIdx) {
+    u64 *item = ChunkArrayPushT(array, u64);
+    TestCheck(item && *item == 0);
+    *item = itemIdx * 3;
+    pointers[itemIdx] = item;
+  }
+  TestCheck(array->count == count);
+
+  // Growing never moved anything
+  b32 isStable = 1;
+  for (u64 itemIdx = 0; itemIdx < count; ++itemIdx) {
+    isStable = isStable && ChunkArrayGetT(array, u64, itemIdx) == pointers[itemIdx] && *pointers[itemIdx] == itemIdx * 3;
+  }
+  TestCheck(isStable);
+  TestCheck(ChunkArrayGet(array, count) == 0);
+
+  // Chunks visit every item once, in order
+  u64 visited = 0;
+  b32 isInOrder = 1;
+  for (u64 chunkIdx = 0; chunkIdx < array->chunkCount; ++chunkIdx) {
+    u64 itemCount;
+    u64 *items = (u64*)ChunkArrayChunk(array, chunkIdx, &itemCount);
+    for (u64 itemIdx = 0; itemIdx < itemCount; ++itemIdx) {
+      isInOrder = isInOrder && items[itemIdx] == visited * 3;
+      visited++;
+    }
+  }
+  TestCheck(isInOrder && visited == count);
+
+  // Pop and clear keep the chunks, pushing again hands out the same zeroed slots
+  ChunkArrayPop(array);
+  TestCheck(array->count == count - 1 && ChunkArrayGet(array, count - 1) == 0);
+  u64 chunkCount = array->chunkCount;
+  ChunkArrayClear(array);
+  TestCheck(array->count == 0);
+  for (u64 itemIdx = 0; itemIdx < count; ++itemIdx) {
+    u64 *item = ChunkArrayPushT(array, u64);
+    isStable = isStable && item == pointers[itemIdx] && *item == 0;
+  }
+  TestCheck(isStable && array->chunkCount == chunkCount);
+  ChunkArrayClear(array);
+  ChunkArrayPop(array);
+  TestCheck(array->count == 0);
+}
+
+function void
+TestHashMap(Arena *arena)
+{
+  // Random inserts and removes over a small key range, so keys come back after a remove and
+  // the map grows past its capacity and collects tombstones
+  u64 keyCount = 3000;
+  u64 *expected = ArenaPushN(arena, u64, keyCount); // 0 when not in the map
+  HashMap *map = HashMapAllocT(arena, u64, 64);
+  u64 rng = 0xc0ffee;
+  u64 expectedCount = 0;
+  b32 isSame = 1;
+  for (u64 opIdx = 0; opIdx < 50000; ++opIdx) {
+    // Keys spread over the whole range, 0 included
+    u64 keyIdx = TestRandom(&rng) % keyCount;
+    u64 key = keyIdx * 0x9E3779B97F4A7C15ull;
+    if (TestRandom(&rng) % 3) {
+      u64 *value = HashMapInsertT(map, u64, key);
+      isSame = isSame && value && *value == expected[keyIdx];
+      expectedCount += (expected[keyIdx] == 0);
+      *value = expected[keyIdx] = opIdx + 1;
+    } else {
+      isSame = isSame && HashMapRemove(map, key) == (expected[keyIdx] != 0);
+      expectedCount -= (expected[keyIdx] != 0);
+      expected[keyIdx] = 0;
+    }
+    isSame = isSame && map->count == expectedCount;
+  }
+  TestCheck(isSame);
+
+  for (u64 keyIdx = 0; keyIdx < keyCount; ++keyIdx) {
+    u64 *value = HashMapLookupT(map, u64, keyIdx * 0x9E3779B97F4A7C15ull);
+    isSame = isSame && (expected[keyIdx] ? (value && *value == expected[keyIdx]) : value == 0);
+  }
+  TestCheck(isSame);
+
+  // Iteration visits each live key once
+  u64 iter = 0;
+  u64 key = 0;
+  u64 visited = 0;
+  for (u64 *value = HashMapNext(map, &iter, &key); value; value = HashMapNext(map, &iter, &key)) {
+    u64 keyIdx = key * 0xF1DE83E19937733Dull; // Inverse of the multiplier mod 2^64
+    isSame = isSame && keyIdx < keyCount && expected[keyIdx] == *value;
+    visited++;
+  }
+  TestCheck(isSame && visited == expectedCount);
+
+  HashMapClear(map);
+  TestCheck(map->count == 0 && HashMapLookup(map, keyCount * 0x9E3779B97F4A7C15ull) == 0);
+  iter = 0;
+  TestCheck(HashMapNext(map, &iter, &key) == 0);
+
+  // Out of arena memory: no map at all, or a map that fills every slot it has and then
+  // refuses new keys while keeping the old ones
+  {
+    u8 small[2048];
+    Arena *smallArena = ArenaAlloc(small, sizeof(small));
+    TestCheck(HashMapAllocT(smallArena, u64, 1000) == 0);
+    ArenaClear(smallArena);
+    HashMap *smallMap = HashMapAllocT(smallArena, u64, 16);
+    TestCheck(smallMap != 0);
+    u64 inserted = 0;
+    for (u64 *value = HashMapInsertT(smallMap, u64, 1); value; value = HashMapInsertT(smallMap, u64, inserted + 1)) {
+      *value = ++inserted;
+    }
+    TestCheck(inserted > 16 && inserted == (smallMap->groupMask + 1) * HASH_MAP_GROUP_SIZE);
+    TestCheck(smallMap->count == inserted);
+    isSame = 1;
+    for (u64 keyIdx = 1; keyIdx <= inserted; ++keyIdx) {
+      u64 *value = HashMapLookupT(smallMap, u64, keyIdx);
+      isSame = isSame && value && *value == keyIdx;
+    }
+    TestCheck(isSame);
+    TestCheck(HashMapLookup(smallMap, inserted + 1) == 0);
+  }
+}
@@ -0,0 +1,47 @@
+// Interning against a plain list of the strings seen so far
+
+function void
+TestIntern(Arena *arena)
+{
+  u64 capacity = 1000;
+  InternTable *table = InternTableAlloc(arena, capacity);
+  Atom *atoms = ArenaPushN(arena, Atom, capacity);
+
+  // Same string, same atom, and the table holds its own copy
+  u8 buffer[32];
+  for (u64 stringIdx = 0; stringIdx < capacity; ++stringIdx) {
+    u64 size = stbsp_snprintf((char*)buffer, sizeof(buffer), "asset/%llu.png", (unsigned long long)stringIdx);
+    atoms[stringIdx] = AtomFromStr8(table, Str8(buffer, size));
+    TestCheck(atoms[stringIdx] != 0);
+    MemorySet(buffer, 0, sizeof(buffer));
+  }
+  for (u64 stringIdx = 0; stringIdx < capacity; ++stringIdx) {
+    String8 string = PushStr8F(arena, "asset/%llu.png", (unsigned long long)stringIdx);
+    TestCheck(AtomFromStr8(table, string) == atoms[stringIdx]);
+    TestCheck(AtomLookup(table, string) == atoms[stringIdx]);
+    TestCheck(Str8Match(Str8FromAtom(table, atoms[stringIdx]), string, 0));
+    TestCheck(stringIdx == 0 || atoms[stringIdx] != atoms[stringIdx - 1]);
+  }
+  TestCheck(table->count == capacity + 1);
+
+  // Unknown strings, prefixes and the empty string aren't found, a full table refuses new ones
+  TestCheck(AtomLookup(table, Str8Lit("asset/1000.png")) == 0);
+  TestCheck(AtomLookup(table, Str8Lit("asset/1")) == 0);
+  TestCheck(AtomLookup(table, Str8Lit("")) == 0);
+  TestCheck(AtomFromStr8(table, Str8Lit("one too many")) == 0);
+  TestCheck(Str8FromAtom(table, 0).size == 0);
+
+  // Out of arena memory: no table, and a table with room left refuses strings it can't copy
+  {
+    u8 small[256];
+    Arena *smallArena = ArenaAlloc(small, sizeof(small));
+    TestCheck(InternTableAlloc(smallArena, 1000) == 0);
+    ArenaClear(smallArena);
+    InternTable *smallTable = InternTableAlloc(smallArena, 2);
+    TestCheck(smallTable != 0);
+    u8 big[256] = {0};
+    TestCheck(AtomFromStr8(smallTable, Str8(big, sizeof(big))) == 0);
+    TestCheck(smallTable->count == 1);
+    TestCheck(AtomFromStr8(smallTable, Str8Lit("fits")) != 0);
+  }
+}
@@ -0,0 +1,84 @@
+// The logger end to end, through a console sink that keeps what it's given
+
+#define TEST_LOG_OUTPUT_SIZE Megabytes(1)
+
+global u8 g_testLogOutput[TEST_LOG_OUTPUT_SIZE];
+global u64 g_testLogOutputSize;
+
+function void
+TestLogSink(String8 text)
+{
+  u64 size = Min(text.size, TEST_LOG_OUTPUT_SIZE - g_testLogOutputSize);
+  MemoryCopy(g_testLogOutput + g_testLogOutputSize, text.str, size);
+  g_testLogOutputSize += size;
+}
+
+function b32
+TestLogContains(String8 output, char *text)
+{
+  b32 result = Str8Find(output, Str8C(text), 0, 0) < output.size;
+  return result;
+}
+
+function void
+TestLog(Arena *arena)
+{
+  Logger *logger = ArenaPushN(arena, Logger, 1);
+  g_testLogOutputSize = 0;
+  LoggerStart(logger, Str8Lit(""), TestLogSink);
+  TestCheck(g_logWrite == LogWrite);
+
+  LogInfo("ints %d %lld %5.2f %s|%.*s|", -7, -8000000000ll, 3.14159, "str", 3, "abcdef");
+  LogInfo("100%% done");
+  // Unknown conversions, a cut off one and a lone % at the end come out as text, and the
+  // arguments after them aren't read
+  LogWarning("known %d unknown %k then %s %%", 1, "never read");
+  LogWarning("cut off %");
+  LogWarning("width only %5");
+
+  // Sites past the format table are dropped and counted, and keep their id so the full
+  // table isn't searched again
+  LogSite *sites = ArenaPushN(arena, LogSite, LOG_MAX_FORMATS);
+  for (u32 siteIdx = 0; siteIdx < LOG_MAX_FORMATS; ++siteIdx) {
+    sites[siteIdx].level = LogLevel_Debug;
+    sites[siteIdx].file = __FILE__;
+    sites[siteIdx].line = siteIdx;
+    LogWrite(&sites[siteIdx], "site %u", siteIdx);
+  }
+  TestCheck((u32)sites[0].formatId != 0 && (u32)sites[0].formatId != LOG_FORMAT_NONE);
+  TestCheck((u32)sites[LOG_MAX_FORMATS - 1].formatId == LOG_FORMAT_NONE);
+  LogWrite(&sites[LOG_MAX_FORMATS - 1], "site %u", LOG_MAX_FORMATS - 1);
+
+  LoggerStop(logger);
+  TestCheck(g_logWrite == 0 && g_currentLogger == 0);
+  LogInfo("after the stop");
+
+  String8 output = Str8(g_testLogOutput, g_testLogOutputSize);
+  TestCheck(TestLogContains(output, "info    ints -7 -8000000000  3.14 str|abc|\n"));
+  TestCheck(TestLogContains(output, "info    100% done\n"));
+  TestCheck(TestLogContains(output, "warning known 1 unknown %k then %s %%\n"));
+  TestCheck(TestLogContains(output, "warning cut off %\n"));
+  TestCheck(TestLogContains(output, "warning width only %5\n"));
+  TestCheck(TestLogContains(output, "debug   site 0\n"));
+  TestCheck(!TestLogContains(output, "after the stop"));
+
+  // Id 0 is never handed out and the 5 formats above came first, the last site wrote twice
+  u64 registered = (LOG_MAX_FORMATS - 1) - 5;
+  u64 dropped = (LOG_MAX_FORMATS - registered) + 1;
+  String8 droppedLine = PushStr8F(arena, "[log] dropped %llu messages\n", dropped);
+  TestCheck(Str8Find(output, droppedLine, 0, 0) < output.size);
+
+  // Started again on the same struct from the same thread: this thread's ring and the sites'
+  // ids are from the stopped logger, both are picked up afresh
+  g_testLogOutputSize = 0;
+  LoggerStart(logger, Str8Lit(""), TestLogSink);
+  LogWrite(&sites[LOG_MAX_FORMATS - 1], "site %u", LOG_MAX_FORMATS - 1);
+  LogInfo("restarted %d", 2);
+  TestCheck((u32)sites[LOG_MAX_FORMATS - 1].formatId == 1);
+  LoggerStop(logger);
+  output = Str8(g_testLogOutput, g_testLogOutputSize);
+  String8 siteLine = PushStr8F(arena, "debug   site %u\n", LOG_MAX_FORMATS - 1);
+  TestCheck(Str8Find(output, siteLine, 0, 0) < output.size);
+  TestCheck(TestLogContains(output, "info    restarted 2\n"));
+  TestCheck(!TestLogContains(output, "dropped"));
+}
@@ -0,0 +1,131 @@
+// Pool and TLSF under random pushes and releases. Every live allocation is filled with a byte
+// of its own, so overlapping slots show up as a changed byte before the release
+
+typedef struct TestAllocation TestAllocation;
+struct TestAllocation
+{
+  u8 *ptr;
+  u64 size;
+};
+
+function b32
+TestAllocationIsIntact(TestAllocation *allocation, u64 allocationIdx)
+{
+  b32 result = 1;
+  for (u64 byteIdx = 0; byteIdx < allocation->size && result; ++byteIdx) {
+    result = allocation->ptr[byteIdx] == (u8)(allocationIdx + 1);
+  }
+  return result;
+}
+
+function void
+TestPool(Arena *arena)
+{
+  u64 slotCount = 2000;
+  TestAllocation *allocations = ArenaPushN(arena, TestAllocation, slotCount);
+  u64 rng = 0x9001;
+  b32 isIntact = 1;
+  b32 isZeroed = 1;
+  b32 isAligned = 1;
+
+  for (u64 alignIdx = 0; alignIdx < 2; ++alignIdx) {
+    u64 align = alignIdx ? CACHE_LINE_SIZE : 8;
+    Pool *pool = PoolAlloc(arena, align);
+    MemoryZero(allocations, slotCount * sizeof(TestAllocation));
+    for (u64 opIdx = 0; opIdx < 40000; ++opIdx) {
+      u64 allocationIdx = TestRandom(&rng) % slotCount;
+      TestAllocation *allocation = &allocations[allocationIdx];
+      if (allocation->ptr) {
+        isIntact = isIntact && TestAllocationIsIntact(allocation, allocationIdx);
+        PoolRelease(pool, allocation->ptr, allocation->size);
+        allocation->ptr = 0;
+      } else {
+        allocation->size = 1 + TestRandom(&rng) % POOL_MAX_SIZE;
+        allocation->ptr = PoolPush(pool, allocation->size);
+        for (u64 byteIdx = 0; byteIdx < allocation->size && allocation->ptr; ++byteIdx) {
+          isZeroed = isZeroed && allocation->ptr[byteIdx] == 0;
+        }
+        isAligned = isAligned && allocation->ptr && ((u64)allocation->ptr & (Max(align, POOL_MIN_SIZE) - 1)) == 0;
+        MemorySet(allocation->ptr, (u8)(allocationIdx + 1), allocation->size);
+      }
+    }
+    TestCheck(isIntact && isZeroed && isAligned);
+
+    // The last slot released is the next one pushed from its class
+    u8 *first = PoolPush(pool, 100);
+    PoolRelease(pool, first, 100);
+    TestCheck(PoolPush(pool, 128) == first);
+    PoolRelease(pool, first, 128);
+    TestCheck(PoolPush(pool, POOL_MAX_SIZE + 1) == 0);
+
+    u64 liveCount = 0;
+    for (u64 allocationIdx = 0; allocationIdx < slotCount; ++allocationIdx) {
+      TestAllocation *allocation = &allocations[allocationIdx];
+      if (allocation->ptr) {
+        PoolRelease(pool, allocation->ptr, allocation->size);
+        liveCount++;
+      }
+    }
+    u64 classLive = 0;
+    for (u64 classIdx = 0; classIdx < POOL_CLASS_COUNT; ++classIdx) {
+      classLive += pool->stats.liveCount[classIdx];
+    }
+    TestCheck(pool->stats.liveBytes == 0 && classLive == 0);
+    TestCheck(pool->stats.pushCount == pool->stats.releaseCount);
+    TestCheck(pool->stats.peakLiveBytes <= pool->stats.reservedBytes);
+    TestCheck(liveCount > 0);
+  }
+}
+
+function void
+TestTLSF(Arena *arena)
+{
+  u64 slotCount = 1000;
+  TestAllocation *allocations = ArenaPushN(arena, TestAllocation, slotCount);
+  TLSF *tlsf = TLSFAlloc(arena, Megabytes(4));
+  TLSFStats empty = TLSFGetStats(tlsf);
+  TestCheck(empty.capacity > 0 && empty.largestFreeBlock == empty.capacity);
+
+  // Sizes up to 16K so the region runs full now and then and pushes fail
+  u64 rng = 0x7157;
+  b32 isIntact = 1;
+  b32 isAligned = 1;
+  u64 failedCount = 0;
+  for (u64 opIdx = 0; opIdx < 100000; ++opIdx) {
+    u64 allocationIdx = TestRandom(&rng) % slotCount;
+    TestAllocation *allocation = &allocations[allocationIdx];
+    if (allocation->ptr) {
+      isIntact = isIntact && TestAllocationIsIntact(allocation, allocationIdx);
+      TLSFRelease(tlsf, allocation->ptr);
+      allocation->ptr = 0;
+    } else {
+      allocation->size = 1 + TestRandom(&rng) % ((TestRandom(&rng) & 1) ? 256 : Kilobytes(16));
+      allocation->ptr = TLSFPush(tlsf, allocation->size);
+      if (allocation->ptr) {
+        isAligned = isAligned && ((u64)allocation->ptr & (TLSF_ALIGN - 1)) == 0;
+        MemorySet(allocation->ptr, (u8)(allocationIdx + 1), allocation->size);
+      } else {
+        failedCount++;
+      }
+    }
+  }
+  TestCheck(isIntact && isAligned);
+  TestCheck(TLSFGetStats(tlsf).failedCount == failedCount);
+
+  // Releasing everything coalesces back into the one block the region started as
+  for (u64 allocationIdx = 0; allocationIdx < slotCount; ++allocationIdx) {
+    TLSFRelease(tlsf, allocations[allocationIdx].ptr);
+  }
+  TLSFStats stats = TLSFGetStats(tlsf);
+  TestCheck(stats.usedBytes == 0);
+  TestCheck(stats.largestFreeBlock == stats.capacity);
+  TestCheck(stats.pushCount == stats.releaseCount);
+  TestCheck(stats.peakUsedBytes <= stats.capacity + Kilobytes(64));
+
+  // Which means the whole capacity fits in one push, and nothing more does
+  void *whole = TLSFPush(tlsf, stats.capacity);
+  TestCheck(whole != 0);
+  TestCheck(TLSFPush(tlsf, 16) == 0);
+  TLSFRelease(tlsf, whole);
+  TestCheck(TLSFPush(tlsf, stats.capacity + 1) == 0);
+}
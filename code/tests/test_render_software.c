@@ -0,0 +1,119 @@
+// The software renderer's 4 pixel span loops against its scalar per pixel blend, for every
+// blend mode on random pixels, then a TGA round trip and a frame drawn end to end
+
+function void
+TestRenderSoftwareSpans(Arena *arena)
+{
+  u64 maxCount = 19; // Every remainder of 4 and a few full blocks
+  u32 *row = ArenaPushN(arena, u32, maxCount);
+  u32 *expected = ArenaPushN(arena, u32, maxCount);
+  u32 *texels = ArenaPushN(arena, u32, maxCount);
+  u32 *fillRow = ArenaPushN(arena, u32, maxCount);
+  u64 rng = 0xb1e4d;
+  b32 isFillSame = 1;
+  b32 isBlendSame = 1;
+  for (u64 roundIdx = 0; roundIdx < 20000; ++roundIdx) {
+    RenderBlend blend = (RenderBlend)(roundIdx % RenderBlend_Count);
+    s32 count = (s32)(TestRandom(&rng) % (maxCount + 1));
+    // Fully opaque and fully clear colors and texels now and then, they take their own paths
+    u64 alphaShape = TestRandom(&rng) % 4;
+    RenderColor color = (RenderColor)TestRandom(&rng);
+    color = alphaShape == 0 ? (color | 0xFF000000) : alphaShape == 1 ? (color & 0x00FFFFFF) : color;
+    color = (TestRandom(&rng) % 4 == 0) ? 0xFFFFFFFF : color;
+    for (s32 pixelIdx = 0; pixelIdx < count; ++pixelIdx) {
+      row[pixelIdx] = (u32)TestRandom(&rng);
+      texels[pixelIdx] = (u32)TestRandom(&rng);
+      texels[pixelIdx] |= (alphaShape == 2) ? 0xFF000000 : 0;
+    }
+
+    MemoryCopy(expected, row, count * sizeof(u32));
+    for (s32 pixelIdx = 0; pixelIdx < count; ++pixelIdx) {
+      expected[pixelIdx] = RenderSoftwareBlend(expected[pixelIdx], color, blend);
+    }
+    MemoryCopy(fillRow, row, count * sizeof(u32));
+    RenderSoftwareFillSpan(fillRow, count, color, blend);
+    isFillSame = isFillSame && MemoryMatch(fillRow, expected, count * sizeof(u32));
+
+    for (s32 pixelIdx = 0; pixelIdx < count; ++pixelIdx) {
+      expected[pixelIdx] = RenderSoftwareBlend(row[pixelIdx], RenderSoftwareModulate(texels[pixelIdx], color), blend);
+    }
+    RenderSoftwareBlendSpan(row, texels, count, color, blend);
+    isBlendSame = isBlendSame && MemoryMatch(row, expected, count * sizeof(u32));
+  }
+  TestCheck(isFillSame);
+  TestCheck(isBlendSame);
+
+  // The rounding the spans share with the scalar path
+  b32 isDiv255Exact = 1;
+  for (u32 x = 0; x <= 255 * 255; ++x) {
+    isDiv255Exact = isDiv255Exact && RenderSoftwareDiv255(x) == (x + 127) / 255;
+  }
+  TestCheck(isDiv255Exact);
+}
+
+function void
+TestRenderSoftwareImages(Arena *arena)
+{
+  u64 width = 37;
+  u64 height = 11;
+  u32 *pixels = ArenaPushN(arena, u32, width * height);
+  u64 rng = 0x76a;
+  for (u64 pixelIdx = 0; pixelIdx < width * height; ++pixelIdx) {
+    pixels[pixelIdx] = (u32)TestRandom(&rng);
+  }
+
+  String8 path = Str8Lit("tests_image.tga");
+  TestCheck(RenderSoftwareSaveImage(path, pixels, width, height));
+  u64 loadedWidth = 0, loadedHeight = 0;
+  u32 *loaded = RenderSoftwareLoadImage(arena, path, &loadedWidth, &loadedHeight);
+  TestCheck(loaded && loadedWidth == width && loadedHeight == height);
+  TestCheck(loaded && MemoryMatch(loaded, pixels, width * height * sizeof(u32)));
+  TestCheck(RenderSoftwareLoadImage(arena, Str8Lit("tests_missing.tga"), &loadedWidth, &loadedHeight) == 0);
+}
+
+#define TEST_FRAME_CLEAR 0xFF102030
+#define TEST_FRAME_HALF  0x800000FF
+
+// Frame sized view across a tile border: an alpha blended rect and an opaque one in the corner
+function void
+TestRenderSoftwareDraw(RenderCommands *commands, u64 width, u64 height)
+{
+  RenderCommandsBegin(commands, width, height);
+  RenderClear(commands, TEST_FRAME_CLEAR);
+  RenderRect(commands, 60.f, 30.f, 10.f, 40.f, TEST_FRAME_HALF);
+  RenderSetBlend(commands, RenderBlend_None);
+  RenderRect(commands, 0.f, 0.f, 2.f, 1.f, 0xFF00FF00);
+}
+
+function void
+TestRenderSoftwareFrame(Arena *arena)
+{
+  persist RenderSoftware renderer;
+  TestCheck(RenderSoftwareInit(&renderer, arena, 64));
+  RenderCommands *commands = RenderCommandsAlloc(arena, 64);
+
+  u64 width = 150, height = 100;
+  RenderColor clear = TEST_FRAME_CLEAR;
+  TestRenderSoftwareDraw(commands, width, height);
+  RenderSoftwareExecute(&renderer, commands);
+
+  // Bottom row first
+  TestCheck(renderer.width == width && renderer.height == height);
+  u32 *pixels = renderer.pixels;
+  TestCheck(pixels[50 * width + 5] == clear);
+  TestCheck(pixels[50 * width + 65] == RenderSoftwareBlend(clear, TEST_FRAME_HALF, RenderBlend_Alpha));
+  TestCheck(pixels[30 * width + 60] != clear && pixels[69 * width + 69] != clear);
+  TestCheck(pixels[29 * width + 60] == clear && pixels[70 * width + 69] == clear && pixels[50 * width + 70] == clear);
+  TestCheck(pixels[0] == 0xFF00FF00 && pixels[1] == 0xFF00FF00 && pixels[2] == clear && pixels[width] == clear);
+
+  // A smaller frame resizes, the same commands again give the same pixels
+  u64 hash = HashBytes(pixels, width * height * sizeof(u32), HASH_DEFAULT_SEED);
+  RenderCommandsBegin(commands, 8, 8);
+  RenderSoftwareExecute(&renderer, commands);
+  TestCheck(renderer.width == 8 && renderer.height == 8);
+  TestRenderSoftwareDraw(commands, width, height);
+  RenderSoftwareExecute(&renderer, commands);
+  TestCheck(HashBytes(renderer.pixels, width * height * sizeof(u32), HASH_DEFAULT_SEED) == hash);
+
+  RenderSoftwareShutdown(&renderer);
+}
@@ -0,0 +1,54 @@
+// RenderSortKeys against qsort, single threaded and over a job pool. Keys are unique through
+// their index, so qsort's order is the only right one and stability comes for free with it
+
+function int
+TestCompareKeys(const void *a, const void *b)
+{
+  u64 keyA = *(u64*)a;
+  u64 keyB = *(u64*)b;
+  int result = (keyA > keyB) - (keyA < keyB);
+  return result;
+}
+
+function void
+TestRenderSort(Arena *arena)
+{
+  u64 capacity = 300000;
+  u64 *keys = ArenaPushN(arena, u64, capacity);
+  u64 *expected = ArenaPushN(arena, u64, capacity);
+  persist OSJobPool pool;
+  OSJobPoolStart(&pool, 3);
+  RenderSorter serial = {0};
+  RenderSorter parallel = {0};
+  RenderSorterInit(&serial, arena, capacity, 0);
+  RenderSorterInit(&parallel, arena, capacity, &pool);
+
+  u64 counts[] = {0, 1, 2, 1000, RENDER_SORT_PARALLEL_MIN - 1, RENDER_SORT_PARALLEL_MIN, 100003, capacity};
+  u64 rng = 0x50f7;
+  for (u64 countIdx = 0; countIdx < ArrayCount(counts); ++countIdx) {
+    for (u64 shapeIdx = 0; shapeIdx < 3; ++shapeIdx) {
+      // Few distinct states in one layer, random everything, and a constant key (sorted)
+      u64 count = counts[countIdx];
+      for (u64 keyIdx = 0; keyIdx < count; ++keyIdx) {
+        u64 bits = TestRandom(&rng);
+        u64 high = (shapeIdx == 0) ? ((bits % 5) << RENDER_KEY_TEXTURE_SHIFT) | (3ull << RENDER_KEY_LAYER_SHIFT) :
+                   (shapeIdx == 1) ? bits & ~RENDER_KEY_INDEX_MASK : 7ull << RENDER_KEY_DEPTH_SHIFT;
+        keys[keyIdx] = high | keyIdx;
+      }
+      MemoryCopy(expected, keys, count * sizeof(u64));
+      qsort(expected, count, sizeof(u64), TestCompareKeys);
+
+      for (u64 sorterIdx = 0; sorterIdx < 2; ++sorterIdx) {
+        RenderSorter *sorter = sorterIdx ? &parallel : &serial;
+        u64 *input = ArenaPushN(arena, u64, count + 1);
+        MemoryCopy(input, keys, count * sizeof(u64));
+        u64 *sorted = RenderSortKeys(sorter, input, count);
+        TestCheck(count == 0 || MemoryMatch(sorted, expected, count * sizeof(u64)));
+        TestCheck(shapeIdx != 2 || (sorted == input && sorter->passCount == 0));
+        TestCheck(shapeIdx != 0 || count < 2 || sorter->passCount <= 1);
+      }
+    }
+  }
+
+  OSJobPoolStop(&pool);
+}
@@ -0,0 +1,164 @@
+// Streams WAV files written on the spot through a mixer the test renders by hand
+
+#define TEST_STREAM_TIMEOUT_NS (2 * OS_NS_PER_SEC)
+
+function void
+TestWriteU16(u8 *ptr, u16 value)
+{
+  ptr[0] = (u8)value;
+  ptr[1] = (u8)(value >> 8);
+}
+
+function void
+TestWriteU32(u8 *ptr, u32 value)
+{
+  TestWriteU16(ptr, (u16)value);
+  TestWriteU16(ptr + 2, (u16)(value >> 16));
+}
+
+// dataSize is what the header claims, dataBytes what's actually there
+function b32
+TestWriteWav(Arena *arena, String8 path, u16 format, u16 channelCount, u16 blockAlign, u16 bitsPerSample,
+             u32 dataSize, u32 dataBytes)
+{
+  u64 size = 44 + dataBytes;
+  u8 *file = ArenaPushN(arena, u8, size);
+  MemoryCopy(file, "RIFF", 4);
+  TestWriteU32(file + 4, (u32)(size - 8));
+  MemoryCopy(file + 8, "WAVEfmt ", 8);
+  TestWriteU32(file + 16, 16);
+  TestWriteU16(file + 20, format);
+  TestWriteU16(file + 22, channelCount);
+  TestWriteU32(file + 24, GAME_AUDIO_SAMPLE_RATE);
+  TestWriteU32(file + 28, GAME_AUDIO_SAMPLE_RATE * blockAlign);
+  TestWriteU16(file + 32, blockAlign);
+  TestWriteU16(file + 34, bitsPerSample);
+  MemoryCopy(file + 36, "data", 4);
+  TestWriteU32(file + 40, dataSize);
+  for (u64 byteIdx = 0; byteIdx < dataBytes; ++byteIdx) {
+    file[44 + byteIdx] = (u8)(byteIdx * 7);
+  }
+
+  b32 result = false;
+  OSFile handle = OSFileOpenWrite(path);
+  if (handle.handle) {
+    result = OSFileWrite(handle, 0, file, size) == size;
+    OSFileClose(handle);
+  }
+  return result;
+}
+
+function b32
+TestWaitStreamState(AudioStream *stream, AudioStreamState state)
+{
+  u64 deadlineNs = OSNowNs() + TEST_STREAM_TIMEOUT_NS;
+  while (AtomicLoadU64(&stream->state) != state && OSNowNs() < deadlineNs) {
+    OSSleepUntilNs(OSNowNs() + OS_NS_PER_MS);
+  }
+  return AtomicLoadU64(&stream->state) == state;
+}
+
+// Renders until the stream's slot is free again, that is once the voice ended and released it
+function b32
+TestRenderUntilFree(Mixer *mixer, AudioStream *stream, f32 *output, u64 *renderedFrames)
+{
+  u64 deadlineNs = OSNowNs() + TEST_STREAM_TIMEOUT_NS;
+  while (AtomicLoadU64(&stream->state) != AudioStreamState_Free && OSNowNs() < deadlineNs) {
+    MixerRender(mixer, output, 512);
+    *renderedFrames += 512;
+    OSSleepUntilNs(OSNowNs() + OS_NS_PER_MS);
+  }
+  return AtomicLoadU64(&stream->state) == AudioStreamState_Free;
+}
+
+function void
+TestStream(Arena *arena)
+{
+  persist Mixer mixer;
+  persist AudioStreamer streamer;
+  MixerInit(&mixer, arena);
+  mixer.isActive = true;
+  AudioStreamerStart(&streamer, arena);
+  f32 *output = ArenaPushN(arena, f32, 2 * 512);
+
+  // PCM whose data ends in half a frame and claims more than the file has: plays what's
+  // there, ends and frees its slot
+  {
+    String8 path = Str8Lit("tests_stream_pcm.wav");
+    TestCheck(TestWriteWav(arena, path, 1, 2, 4, 16, 100000, 4 * 1000 + 3));
+    AudioStream *stream = AudioStreamOpen(&streamer, path, false);
+    TestCheck(stream != 0);
+    TestCheck(MixerPlayStream(&mixer, stream, 1.f) != 0);
+    TestCheck(TestWaitStreamState(stream, AudioStreamState_Playing));
+    TestCheck(stream->dataSize == 4 * 1000);
+    u64 renderedFrames = 0;
+    TestCheck(TestRenderUntilFree(&mixer, stream, output, &renderedFrames));
+    TestCheck(renderedFrames >= 1000);
+  }
+
+  // IMA ADPCM whose last block is too short for its header
+  {
+    String8 path = Str8Lit("tests_stream_ima.wav");
+    TestCheck(TestWriteWav(arena, path, 0x11, 1, 36, 4, 36 * 3 + 2, 36 * 3 + 2));
+    AudioStream *stream = AudioStreamOpen(&streamer, path, false);
+    TestCheck(MixerPlayStream(&mixer, stream, 1.f) != 0);
+    u64 renderedFrames = 0;
+    TestCheck(TestRenderUntilFree(&mixer, stream, output, &renderedFrames));
+  }
+
+  // A stereo block cut off part way through the second channel's bytes only yields the
+  // frames both channels have, and those match the full block's
+  {
+    u8 block[8 + 16];
+    for (u64 byteIdx = 0; byteIdx < sizeof(block); ++byteIdx) {
+      block[byteIdx] = (u8)(byteIdx * 37 + 11);
+    }
+    s16 full[2 * 17], cut[2 * 17];
+    TestCheck(AudioDecodeIMABlock(block, sizeof(block), 2, full) == 17);
+    MemorySet(cut, 0x55, sizeof(cut));
+    u64 frameCount = AudioDecodeIMABlock(block, 8 + 8 + 5, 2, cut);
+    TestCheck(frameCount == 1 + 8 + 2);
+    TestCheck(MemoryMatch(cut, full, frameCount * 2 * sizeof(s16)));
+    TestCheck(cut[frameCount * 2] == 0x5555 && cut[2 * 17 - 1] == 0x5555);
+    TestCheck(AudioDecodeIMABlock(block, 8 + 3, 2, cut) == 1);
+    TestCheck(AudioDecodeIMABlock(block, 7, 2, cut) == 0);
+  }
+
+  // The same through a stream, the last stereo block cut off part way
+  {
+    String8 path = Str8Lit("tests_stream_ima_stereo.wav");
+    TestCheck(TestWriteWav(arena, path, 0x11, 2, 72, 4, 72 * 2 + 13, 72 * 2 + 13));
+    AudioStream *stream = AudioStreamOpen(&streamer, path, false);
+    TestCheck(MixerPlayStream(&mixer, stream, 1.f) != 0);
+    u64 renderedFrames = 0;
+    TestCheck(TestRenderUntilFree(&mixer, stream, output, &renderedFrames));
+  }
+
+  // A stream that fails to open stays claimed until its voice releases it, so a stream
+  // opened in between can't get the slot and be released along with it
+  {
+    AudioStream *failed = AudioStreamOpen(&streamer, Str8Lit("tests_stream_missing.wav"), false);
+    TestCheck(failed != 0);
+    TestCheck(TestWaitStreamState(failed, AudioStreamState_Failed));
+    String8 path = Str8Lit("tests_stream_pcm.wav");
+    AudioStream *other = AudioStreamOpen(&streamer, path, true);
+    TestCheck(other != 0 && other != failed);
+    TestCheck(TestWaitStreamState(other, AudioStreamState_Playing));
+
+    TestCheck(MixerPlayStream(&mixer, failed, 1.f) != 0);
+    u64 renderedFrames = 0;
+    TestCheck(TestRenderUntilFree(&mixer, failed, output, &renderedFrames));
+    TestCheck(AtomicLoadU64(&other->state) == AudioStreamState_Playing);
+    AudioStreamRelease(other);
+    TestCheck(TestWaitStreamState(other, AudioStreamState_Free));
+  }
+
+  // Released by its owner before the I/O thread got to open it
+  {
+    AudioStream *stream = AudioStreamOpen(&streamer, Str8Lit("tests_stream_pcm.wav"), false);
+    AudioStreamRelease(stream);
+    TestCheck(TestWaitStreamState(stream, AudioStreamState_Free));
+  }
+
+  AudioStreamerStop(&streamer);
+}
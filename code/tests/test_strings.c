@@ -0,0 +1,153 @@
+// The vectorized string ops against byte at a time references, on random strings over a
+// small alphabet so matches are common. Lengths cross the 16 and 64 byte blocks
+
+#define TEST_STRINGS_ALPHABET "aAbB,; "
+
+function String8
+TestRandomStr8(Arena *arena, u64 *rng, u64 maxSize)
+{
+  u64 size = TestRandom(rng) % (maxSize + 1);
+  // Odd offsets so the loads aren't aligned
+  u8 *str = (u8*)ArenaPushN(arena, u8, size + 16) + TestRandom(rng) % 16;
+  for (u64 charIdx = 0; charIdx < size; ++charIdx) {
+    str[charIdx] = TEST_STRINGS_ALPHABET[TestRandom(rng) % (sizeof(TEST_STRINGS_ALPHABET) - 1)];
+  }
+  String8 result = Str8(str, size);
+  return result;
+}
+
+function b32
+TestStr8MatchAt(String8 string, u64 pos, String8 needle, b32 noCase)
+{
+  b32 result = pos + needle.size <= string.size;
+  for (u64 charIdx = 0; result && charIdx < needle.size; ++charIdx) {
+    u8 a = string.str[pos + charIdx];
+    u8 b = needle.str[charIdx];
+    result = noCase ? CharToLower(a) == CharToLower(b) : a == b;
+  }
+  return result;
+}
+
+function void
+TestStrings(Arena *arena)
+{
+  u64 rng = 0x5eed5eed;
+  u64 rounds = 4000;
+
+  for (u64 roundIdx = 0; roundIdx < rounds; ++roundIdx) {
+    TempArena temp = ArenaTempBegin(arena);
+    StringMatchFlags flags = (roundIdx & 1) ? StringMatch_CaseInsensitive : 0;
+    b32 noCase = (roundIdx & 1);
+
+    // Match, mostly against a copy with some bytes changed
+    String8 a = TestRandomStr8(arena, &rng, 200);
+    String8 b = PushStr8Copy(arena, a);
+    if (b.size && (TestRandom(&rng) & 1)) {
+      u64 pos = TestRandom(&rng) % b.size;
+      b.str[pos] = TEST_STRINGS_ALPHABET[TestRandom(&rng) % (sizeof(TEST_STRINGS_ALPHABET) - 1)];
+    }
+    TestCheck(Str8Match(a, b, flags) == (a.size == b.size && TestStr8MatchAt(a, 0, b, noCase)));
+    TestCheck(Str8Match(a, Str8Chop(a, 1), flags) == (a.size == 0));
+
+    // Find and FindLast, first and last position the reference matches at
+    String8 string = TestRandomStr8(arena, &rng, 200);
+    String8 needle = TestRandomStr8(arena, &rng, 4);
+    u64 startPos = TestRandom(&rng) % (string.size + 2);
+    u64 first = string.size;
+    u64 last = string.size;
+    for (u64 pos = 0; pos < string.size; ++pos) {
+      if (needle.size && TestStr8MatchAt(string, pos, needle, noCase)) {
+        if (pos >= startPos && first == string.size) {
+          first = pos;
+        }
+        last = pos;
+      }
+    }
+    if (needle.size) {
+      TestCheck(Str8Find(string, needle, startPos, flags) == first);
+      TestCheck(Str8FindLast(string, needle, flags) == last);
+    } else {
+      TestCheck(Str8Find(string, needle, startPos, flags) == Min(startPos, string.size));
+    }
+
+    // Split on 1, 3 and all of the alphabet's delimiters, the pieces are the runs between
+    // them and empty ones are skipped
+    u8 splits[] = {',', ';', ' ', 'b', 'B', 'a', 'A', 'x', 'y', 'z'};
+    u64 numSplits = (roundIdx % 3 == 0) ? 1 : (roundIdx % 3 == 1) ? 3 : ArrayCount(splits);
+    String8List pieces = Str8Split(arena, string, numSplits, splits);
+    String8Node *node = pieces.first;
+    u64 count = 0;
+    b32 isSame = 1;
+    for (u64 pos = 0; pos < string.size;) {
+      u64 opl = pos;
+      for (b32 isSplit = 0; opl < string.size && !isSplit; ) {
+        isSplit = 0;
+        for (u64 splitIdx = 0; splitIdx < numSplits; ++splitIdx) {
+          isSplit |= string.str[opl] == splits[splitIdx];
+        }
+        opl += !isSplit;
+      }
+      if (opl > pos) {
+        String8 expected = Substr8Opl(string, pos, opl);
+        isSame = isSame && node && node->string.str == expected.str && node->string.size == expected.size;
+        node = node ? node->next : 0;
+        count++;
+      }
+      pos = opl + 1;
+    }
+    TestCheck(isSame && node == 0);
+    TestCheck(pieces.count == count);
+
+    ArenaTempEnd(temp);
+  }
+
+  // Builder, pieces back to back stay one string, anything pushed in between splits them up
+  // and End copies them together
+  for (u64 roundIdx = 0; roundIdx < 2; ++roundIdx) {
+    TempArena temp = ArenaTempBegin(arena);
+    Str8Builder builder = Str8BuilderBegin(arena);
+    Str8BuilderAppend(&builder, Str8Lit("tile "));
+    Str8BuilderAppendF(&builder, "%d,%d", 12, -3);
+    if (roundIdx) {
+      ArenaPushN(arena, u8, 100);
+    }
+    Str8BuilderAppend(&builder, Str8Lit(" "));
+    for (u64 idx = 0; idx < 100; ++idx) {
+      Str8BuilderAppendF(&builder, "%c", 'a' + (char)(idx % 26));
+    }
+    String8 built = Str8BuilderEnd(&builder);
+    TestCheck(built.size == 5 + 5 + 1 + 100);
+    TestCheck(Str8Match(Prefix8(built, 11), Str8Lit("tile 12,-3 "), 0));
+    TestCheck(built.str[11] == 'a' && built.str[36] == 'z' && built.str[37] == 'a');
+    TestCheck(built.str[built.size] == 0);
+    ArenaTempEnd(temp);
+  }
+
+  // Out of arena memory the builder keeps what fit: nothing at all when not even its first
+  // piece fits, and a split up string whose copy doesn't fit comes out empty
+  {
+    u8 small[512];
+    Arena *smallArena = ArenaAlloc(small, sizeof(small));
+    ArenaPushNoZero(smallArena, smallArena->cap - smallArena->pos, 1);
+    Str8Builder builder = Str8BuilderBegin(smallArena);
+    Str8BuilderAppend(&builder, Str8Lit("no room"));
+    Str8BuilderAppendF(&builder, "%d", 1);
+    TestCheck(Str8BuilderEnd(&builder).size == 0);
+
+    ArenaClear(smallArena);
+    builder = Str8BuilderBegin(smallArena);
+    for (u64 idx = 0; idx < 100; ++idx) {
+      Str8BuilderAppend(&builder, Str8Lit("0123456789"));
+    }
+    String8 built = Str8BuilderEnd(&builder);
+    TestCheck(built.size == builder.pieces.totalSize && built.size < 1000 && built.size % 10 == 0);
+
+    ArenaClear(smallArena);
+    builder = Str8BuilderBegin(smallArena);
+    Str8BuilderAppend(&builder, Str8Lit("split"));
+    ArenaPushNoZero(smallArena, 1, 1);
+    Str8BuilderAppendF(&builder, "%s", "up");
+    ArenaPushNoZero(smallArena, smallArena->cap - smallArena->pos, 1);
+    TestCheck(Str8BuilderEnd(&builder).size == 0);
+  }
+}
@@ -0,0 +1,84 @@
+/*
+  Tests for the engine's modules, one executable built like the platform (unity build).
+  Run from the build directory, exits non-zero when a check failed.
+*/
+
+// Headers
+#define _GNU_SOURCE // Before any system header, see platform_sdl.c
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "base/base_include.h"
+#include "os/os.h"
+#include "render/render.h"
+#include "render/render_sort.h"
+#include "render/render_software.h"
+#include "game.h"
+#include "audio/audio_include.h"
+#include "log/logger.h"
+#include "tests/test.h"
+
+// Source
+#define STB_SPRINTF_IMPLEMENTATION
+#include <stb/stb_sprintf.h>
+#include "base/base_include.c"
+#include "os/os_include.c"
+#include "render/render.c"
+#include "render/render_sort.c"
+#include "render/render_software.c"
+#include "audio/audio_include.c"
+#include "log/logger.c"
+
+#include "tests/test_stream.c"
+#include "tests/test_intern.c"
+#include "tests/test_strings.c"
+#include "tests/test_containers.c"
+#include "tests/test_pool.c"
+#include "tests/test_log.c"
+#include "tests/test_render_sort.c"
+#include "tests/test_render_software.c"
+
+#define TEST_ARENA_SIZE Megabytes(256)
+
+#define TESTS \
+  X(TestStream) \
+  X(TestIntern) \
+  X(TestStrings) \
+  X(TestChunkArray) \
+  X(TestHashMap) \
+  X(TestPool) \
+  X(TestTLSF) \
+  X(TestLog) \
+  X(TestRenderSort) \
+  X(TestRenderSoftwareSpans) \
+  X(TestRenderSoftwareImages) \
+  X(TestRenderSoftwareFrame)
+
+function void
+TestReportFailure(char *file, int line, char *expr)
+{
+  g_testFailures++;
+  printf("  %s(%d): check failed: %s\n", file, line, expr);
+}
+
+int
+main(void)
+{
+  OSInit();
+  void *memory = OSMemReserve(TEST_ARENA_SIZE);
+  OSMemCommit(memory, TEST_ARENA_SIZE);
+  Arena *arena = ArenaAlloc(memory, TEST_ARENA_SIZE);
+
+  #define X(name) { \
+      u64 failuresBefore = g_testFailures; \
+      ArenaClear(arena); \
+      name(arena); \
+      printf("%-32s %s\n", #name, g_testFailures == failuresBefore ? "ok" : "FAILED"); \
+    }
+  TESTS
+  #undef X
+
+  printf("%llu checks, %llu failed\n", (unsigned long long)g_testChecks, (unsigned long long)g_testFailures);
+  int result = g_testFailures ? 1 : 0;
+  return result;
+}